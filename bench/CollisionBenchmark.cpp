@@ -0,0 +1,140 @@
+#include "Geometry.hpp"
+#include "GeometrySimd.hpp"
+#include "Shape.hpp"
+#include "HullBuffer.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/trigonometric.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+* Compares kernels of polygon intersection and the separating axis test on the shapes used in the game.
+* Hit counts of the two approaches differ: edge kernels miss polygons inside other polygons
+* and report some near misses as hits, because orientation values are truncated to integers.
+* Pairs of hulls are placed randomly close to each other, so that most of them reach the edge tests.
+*/
+namespace
+{
+    const std::size_t PAIR_COUNT = 4096;
+    const std::size_t REPEAT_COUNT = 200;
+    const float AREA_SIZE = 60.0f;
+
+
+    glm::vec2 randomPosition()
+    {
+        return glm::vec2(
+            AREA_SIZE * static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX),
+            AREA_SIZE * static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX)
+        );
+    }
+
+    float randomRotation()
+    {
+        return 360.0f * static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+    }
+
+    // Pair i consists of hulls and outlines 2 * i and 2 * i + 1.
+    struct Pairs
+    {
+        HullBuffer hulls;
+        std::vector<std::vector<glm::vec2>> outlines;   // Outlines for the edge kernels, hulls do not store them
+    };
+
+    // Transform vertices of the shape the same way as HullBuffer::add.
+    std::vector<glm::vec2> transformOutline(const Shape& shape, glm::vec2 center, float rotation)
+    {
+        float cos = glm::cos(glm::radians(rotation));
+        float sin = glm::sin(glm::radians(rotation));
+        std::vector<glm::vec2> outline;
+        for (const auto& vertex : shape.getVertices())
+        {
+            outline.push_back(center + glm::vec2(cos * vertex.x - sin * vertex.y, sin * vertex.x + cos * vertex.y));
+        }
+        return outline;
+    }
+
+    void addHull(Pairs& pairs, const Shape& shape)
+    {
+        glm::vec2 center = randomPosition();
+        float rotation = randomRotation();
+        pairs.hulls.add(shape, center, rotation);
+        pairs.outlines.push_back(transformOutline(shape, center, rotation));
+    }
+
+    Pairs createPairs(const Shape& shape1, const Shape& shape2)
+    {
+        Pairs pairs;
+        for (std::size_t i = 0; i < PAIR_COUNT; i++)
+        {
+            addHull(pairs, shape1);
+            addHull(pairs, shape2);
+        }
+        return pairs;
+    }
+
+    void print(const char* name, const char* path, double nanoseconds, std::size_t hits)
+    {
+        std::cout << name << " [" << path << "]: "
+            << nanoseconds / static_cast<double>(PAIR_COUNT * REPEAT_COUNT) << " ns per pair, "
+            << hits / REPEAT_COUNT << " hits" << std::endl;
+    }
+
+    void run(const char* name, const Pairs& pairs)
+    {
+        using Clock = std::chrono::steady_clock;
+        const geom::simd::Path paths[] = { geom::simd::Path::Scalar, geom::simd::Path::Sse, geom::simd::Path::Avx };
+        geom::simd::Path bestPath = geom::simd::getBestPath();
+        for (auto path : paths)
+        {
+            if (path > bestPath)
+            {
+                continue;
+            }
+            geom::simd::SegmentKernel kernel = geom::simd::getKernel(path);
+            std::size_t hits = 0;
+            auto start = Clock::now();
+            for (std::size_t repeat = 0; repeat < REPEAT_COUNT; repeat++)
+            {
+                for (std::size_t i = 0; i < PAIR_COUNT; i++)
+                {
+                    const std::vector<glm::vec2>& outline1 = pairs.outlines[2 * i];
+                    const std::vector<glm::vec2>& outline2 = pairs.outlines[2 * i + 1];
+                    hits += geom::simd::polygonsIntersect(outline1.data(), outline1.size(), outline2.data(), outline2.size(), kernel);
+                }
+            }
+            std::chrono::duration<double, std::nano> duration = Clock::now() - start;
+            print(name, geom::simd::getPathName(path), duration.count(), hits);
+        }
+        std::size_t hits = 0;
+        auto start = Clock::now();
+        for (std::size_t repeat = 0; repeat < REPEAT_COUNT; repeat++)
+        {
+            for (std::size_t i = 0; i < PAIR_COUNT; i++)
+            {
+                hits += pairs.hulls.intersect(2 * i, 2 * i + 1) ? 1 : 0;
+            }
+        }
+        std::chrono::duration<double, std::nano> duration = Clock::now() - start;
+        print(name, "separating axes", duration.count(), hits);
+    }
+}
+
+int main()
+{
+    std::srand(1);
+    Shape asteroid({
+        glm::vec2(0.5f, 0.0f), glm::vec2(1.0f, 0.5f), glm::vec2(0.75f, 1.0f),
+        glm::vec2(0.25f, 1.0f), glm::vec2(0.0f, 0.75f), glm::vec2(0.15f, 0.25f)
+    }, glm::vec2(40.0f));
+    Shape ship({
+        glm::vec2(0.0f, 1.0f), glm::vec2(0.5f, 0.75f),
+        glm::vec2(1.0f, 1.0f), glm::vec2(0.5f, 0.0f)
+    }, glm::vec2(28.0f, 35.0f));
+    run("asteroid x asteroid", createPairs(asteroid, asteroid));
+    run("ship x asteroid", createPairs(ship, asteroid));
+    return 0;
+}
\ No newline at end of file
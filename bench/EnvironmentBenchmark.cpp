@@ -0,0 +1,86 @@
+#include "EnvironmentApi.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+* Measures how many updates per second the batched environment makes through its C interface.
+* Usage: EnvironmentBenchmark [instances] [steps] [threads] [frame side] [channels]. Actions are random and change
+* every few steps, rewards and done flags are summed to show that the games progress. If the frame side is not zero,
+* square frames of all instances are drawn after every step and the time of drawing is measured separately.
+*/
+namespace
+{
+    const std::size_t ACTION_HOLD_STEPS = 8;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 4096;
+    std::size_t steps = argc > 2 ? std::stoul(argv[2]) : 1000;
+    std::size_t threads = argc > 3 ? std::stoul(argv[3]) : 0;
+    std::size_t frameSide = argc > 4 ? std::stoul(argv[4]) : 84;
+    std::size_t channels = argc > 5 ? std::stoul(argv[5]) : 1;
+    sg_env* env = sg_env_create(count, 1, threads);
+    if (env == nullptr)
+    {
+        std::cerr << "Failed to create the environment: " << sg_env_get_error() << std::endl;
+        return -1;
+    }
+    std::size_t observationSize = sg_env_get_observation_size();
+    std::vector<unsigned char> actions(count);
+    std::vector<float> rewards(count);
+    std::vector<unsigned char> dones(count);
+    std::vector<float> observations(count * observationSize);
+    std::size_t frameSize = frameSide > 0 ? sg_env_get_frame_size(frameSide, frameSide, channels) : 0;
+    std::vector<unsigned char> frames(count * frameSize);
+    double renderTime = 0.0;
+    sg_env_reset(env, observations.data());
+    std::srand(1);
+    double totalReward = 0.0;
+    std::size_t episodes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t step = 0; step < steps; step++)
+    {
+        if (step % ACTION_HOLD_STEPS == 0)
+        {
+            for (auto&& action : actions)
+            {
+                action = static_cast<unsigned char>(std::rand() % 16);
+            }
+        }
+        if (sg_env_step(env, actions.data(), rewards.data(), dones.data(), observations.data()) != 0)
+        {
+            std::cerr << "Step failed: " << sg_env_get_error() << std::endl;
+            sg_env_destroy(env);
+            return -2;
+        }
+        if (frameSize > 0)
+        {
+            auto renderStart = std::chrono::steady_clock::now();
+            sg_env_render(env, frameSide, frameSide, channels, frames.data());
+            renderTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - renderStart).count();
+        }
+        for (std::size_t i = 0; i < count; i++)
+        {
+            totalReward += rewards[i];
+            episodes += dones[i];
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double stepTime = elapsed.count() - renderTime;
+    std::cout << "Instances: " << count << ", steps: " << sg_env_get_total_steps(env) << ", stepping time: " << stepTime << " s"
+        << ", steps per second: " << static_cast<double>(sg_env_get_total_steps(env)) / stepTime << std::endl;
+    if (frameSize > 0)
+    {
+        std::cout << "Frames: " << frameSide << "x" << frameSide << "x" << channels << ", drawing time: " << renderTime << " s"
+            << ", frames per second: " << static_cast<double>(count * steps) / renderTime << std::endl;
+    }
+    std::cout << "Total reward: " << totalReward << ", finished episodes: " << episodes
+        << ", observation size: " << observationSize << std::endl;
+    sg_env_destroy(env);
+    return 0;
+}
\ No newline at end of file
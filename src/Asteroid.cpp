@@ -4,7 +4,7 @@
 
 #include <glm/mat4x4.hpp>
 
-Asteroid::Asteroid() : velocity(0.0f), rotationSpeed(0.0f)
+Asteroid::Asteroid() : velocity(0.0f), rotationSpeed(0.0f), displacement(0.0f)
 {
 }
 
@@ -12,7 +12,8 @@ void Asteroid::update(float deltaTime)
 {
     rotation += rotationSpeed * deltaTime;
     rotation = geom::clampAngle(rotation);
-    position += velocity * deltaTime;
+    displacement = velocity * deltaTime;
+    position += displacement;
 }
 
 glm::vec2 Asteroid::getRemnantOrigin() const
@@ -22,3 +23,19 @@ glm::vec2 Asteroid::getRemnantOrigin() const
     glm::vec2 centerPos = model * glm::vec4(normalizedCenter, 0.0f, 1.0f);
     return centerPos;
 }
+
+void Asteroid::save(BinaryWriter& writer) const
+{
+    GameObject::save(writer);
+    writer.write(velocity);
+    writer.write(rotationSpeed);
+    writer.write(displacement);
+}
+
+void Asteroid::load(BinaryReader& reader)
+{
+    GameObject::load(reader);
+    reader.read(velocity);
+    reader.read(rotationSpeed);
+    reader.read(displacement);
+}
\ No newline at end of file
@@ -14,6 +14,7 @@ class Asteroid : public GameObject
 public:
     glm::vec2 velocity;
     float rotationSpeed;    // Rotation speed in degrees per second.
+    glm::vec2 displacement; // Movement made by the last update, zero if the asteroid did not move.
 
     Asteroid();
 
@@ -22,6 +23,10 @@ public:
 
     // Get the point where asteroid remnants will originate from
     glm::vec2 getRemnantOrigin() const;
+
+    // Write the state of the asteroid / read the state written by save.
+    void save(BinaryWriter& writer) const;
+    void load(BinaryReader& reader);
 };
 
 #endif
\ No newline at end of file
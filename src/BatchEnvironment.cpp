@@ -0,0 +1,164 @@
+#include "BatchEnvironment.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/common.hpp>
+#include <glm/trigonometric.hpp>
+
+#include <algorithm>
+#include <utility>
+
+const std::size_t BatchEnvironment::OBSERVED_ASTEROIDS;
+const std::size_t BatchEnvironment::PLAYER_FEATURES;
+const std::size_t BatchEnvironment::ASTEROID_FEATURES;
+const std::size_t BatchEnvironment::OBSERVATION_SIZE;
+
+namespace
+{
+    // Get the shortest vector from one point to another in a world that wraps around.
+    glm::vec2 getWrappedOffset(glm::vec2 from, glm::vec2 to, glm::vec2 worldSize)
+    {
+        glm::vec2 offset = to - from;
+        return offset - worldSize * glm::round(offset / worldSize);
+    }
+}
+
+BatchEnvironment::BatchEnvironment(std::size_t count, unsigned int seed, std::size_t threadCount)
+    : m_jobs(threadCount), m_simulations(count), m_scores(count, 0), m_totalSteps(0)
+{
+    for (std::size_t i = 0; i < count; i++)
+    {
+        m_simulations[i] = std::make_unique<Simulation>(seed + static_cast<unsigned int>(i), m_jobs);
+    }
+}
+
+void BatchEnvironment::reset(float* observations)
+{
+    m_jobs.parallelFor(m_simulations.size(), INSTANCE_CHUNK_SIZE,
+        [this, observations](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; i++)
+            {
+                m_simulations[i]->restart();
+                m_scores[i] = 0;
+                if (observations != nullptr)
+                {
+                    observe(i, observations + i * OBSERVATION_SIZE);
+                }
+            }
+        });
+}
+
+void BatchEnvironment::step(const unsigned char* actions, float* rewards, unsigned char* dones, float* observations)
+{
+    m_jobs.parallelFor(m_simulations.size(), INSTANCE_CHUNK_SIZE,
+        [this, actions, rewards, dones, observations](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; i++)
+            {
+                Simulation& simulation = *m_simulations[i];
+                simulation.step(InputState(actions[i]));
+                std::uint64_t score = simulation.getScore();
+                bool done = simulation.getState() == Simulation::State::Over;
+                if (rewards != nullptr)
+                {
+                    rewards[i] = static_cast<float>(score - m_scores[i]);
+                }
+                if (dones != nullptr)
+                {
+                    dones[i] = done ? 1 : 0;
+                }
+                if (done)
+                {
+                    simulation.restart();
+                }
+                m_scores[i] = simulation.getScore();
+                if (observations != nullptr)
+                {
+                    observe(i, observations + i * OBSERVATION_SIZE);
+                }
+            }
+        });
+    m_totalSteps += m_simulations.size();
+}
+
+void BatchEnvironment::observe(float* observations)
+{
+    m_jobs.parallelFor(m_simulations.size(), INSTANCE_CHUNK_SIZE,
+        [this, observations](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; i++)
+            {
+                observe(i, observations + i * OBSERVATION_SIZE);
+            }
+        });
+}
+
+void BatchEnvironment::render(const ObservationRasterizer& rasterizer, unsigned char* frames)
+{
+    std::size_t frameSize = rasterizer.getFrameSize();
+    m_jobs.parallelFor(m_simulations.size(), INSTANCE_CHUNK_SIZE,
+        [this, &rasterizer, frames, frameSize](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; i++)
+            {
+                rasterizer.render(*m_simulations[i], frames + i * frameSize);
+            }
+        });
+}
+
+std::size_t BatchEnvironment::getCount() const
+{
+    return m_simulations.size();
+}
+
+std::uint64_t BatchEnvironment::getTotalSteps() const
+{
+    return m_totalSteps;
+}
+
+void BatchEnvironment::observe(std::size_t index, float* observation) const
+{
+    // Distances and indices of asteroids, reused by observations made by the same thread
+    thread_local std::vector<std::pair<float, std::size_t>> nearest;
+    const Simulation& simulation = *m_simulations[index];
+    const Player& player = simulation.getPlayer();
+    glm::vec2 worldSize = simulation.getWorldSize();
+    glm::vec2 viewSize = simulation.getViewSize();
+    glm::vec2 playerCenter = player.position + 0.5f * player.size;
+    // Player: position in the world, velocity, direction and whether it can shoot
+    observation[0] = playerCenter.x / worldSize.x;
+    observation[1] = playerCenter.y / worldSize.y;
+    observation[2] = player.velocity.x * VELOCITY_SCALE;
+    observation[3] = player.velocity.y * VELOCITY_SCALE;
+    observation[4] = glm::sin(glm::radians(player.rotation));
+    observation[5] = glm::cos(glm::radians(player.rotation));
+    observation[6] = player.canShoot(simulation.getTick()) ? 1.0f : 0.0f;
+    // Asteroids: presence flag, offset from the player relative to the view and velocity relative to the player,
+    // ordered from the nearest one, missing asteroids are zeros
+    const std::vector<Asteroid>& asteroids = simulation.getAsteroids();
+    nearest.clear();
+    for (std::size_t i = 0; i < asteroids.size(); i++)
+    {
+        glm::vec2 offset = getWrappedOffset(playerCenter, asteroids[i].position + 0.5f * asteroids[i].size, worldSize);
+        nearest.emplace_back(offset.x * offset.x + offset.y * offset.y, i);
+    }
+    std::size_t observed = std::min(OBSERVED_ASTEROIDS, nearest.size());
+    std::partial_sort(nearest.begin(), nearest.begin() + observed, nearest.end());
+    float* features = observation + PLAYER_FEATURES;
+    for (std::size_t i = 0; i < OBSERVED_ASTEROIDS; i++, features += ASTEROID_FEATURES)
+    {
+        if (i >= observed)
+        {
+            std::fill(features, features + ASTEROID_FEATURES, 0.0f);
+            continue;
+        }
+        const Asteroid& asteroid = asteroids[nearest[i].second];
+        glm::vec2 offset = getWrappedOffset(playerCenter, asteroid.position + 0.5f * asteroid.size, worldSize) / viewSize;
+        glm::vec2 velocity = (asteroid.velocity - player.velocity) * VELOCITY_SCALE;
+        features[0] = 1.0f;
+        features[1] = offset.x;
+        features[2] = offset.y;
+        features[3] = velocity.x;
+        features[4] = velocity.y;
+    }
+}
\ No newline at end of file
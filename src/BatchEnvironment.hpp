@@ -0,0 +1,74 @@
+#ifndef BATCH_ENVIRONMENT_HPP
+#define BATCH_ENVIRONMENT_HPP
+
+#include "Simulation.hpp"
+#include "JobSystem.hpp"
+#include "InputState.hpp"
+#include "ObservationRasterizer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+* Many independent simulations stepped together, used by automated agents.
+* Every step takes one action per instance and writes rewards, done flags and observations
+* of all instances to contiguous arrays given by the caller. Instances are split into chunks
+* run in parallel by one thread pool shared with the simulations.
+* Values the environment keeps for instances are stored in arrays indexed by the instance, but each simulation
+* is a separate object owning its arrays of objects. With thousands of instances a step therefore reads memory
+* scattered over the heap, which is slower per instance than a batch that fits in the cache.
+*/
+class BatchEnvironment final
+{
+public:
+    // Number of asteroids nearest to the player included in an observation
+    static const std::size_t OBSERVED_ASTEROIDS = 8;
+    // Number of floats in the observation of one instance: the player followed by the nearest asteroids
+    static const std::size_t PLAYER_FEATURES = 7;
+    static const std::size_t ASTEROID_FEATURES = 5;
+    static const std::size_t OBSERVATION_SIZE = PLAYER_FEATURES + OBSERVED_ASTEROIDS * ASTEROID_FEATURES;
+
+    // Create the given number of instances, instance i is seeded by seed + i.
+    // The pool has the given number of worker threads, zero selects it by the hardware.
+    BatchEnvironment(std::size_t count, unsigned int seed, std::size_t threadCount = 0);
+
+    BatchEnvironment(const BatchEnvironment&) = delete;
+    BatchEnvironment& operator=(const BatchEnvironment&) = delete;
+
+    // Restart all instances and write their observations, if observations are not null.
+    void reset(float* observations);
+
+    // Advance every instance by one update with its action (bits of InputState::Button).
+    // Reward of an instance is the number of asteroids it destroyed in the update. An instance is done
+    // when the player is hit, it is restarted right away and its observation is the first one of the new game.
+    // Any of the output arrays may be null if the caller does not need it.
+    void step(const unsigned char* actions, float* rewards, unsigned char* dones, float* observations);
+
+    // Write observations of all instances.
+    void observe(float* observations);
+
+    // Draw views of all instances by the rasterizer into frames, frame of instance i starts at i * rasterizer.getFrameSize().
+    void render(const ObservationRasterizer& rasterizer, unsigned char* frames);
+
+    std::size_t getCount() const;
+
+    // Get number of updates made by all instances since the creation of the environment.
+    std::uint64_t getTotalSteps() const;
+
+private:
+    // Minimal number of instances stepped by one job
+    const std::size_t INSTANCE_CHUNK_SIZE = 16;
+    // Scale of velocities in observations, the speed of bullets is mapped to one
+    const float VELOCITY_SCALE = 1.0f / 400.0f;
+
+    JobSystem m_jobs;
+    std::vector<std::unique_ptr<Simulation>> m_simulations;
+    std::vector<std::uint64_t> m_scores;    // Score of each simulation after the last step
+    std::uint64_t m_totalSteps;
+
+    void observe(std::size_t index, float* observation) const;
+};
+
+#endif
\ No newline at end of file
@@ -1,22 +1,65 @@
 #include "Bullet.hpp"
 
+#include "Geometry.hpp"
+
 #include <glm/vec2.hpp>
 
-Bullet::Bullet() : velocity(0.0f)
+Bullet::Bullet() : velocity(0.0f), m_previousPosition(0.0f)
 {
 }
 
 void Bullet::update(float deltaTime)
 {
+    m_previousPosition = position;
     position += velocity * deltaTime;
 }
 
-void Bullet::setLifetime(double lifetime)
+void Bullet::resetPreviousPosition()
+{
+    m_previousPosition = position;
+}
+
+bool Bullet::hits(const GameObject& target, glm::vec2 targetDisplacement, const HullBuffer& hulls,
+    CollisionStats& stats) const
+{
+    ++stats.queries;
+    // Path of the center relative to the target
+    glm::vec2 end = position + 0.5f * size;
+    glm::vec2 start = m_previousPosition + 0.5f * size + targetDisplacement;
+    geom::AABB box = getBoundingBox();
+    geom::AABB startBox = geom::AABB{ box.min + start - end, box.max + start - end };
+    if (!geom::boxesOverlap(geom::mergeBoxes(box, startBox), target.getBoundingBox()))
+    {
+        ++stats.rejectedByBox;
+        return false;
+    }
+    glm::vec2 targetCenter = target.position + 0.5f * target.size;
+    float radiusSum = shape->getBoundingRadius() + target.shape->getBoundingRadius();
+    if (geom::pointSegmentDistance(targetCenter, start, end) > radiusSum)
+    {
+        ++stats.rejectedByCircle;
+        return false;
+    }
+    ++stats.polygonTests;
+    bool hit = hulls.intersect(getHullIndex(), target.getHullIndex())
+        || hulls.intersectSegment(target.getHullIndex(), start, end);
+    if (hit)
+    {
+        ++stats.hits;
+    }
+    return hit;
+}
+
+void Bullet::save(BinaryWriter& writer) const
 {
-    m_lifeTimer.start(lifetime);
+    GameObject::save(writer);
+    writer.write(velocity);
+    writer.write(m_previousPosition);
 }
 
-bool Bullet::isDestroyed() const
+void Bullet::load(BinaryReader& reader)
 {
-    return m_lifeTimer.finished();
+    GameObject::load(reader);
+    reader.read(velocity);
+    reader.read(m_previousPosition);
 }
\ No newline at end of file
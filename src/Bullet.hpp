@@ -2,7 +2,6 @@
 #define BULLET_HPP
 
 #include "GameObject.hpp"
-#include "Timer.hpp"
 
 /**
 * Represents a bullet shot by a player.
@@ -17,14 +16,20 @@ public:
     // Move the bullet.
     void update(float deltaTime) override;
 
-    // Set the duration for which the bullet will exist.
-    void setLifetime(double lifetime);
+    // Forget the position before the last update, e.g. after the bullet was moved to the other side of screen.
+    void resetPreviousPosition();
 
-    // Check if lifetime is up.
-    bool isDestroyed() const;
+    // Check if the bullet hit the target during the last update. The path of the bullet relative
+    // to the target is tested in addition to the current position, so fast bullets cannot pass through.
+    // Target displacement is the distance the target moved during the last update.
+    bool hits(const GameObject& target, glm::vec2 targetDisplacement, const HullBuffer& hulls, CollisionStats& stats) const;
+
+    // Write the state of the bullet / read the state written by save.
+    void save(BinaryWriter& writer) const;
+    void load(BinaryReader& reader);
 
 private:
-    Timer m_lifeTimer;
+    glm::vec2 m_previousPosition;   // Position before the last update
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "Clock.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+Clock::~Clock()
+{
+}
+
+RealClock::RealClock() : m_start(std::chrono::steady_clock::now())
+{
+}
+
+double RealClock::getTime() const
+{
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_start;
+    return elapsed.count();
+}
+
+ManualClock::ManualClock(double time) : m_time(time)
+{
+}
+
+double ManualClock::getTime() const
+{
+    return m_time;
+}
+
+void ManualClock::advance(double seconds)
+{
+    if (seconds < 0.0)
+    {
+        throw std::logic_error("Manual clock cannot go back in time.");
+    }
+    m_time += seconds;
+}
+
+ScaledClock::ScaledClock(std::shared_ptr<Clock> source, double scale) : m_source(std::move(source)),
+m_scale(1.0), m_sourceOrigin(0.0), m_origin(0.0)
+{
+    if (!m_source)
+    {
+        throw std::logic_error("Scaled clock requires a source clock.");
+    }
+    m_sourceOrigin = m_source->getTime();
+    setScale(scale);
+}
+
+double ScaledClock::getTime() const
+{
+    return m_origin + (m_source->getTime() - m_sourceOrigin) * m_scale;
+}
+
+void ScaledClock::setScale(double scale)
+{
+    if (scale < 0.0)
+    {
+        throw std::logic_error("Scale of clock cannot be negative.");
+    }
+    m_origin = getTime();
+    m_sourceOrigin = m_source->getTime();
+    m_scale = scale;
+}
+
+double ScaledClock::getScale() const
+{
+    return m_scale;
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+#include <chrono>
+#include <memory>
+
+/**
+* Source of time for the game loop.
+* The game never reads time from elsewhere, so it can run on a real clock, on a clock stepped
+* by the caller, or on a clock running faster or slower than real time.
+*/
+class Clock
+{
+public:
+    virtual ~Clock();
+
+    // Get time in seconds. The time never decreases.
+    virtual double getTime() const = 0;
+};
+
+/**
+* Clock measuring real time since its creation, does not depend on GLFW.
+*/
+class RealClock final : public Clock
+{
+public:
+    RealClock();
+
+    double getTime() const override;
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+* Clock whose time changes only when it is advanced by the caller.
+*/
+class ManualClock final : public Clock
+{
+public:
+    explicit ManualClock(double time = 0.0);
+
+    double getTime() const override;
+
+    // Move time forward by the given number of seconds.
+    void advance(double seconds);
+
+private:
+    double m_time;
+};
+
+/**
+* Clock running a given number of times faster than another clock.
+* Changing the scale does not change the current time, only its speed from now on.
+*/
+class ScaledClock final : public Clock
+{
+public:
+    ScaledClock(std::shared_ptr<Clock> source, double scale);
+
+    double getTime() const override;
+
+    // Set how many seconds pass on this clock per second of the source clock.
+    void setScale(double scale);
+
+    double getScale() const;
+
+private:
+    std::shared_ptr<Clock> m_source;
+    double m_scale;
+    double m_sourceOrigin;  // Time of the source when the scale was last set
+    double m_origin;        // Time of this clock when the scale was last set
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "CollisionStats.hpp"
+
+CollisionStats::CollisionStats()
+{
+    reset();
+}
+
+void CollisionStats::reset()
+{
+    queries = 0;
+    rejectedByBox = 0;
+    rejectedByCircle = 0;
+    polygonTests = 0;
+    hits = 0;
+}
+
+CollisionStats& CollisionStats::operator+=(const CollisionStats& other)
+{
+    queries += other.queries;
+    rejectedByBox += other.rejectedByBox;
+    rejectedByCircle += other.rejectedByCircle;
+    polygonTests += other.polygonTests;
+    hits += other.hits;
+    return *this;
+}
+
+float CollisionStats::getRejectionRate() const
+{
+    if (queries == 0)
+    {
+        return 0.0f;
+    }
+    return static_cast<float>(rejectedByBox + rejectedByCircle) / static_cast<float>(queries);
+}
+
+std::ostream& operator<<(std::ostream& stream, const CollisionStats& stats)
+{
+    return stream << "queries: " << stats.queries
+        << ", rejected by box: " << stats.rejectedByBox
+        << ", rejected by circle: " << stats.rejectedByCircle
+        << ", polygon tests: " << stats.polygonTests
+        << ", hits: " << stats.hits
+        << ", rejection rate: " << stats.getRejectionRate() * 100.0f << " %";
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef COLLISION_STATS_HPP
+#define COLLISION_STATS_HPP
+
+#include <cstddef>
+#include <ostream>
+
+/**
+* Counters of collision queries.
+* Used for measuring how many pairs of objects are rejected by cheap tests before the polygon test.
+*/
+struct CollisionStats final
+{
+    std::size_t queries;            // Number of tested pairs
+    std::size_t rejectedByBox;      // Pairs rejected because their bounding boxes do not overlap
+    std::size_t rejectedByCircle;   // Pairs rejected because their bounding circles do not overlap
+    std::size_t polygonTests;       // Pairs that had to be tested by polygon intersection
+    std::size_t hits;               // Pairs that collided
+
+    CollisionStats();
+
+    // Set all counters to zero.
+    void reset();
+
+    // Add counters of other stats.
+    CollisionStats& operator+=(const CollisionStats& other);
+
+    // Get the fraction of queries that were rejected before the polygon test.
+    float getRejectionRate() const;
+};
+
+// Print the counters in a single line.
+std::ostream& operator<<(std::ostream& stream, const CollisionStats& stats);
+
+#endif
\ No newline at end of file
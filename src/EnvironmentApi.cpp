@@ -0,0 +1,138 @@
+#include "EnvironmentApi.h"
+
+#include "BatchEnvironment.hpp"
+
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+static_assert(SG_ENV_LEFT == static_cast<int>(InputState::BUTTON_LEFT) && SG_ENV_RIGHT == static_cast<int>(InputState::BUTTON_RIGHT)
+    && SG_ENV_FORWARD == static_cast<int>(InputState::BUTTON_FORWARD) && SG_ENV_SHOOT == static_cast<int>(InputState::BUTTON_SHOOT),
+    "Bits of actions must match buttons of InputState.");
+static_assert(ObservationRasterizer::CHANNEL_COUNT == 4, "Frames with one plane per type must have four channels.");
+
+struct sg_env
+{
+    BatchEnvironment environment;
+
+    sg_env(std::size_t count, unsigned int seed, std::size_t threadCount) : environment(count, seed, threadCount)
+    {
+    }
+};
+
+namespace
+{
+    // Exceptions must not cross the C interface, their messages are kept for sg_env_get_error
+    thread_local std::string t_error;
+
+    template<typename F>
+    int guard(F function)
+    {
+        try
+        {
+            function();
+            t_error.clear();
+            return 0;
+        }
+        catch (const std::exception& e)
+        {
+            t_error = e.what();
+            return -1;
+        }
+    }
+
+    void checkEnvironment(const sg_env* env)
+    {
+        if (env == nullptr)
+        {
+            throw std::invalid_argument("Environment is null.");
+        }
+    }
+}
+
+sg_env* sg_env_create(size_t count, unsigned int seed, size_t thread_count)
+{
+    sg_env* env = nullptr;
+    guard([&]() { env = new sg_env(count, seed, thread_count); });
+    return env;
+}
+
+void sg_env_destroy(sg_env* env)
+{
+    delete env;
+}
+
+size_t sg_env_get_count(const sg_env* env)
+{
+    return env != nullptr ? env->environment.getCount() : 0;
+}
+
+size_t sg_env_get_observation_size(void)
+{
+    return BatchEnvironment::OBSERVATION_SIZE;
+}
+
+int sg_env_reset(sg_env* env, float* observations)
+{
+    return guard([&]()
+        {
+            checkEnvironment(env);
+            env->environment.reset(observations);
+        });
+}
+
+int sg_env_step(sg_env* env, const unsigned char* actions, float* rewards, unsigned char* dones, float* observations)
+{
+    return guard([&]()
+        {
+            checkEnvironment(env);
+            if (actions == nullptr)
+            {
+                throw std::invalid_argument("Actions are null.");
+            }
+            env->environment.step(actions, rewards, dones, observations);
+        });
+}
+
+int sg_env_observe(sg_env* env, float* observations)
+{
+    return guard([&]()
+        {
+            checkEnvironment(env);
+            if (observations == nullptr)
+            {
+                throw std::invalid_argument("Observations are null.");
+            }
+            env->environment.observe(observations);
+        });
+}
+
+size_t sg_env_get_frame_size(size_t width, size_t height, size_t channels)
+{
+    size_t size = 0;
+    guard([&]() { size = ObservationRasterizer(width, height, channels).getFrameSize(); });
+    return size;
+}
+
+int sg_env_render(sg_env* env, size_t width, size_t height, size_t channels, unsigned char* frames)
+{
+    return guard([&]()
+        {
+            checkEnvironment(env);
+            if (frames == nullptr)
+            {
+                throw std::invalid_argument("Frames are null.");
+            }
+            env->environment.render(ObservationRasterizer(width, height, channels), frames);
+        });
+}
+
+uint64_t sg_env_get_total_steps(const sg_env* env)
+{
+    return env != nullptr ? env->environment.getTotalSteps() : 0;
+}
+
+const char* sg_env_get_error(void)
+{
+    return t_error.c_str();
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef ENVIRONMENT_API_H
+#define ENVIRONMENT_API_H
+
+/**
+* C interface of the batched environment (BatchEnvironment) exported by the SpaceGameEnv shared library.
+* Functions returning int return zero on success and a negative value on failure,
+* sg_env_get_error then describes the last failure of the calling thread.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#   if defined(SG_ENV_EXPORTS)
+#       define SG_ENV_API __declspec(dllexport)
+#   else
+#       define SG_ENV_API __declspec(dllimport)
+#   endif
+#else
+#   define SG_ENV_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct sg_env sg_env;
+
+/* Bits of an action, equal to InputState::Button. */
+enum
+{
+    SG_ENV_LEFT = 1 << 0,
+    SG_ENV_RIGHT = 1 << 1,
+    SG_ENV_FORWARD = 1 << 2,
+    SG_ENV_SHOOT = 1 << 3
+};
+
+/* Create count instances seeded by seed, seed + 1, ..., stepped by the given number of worker threads
+   (zero selects it by the hardware). Returns null on failure. */
+SG_ENV_API sg_env* sg_env_create(size_t count, unsigned int seed, size_t thread_count);
+
+SG_ENV_API void sg_env_destroy(sg_env* env);
+
+SG_ENV_API size_t sg_env_get_count(const sg_env* env);
+
+/* Number of floats in the observation of one instance. */
+SG_ENV_API size_t sg_env_get_observation_size(void);
+
+/* Restart all instances, observations has count * observation size floats or is null. */
+SG_ENV_API int sg_env_reset(sg_env* env, float* observations);
+
+/* Step all instances by one update. actions has count elements, rewards, dones and observations
+   have count elements (count * observation size floats for observations) or are null. */
+SG_ENV_API int sg_env_step(sg_env* env, const unsigned char* actions, float* rewards, unsigned char* dones, float* observations);
+
+/* Write observations of all instances without stepping them. */
+SG_ENV_API int sg_env_observe(sg_env* env, float* observations);
+
+/* Number of bytes of one frame drawn by sg_env_render, zero if the size or channels are not valid. */
+SG_ENV_API size_t sg_env_get_frame_size(size_t width, size_t height, size_t channels);
+
+/* Draw the views of all instances into frames of width x height bytes per channel. With one channel, types
+   of objects have different intensities, with four channels each type (player, asteroids, bullets, remnants)
+   has its own occupancy plane. frames has count * frame size bytes. */
+SG_ENV_API int sg_env_render(sg_env* env, size_t width, size_t height, size_t channels, unsigned char* frames);
+
+/* Number of updates made by all instances since the creation of the environment. */
+SG_ENV_API uint64_t sg_env_get_total_steps(const sg_env* env);
+
+/* Description of the last failure of the calling thread, empty if there was none. */
+SG_ENV_API const char* sg_env_get_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "FrameReadback.hpp"
+
+#include "Debug.hpp"
+
+FrameReadback::FrameReadback(unsigned int width, unsigned int height, std::size_t bufferCount)
+    : m_width(width), m_height(height), m_buffers(bufferCount), m_oldest(0), m_busyCount(0), m_droppedCount(0)
+{
+    if (bufferCount == 0)
+    {
+        throw std::logic_error("Frame readback requires at least one buffer.");
+    }
+    GLsizeiptr size = static_cast<GLsizeiptr>(width) * height * 4;
+    for (auto&& buffer : m_buffers)
+    {
+        GL_CALL(glGenBuffers(1, &buffer.id));
+        GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.id));
+        GL_CALL(glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ));
+        buffer.fence = nullptr;
+        buffer.tag = 0;
+    }
+    GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+}
+
+FrameReadback::~FrameReadback()
+{
+    // Errors are not checked, destructors must not throw
+    for (auto&& buffer : m_buffers)
+    {
+        if (buffer.fence != nullptr)
+        {
+            glDeleteSync(buffer.fence);
+        }
+        glDeleteBuffers(1, &buffer.id);
+    }
+}
+
+void FrameReadback::capture(std::uint64_t tag, const Consumer& consumer)
+{
+    while (m_busyCount > 0 && collect(consumer, false))
+    {
+    }
+    if (m_busyCount == m_buffers.size())
+    {
+        ++m_droppedCount;
+        return;
+    }
+    Buffer& buffer = m_buffers[(m_oldest + m_busyCount) % m_buffers.size()];
+    GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.id));
+    GL_CALL(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+    // With a pack buffer bound the copy is only queued, the pointer is an offset into the buffer
+    GL_CALL(glReadPixels(0, 0, static_cast<GLsizei>(m_width), static_cast<GLsizei>(m_height), GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+    buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    buffer.tag = tag;
+    ++m_busyCount;
+}
+
+void FrameReadback::flush(const Consumer& consumer)
+{
+    while (m_busyCount > 0)
+    {
+        collect(consumer, true);
+    }
+}
+
+std::size_t FrameReadback::getDroppedCount() const
+{
+    return m_droppedCount;
+}
+
+bool FrameReadback::collect(const Consumer& consumer, bool wait)
+{
+    Buffer& buffer = m_buffers[m_oldest];
+    // Commands are flushed so that the fence eventually signals even if nothing else flushes them
+    GLuint64 timeout = wait ? GL_TIMEOUT_IGNORED : 0;
+    GLenum status = glClientWaitSync(buffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+    if (status == GL_TIMEOUT_EXPIRED)
+    {
+        return false;
+    }
+    if (status == GL_WAIT_FAILED)
+    {
+        throw std::runtime_error("Waiting for a frame read back failed.");
+    }
+    glDeleteSync(buffer.fence);
+    buffer.fence = nullptr;
+    GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.id));
+    GLsizeiptr size = static_cast<GLsizeiptr>(m_width) * m_height * 4;
+    const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (pixels != nullptr)
+    {
+        consumer(static_cast<const unsigned char*>(pixels), buffer.tag);
+        GL_CALL(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    }
+    GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+    m_oldest = (m_oldest + 1) % m_buffers.size();
+    --m_busyCount;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef FRAME_READBACK_HPP
+#define FRAME_READBACK_HPP
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+* Reads rendered frames back to the CPU without waiting for the GPU.
+* Every captured frame is copied by glReadPixels into one of several pixel buffer objects and a fence is placed
+* after the copy. Buffers are mapped only after their fences signal, usually two or three frames later, so the
+* capture never creates a sync point. If all buffers are still busy, the new frame is dropped instead of waiting.
+* Requires a current OpenGL 3.3 context for its whole lifetime.
+*/
+class FrameReadback final
+{
+public:
+    // Called with RGBA pixels in rows from the bottom and the tag given to capture.
+    // The pixels are valid only during the call.
+    using Consumer = std::function<void(const unsigned char* pixels, std::uint64_t tag)>;
+
+    // Create buffers for frames of the given size.
+    FrameReadback(unsigned int width, unsigned int height, std::size_t bufferCount = 3);
+
+    FrameReadback(const FrameReadback&) = delete;
+    FrameReadback& operator=(const FrameReadback&) = delete;
+
+    ~FrameReadback();
+
+    // Give finished frames to the consumer and start reading the current read framebuffer
+    // (the back buffer before the swap), the frame is marked by the tag.
+    void capture(std::uint64_t tag, const Consumer& consumer);
+
+    // Wait for all frames being read and give them to the consumer, used at the end.
+    void flush(const Consumer& consumer);
+
+    // Get number of frames dropped because all buffers were busy.
+    std::size_t getDroppedCount() const;
+
+private:
+    struct Buffer
+    {
+        GLuint id;
+        GLsync fence;       // Null if the buffer is free
+        std::uint64_t tag;
+    };
+
+    unsigned int m_width;
+    unsigned int m_height;
+    std::vector<Buffer> m_buffers;
+    std::size_t m_oldest;       // Index of the buffer captured first among busy ones
+    std::size_t m_busyCount;
+    std::size_t m_droppedCount;
+
+    // Give the oldest frame to the consumer if its copy finished, or wait for it. Returns false if it is not ready.
+    bool collect(const Consumer& consumer, bool wait);
+};
+
+#endif
\ No newline at end of file
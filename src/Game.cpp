@@ -4,21 +4,34 @@
 #include "Shader.hpp"
 #include "Texture2D.hpp"
 #include "Input.hpp"
-#include "Random.hpp"
-#include "Geometry.hpp"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
 #include <glm/vec2.hpp>
 #include <glm/mat4x4.hpp>
 
+#include <iostream>
 #include <stdexcept>
+#include <utility>
 
-Game::Game() : m_level(1), m_state(GameState::Running)
+Game::Game() : Game(std::make_shared<RealClock>())
 {
 }
 
+Game::Game(std::shared_ptr<Clock> clock, unsigned int seed, unsigned int worldScale) : m_clock(std::move(clock)),
+m_simulation(seed, worldScale),
+m_rewind(REWIND_CAPACITY, REWIND_MAX_BYTES), m_rewinding(false), m_capturedTick(0), m_hasCapturedFrame(false),
+m_frameBudget(DEFAULT_FRAME_BUDGET)
+{
+    if (!m_clock)
+    {
+        throw std::logic_error("Game requires a clock.");
+    }
+}
+
 Game::~Game()
 {
     ResourceManager::clear();
@@ -27,18 +40,86 @@ Game::~Game()
 void Game::run()
 {
     init();
-    restartGame();
+    if (!m_recording && !m_playback)
+    {
+        m_rewind.push(m_simulation.saveState());
+    }
     gameLoop();
+    if (m_readback)
+    {
+        m_readback->flush([this](const unsigned char* pixels, std::uint64_t tick) { consumeFrame(pixels, tick); });
+    }
+    if (m_capture)
+    {
+        m_capture->finish();
+        std::cout << "Captured frames: " << m_capture->getWrittenCount()
+            << ", dropped by reading: " << m_readback->getDroppedCount()
+            << ", dropped by writing: " << m_capture->getDroppedCount() << std::endl;
+    }
+    if (m_recording)
+    {
+        m_recording->save(m_recordingPath);
+    }
+}
+
+const CollisionStats& Game::getCollisionStats() const
+{
+    return m_simulation.getCollisionStats();
+}
+
+void Game::recordTo(const std::string& path)
+{
+    m_recording = std::make_unique<Replay>(m_simulation.getSeed());
+    m_recordingPath = path;
+}
+
+void Game::playBack(const Replay& replay)
+{
+    m_playback = std::make_unique<Replay::Cursor>(replay);
+}
+
+void Game::exportTo(const std::string& name)
+{
+    m_exportName = name;
+}
+
+void Game::captureTo(const std::string& path)
+{
+    m_capturePath = path;
+}
+
+void Game::setFrameBudget(double budget)
+{
+    m_frameBudget = budget;
 }
 
 void Game::init()
 {
     createWindow();
     loadResources();
-    setCommonUniforms();
     m_renderer.init(ResourceManager::getShader("simple"));
-    createPlayer();
-    rnd::setSeed(1);
+    glm::vec2 size = m_simulation.getViewSize();
+    unsigned int width = static_cast<unsigned int>(size.x);
+    unsigned int height = static_cast<unsigned int>(size.y);
+    if (!m_exportName.empty())
+    {
+        m_export = std::make_unique<SharedExport>(m_exportName, width, height);
+        m_export->publishEntities(m_simulation);
+    }
+    if (!m_capturePath.empty())
+    {
+        m_capture = std::make_unique<VideoWriter>(m_capturePath, width, height, Simulation::getUpdatesPerSecond());
+    }
+    if (m_export || m_capture)
+    {
+        m_readback = std::make_unique<FrameReadback>(width, height);
+    }
+    if (m_frameBudget > 0.0)
+    {
+        m_resolution = std::make_unique<ResolutionController>(m_frameBudget, MIN_RESOLUTION_SCALE);
+        m_sceneTarget = std::make_unique<ScaledRenderTarget>(width, height);
+        m_sceneTimer = std::make_unique<GpuTimer>();
+    }
 }
 
 void Game::createWindow()
@@ -50,7 +131,8 @@ void Game::createWindow()
 #ifdef __APPLE__
     Window::setHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
-    m_window = std::make_unique<Window>(SCR_WIDTH, SCR_HEIGHT, "SpaceGame");
+    glm::vec2 size = m_simulation.getViewSize();
+    m_window = std::make_unique<Window>(static_cast<unsigned int>(size.x), static_cast<unsigned int>(size.y), "SpaceGame");
 }
 
 void Game::loadResources() const
@@ -61,232 +143,220 @@ void Game::loadResources() const
     ResourceManager::loadTexture("background", "res/images/background.png", true);
 }
 
-void Game::setCommonUniforms() const
-{
-    glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(SCR_WIDTH), static_cast<float>(SCR_HEIGHT), 0.0f, -1.0f, 1.0f);
-    ResourceManager::getShader("simple").use();
-    ResourceManager::getShader("simple").setMat4("u_projection", projection);
-}
-
-void Game::createPlayer()
-{
-    m_player.texture = ResourceManager::getTexture("ship");
-    m_player.size = PLAYER_SIZE;
-    m_player.reloadTime = PLAYER_RELOAD_TIME;
-    m_player.force = PLAYER_FORCE;
-    m_player.decay = PLAYER_DECAY;
-    m_player.turnSpeed = PLAYER_TURN_SPEED;
-    m_player.bounds = {
-        glm::vec2(0.0f, 1.0f), glm::vec2(0.5f, 0.75f),
-        glm::vec2(1.0f, 1.0f), glm::vec2(0.5f, 0.0f)
-    };
-}
-
-void Game::restartGame()
-{
-    m_level = 1;
-    m_player.position = SCR_CENTER;
-    m_player.velocity = glm::vec2(0.0f);
-    m_player.rotation = 0.0f;
-    m_asteroids.clear();
-    m_bullets.clear();
-    m_remnants.clear();
-    spawnAsteroids();
-    m_state = GameState::Start;
-    m_stateTimer.start(TIME_BETWEEN_STATES);
-}
-
 void Game::gameLoop()
 {
-    double lastUpdated = glfwGetTime();
+    const double updateInterval = m_simulation.getUpdateInterval();
+    double lastUpdated = m_clock->getTime();
     while (!m_window->shouldClose())
     {
-        determineState();
-        processInput();
-        double currentTime = glfwGetTime();
-        while (lastUpdated + UPDATE_INTERVAL <= currentTime)
+        InputState input = processInput();
+        double currentTime = m_clock->getTime();
+        while (lastUpdated + updateInterval <= currentTime)
         {
-            lastUpdated += UPDATE_INTERVAL;
-            update(UPDATE_INTERVAL);
+            lastUpdated += updateInterval;
+            if (m_rewinding && !m_recording && !m_playback)
+            {
+                rewindSimulation();
+            }
+            else if (!stepSimulation(input))
+            {
+                m_window->setToClose();
+                break;
+            }
         }
         render();
+        exportFrame();
+        m_window->swapBuffers();
         glfwPollEvents();
     }
 }
 
-void Game::determineState()
+bool Game::stepSimulation(const InputState& input)
 {
-    if (m_state == GameState::Start && m_stateTimer.finished())
+    InputState stepInput = input;
+    if (m_playback)
     {
-        m_state = GameState::Running;
+        // The keyboard can still end the game during playback
+        if (input.isPressed(InputState::BUTTON_QUIT) || !m_playback->next(stepInput))
+        {
+            return false;
+        }
     }
-    else if (m_state == GameState::Over && m_stateTimer.finished())
+    if (m_recording)
     {
-        restartGame();
+        if (m_recording->needsKeyframe())
+        {
+            m_recording->addKeyframe(m_simulation.saveState());
+        }
+        m_recording->record(stepInput);
     }
-}
-
-void Game::processInput()
-{
-    if (Input::isKeyPressed(GLFW_KEY_ESCAPE))
+    if (stepInput.isPressed(InputState::BUTTON_QUIT))
+    {
+        return false;
+    }
+    m_simulation.step(stepInput);
+    if (m_export)
     {
-        m_window->setToClose();
-        return;
+        m_export->publishEntities(m_simulation);
     }
-    if (Input::isKeyPressed(GLFW_KEY_SPACE) && m_state == GameState::Running && m_player.canShoot())
+    if (!m_recording && !m_playback)
     {
-        shootBullet();
+        m_rewind.push(m_simulation.saveState());
     }
-    m_player.processInput();
+    return true;
 }
 
-void Game::shootBullet()
+void Game::rewindSimulation()
 {
-    Bullet bullet = m_player.shoot(BULLET_SIZE, BULLET_SPEED, BULLET_LIFETIME);
-    m_bullets.push_back(bullet);
+    if (m_rewind.stepBack())
+    {
+        m_simulation.loadState(m_rewind.getState().data(), m_rewind.getState().size());
+        if (m_export)
+        {
+            m_export->publishEntities(m_simulation);
+        }
+    }
 }
 
-void Game::update(float deltaTime)
+InputState Game::processInput()
 {
-    if (m_state != GameState::Running)
+    InputState input;
+    if (Input::isKeyPressed(GLFW_KEY_ESCAPE))
     {
-        return;
+        input.press(InputState::BUTTON_QUIT);
     }
-    handleCollisions();
-    if (m_asteroids.size() == 0)
+    if (Input::isKeyPressed(GLFW_KEY_LEFT))
     {
-        increaseLevel();
+        input.press(InputState::BUTTON_LEFT);
     }
-    m_player.update(deltaTime);
-    for (auto&& asteroid : m_asteroids)
+    if (Input::isKeyPressed(GLFW_KEY_RIGHT))
     {
-        asteroid.update(deltaTime);
+        input.press(InputState::BUTTON_RIGHT);
     }
-    for (auto&& bullet : m_bullets)
+    if (Input::isKeyPressed(GLFW_KEY_UP))
     {
-        bullet.update(deltaTime);
+        input.press(InputState::BUTTON_FORWARD);
     }
-    for (auto&& remnant : m_remnants)
+    if (Input::isKeyPressed(GLFW_KEY_SPACE))
     {
-        remnant.update(deltaTime);
+        input.press(InputState::BUTTON_SHOOT);
     }
-    handleStrayObjects();
+    m_rewinding = Input::isKeyPressed(GLFW_KEY_BACKSPACE);
+    return input;
 }
 
-void Game::handleCollisions()
+void Game::render()
 {
-    removeObjectsIf(m_asteroids,
-        [this](const Asteroid& asteroid)
-        {
-            for (auto it = m_bullets.begin(); it != m_bullets.end(); ++it)
-            {
-                if (it->collidesWith(asteroid))
-                {
-                    createRemnants(asteroid);
-                    m_bullets.erase(it);
-                    return true;
-                }
-            }
-            return false;
-        }
-    );
-    for (auto&& asteroid : m_asteroids)
+    if (m_sceneTarget)
     {
-        if (m_player.collidesWith(asteroid))
+        // Measurements of frames drawn a few frames ago, the GPU is not waited for
+        GpuTimer::Result result;
+        while (m_sceneTimer->poll(result))
         {
-            gameOver();
+            m_resolution->update(result.time, result.tag);
         }
+        float scale = m_resolution->getScale();
+        m_sceneTarget->bind(scale);
+        m_sceneTimer->begin(scale);
+        renderScene();
+        m_sceneTimer->end();
+        m_sceneTarget->present();
     }
-}
-
-void Game::createRemnants(const Asteroid& asteroid)
-{
-    for (size_t i = 0; i < REMNANT_COUNT; i++)
+    else
     {
-        Remnant remnant;
-        remnant.position = asteroid.getRemnantOrigin();
-        remnant.size = REMNANT_SIZE;
-        remnant.setLifetime(REMNANT_LIFETIME);
-        float speed = rnd::getFloat(REMNANT_MIN_SPEED, REMNANT_MAX_SPEED);
-        float velocityAngle = rnd::getFloat(0.0f, 360.0f);
-        remnant.velocity = speed * geom::getDirection(velocityAngle);
-        m_remnants.push_back(remnant);
+        renderScene();
     }
+    setProjection(glm::vec2(0.0f));
+    renderLevelCount();
 }
 
-void Game::handleStrayObjects()
+void Game::renderScene() const
 {
-    removeObjectsIf(m_bullets, [](const Bullet& bullet) { return bullet.isDestroyed(); });
-    removeObjectsIf(m_remnants, [](const Remnant& remnant) { return remnant.isDestroyed(); });
-    for (auto&& bullet : m_bullets)
+    GL_CALL(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+    GL_CALL(glClear(GL_COLOR_BUFFER_BIT));
+    // The background and level icons stay on the screen, objects move with the camera
+    setProjection(glm::vec2(0.0f));
+    const Texture2D& background = ResourceManager::getTexture("background");
+    m_renderer.drawQuad(background, glm::vec2(0.0f), m_simulation.getViewSize());
+    glm::vec2 camera = m_simulation.getViewPosition();
+    setProjection(camera);
+    if (m_simulation.getState() != Simulation::State::Over)
+    {
+        renderObject(m_simulation.getPlayer(), ResourceManager::getTexture("ship"), camera);
+    }
+    const Texture2D& asteroidTexture = ResourceManager::getTexture("asteroid");
+    for (auto&& asteroid : m_simulation.getAsteroids())
     {
-        rolloverObject(bullet);
+        renderObject(asteroid, asteroidTexture, camera);
     }
-    for (auto&& asteroid : m_asteroids)
+    // Bullets and remnants have no texture, they are drawn as white quads
+    for (auto&& bullet : m_simulation.getBullets())
     {
-        rolloverObject(asteroid);
+        renderObject(bullet, Texture2D(), camera);
     }
-    for (auto&& remnant : m_remnants)
+    for (auto&& remnant : m_simulation.getRemnants())
     {
-        rolloverObject(remnant);
+        renderObject(remnant, Texture2D(), camera);
     }
-    rolloverObject(m_player);
 }
 
-void Game::rolloverObject(GameObject& gameObject)
+void Game::exportFrame()
 {
-    glm::vec2 pos = gameObject.position;
-    glm::vec2 size = gameObject.size;
-    if (pos.x < -size.x)
+    if (m_readback)
     {
-        pos.x = SCR_SIZE.x;
+        m_readback->capture(m_simulation.getTick(),
+            [this](const unsigned char* pixels, std::uint64_t tick) { consumeFrame(pixels, tick); });
     }
-    else if (pos.x > SCR_SIZE.x)
-    {
-        pos.x = -size.x;
-    }
-    if (pos.y < -size.y)
-    {
-        pos.y = SCR_SIZE.y;
-    }
-    else if (pos.y > SCR_HEIGHT)
-    {
-        pos.y = -size.y;
-    }
-    gameObject.position = pos;
 }
 
-void Game::render() const
+void Game::consumeFrame(const unsigned char* pixels, std::uint64_t tick)
 {
-    GL_CALL(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
-    GL_CALL(glClear(GL_COLOR_BUFFER_BIT));
-    const Texture2D& background = ResourceManager::getTexture("background");
-    m_renderer.drawQuad(background, glm::vec2(0.0f), glm::vec2(SCR_WIDTH, SCR_HEIGHT));
-    if (m_state != GameState::Over)
-    {
-        m_player.draw(m_renderer);
-    }
-    for (auto&& asteroid : m_asteroids)
+    if (m_export)
     {
-        asteroid.draw(m_renderer);
+        m_export->publishFrame(tick, pixels);
     }
-    for (auto&& bullet : m_bullets)
+    if (m_capture)
     {
-        bullet.draw(m_renderer);
+        // The frame stands for every update since the last captured frame, frames of the same update are skipped.
+        // Rewinding moves the tick back, frames are then counted the same way.
+        std::uint64_t updateCount = !m_hasCapturedFrame ? 1
+            : (tick >= m_capturedTick ? tick - m_capturedTick : m_capturedTick - tick);
+        if (updateCount > 0 && m_capture->write(pixels, static_cast<std::size_t>(updateCount)))
+        {
+            m_capturedTick = tick;
+            m_hasCapturedFrame = true;
+        }
     }
-    for (auto&& remnant : m_remnants)
+}
+
+void Game::renderObject(const GameObject& object, const Texture2D& texture, glm::vec2 camera) const
+{
+    glm::vec2 worldSize = m_simulation.getWorldSize();
+    glm::vec2 viewSize = m_simulation.getViewSize();
+    glm::vec2 viewCenter = camera + 0.5f * viewSize;
+    // Rotated quad stays in the circle around its center, copies of the object outside the view are culled
+    glm::vec2 maxDistance = 0.5f * viewSize + glm::vec2(0.5f * glm::length(object.size));
+    glm::vec2 center = object.position + 0.5f * object.size;
+    // The world wraps around, an object crossing its edge is seen on both sides
+    for (int x = -1; x <= 1; x++)
     {
-        remnant.draw(m_renderer);
+        for (int y = -1; y <= 1; y++)
+        {
+            glm::vec2 offset = glm::vec2(x, y) * worldSize;
+            glm::vec2 distance = glm::abs(center + offset - viewCenter);
+            if (distance.x < maxDistance.x && distance.y < maxDistance.y)
+            {
+                m_renderer.drawQuad(texture, object.position + offset, object.size, object.rotation, object.color);
+            }
+        }
     }
-    renderLevelCount();
-    m_window->swapBuffers();
 }
 
 void Game::renderLevelCount() const
 {
     const Texture2D& texture = ResourceManager::getTexture("ship");
     glm::vec2 pos = glm::vec2(0.0f);
-    for (size_t i = 0; i < m_level; i++)
+    for (size_t i = 0; i < m_simulation.getLevel(); i++)
     {
         if (i % LEVEL_ICONS_IN_ROW == 0)
         {
@@ -301,51 +371,10 @@ void Game::renderLevelCount() const
     }
 }
 
-void Game::gameOver()
-{
-    m_state = GameState::Over;
-    m_stateTimer.start(TIME_BETWEEN_STATES);
-}
-
-void Game::increaseLevel()
-{
-    ++m_level;
-    spawnAsteroids();
-}
-
-void Game::spawnAsteroids()
-{
-    std::size_t count = m_level * ASTEROID_MIN_COUNT;
-    for (size_t i = 0; i < count; i++)
-    {
-        createAsteroid();
-    }
-}
-
-void Game::createAsteroid()
+void Game::setProjection(glm::vec2 camera) const
 {
-    Asteroid asteroid;
-    asteroid.texture = ResourceManager::getTexture("asteroid");
-    asteroid.size = glm::vec2(ASTEROID_SIZE);
-    asteroid.position = getAsteroidRandomPos(ASTEROID_SIZE);
-    asteroid.rotation = rnd::getFloat(0.0f, 360.0f);
-    asteroid.rotationSpeed = rnd::getFloat(ASTEROID_MIN_ROT_SPEED, ASTEROID_MAX_ROT_SPEED);
-    float speed = rnd::getFloat(ASTEROID_MIN_SPEED, ASTEROID_MAX_SPEED);
-    float velocityAngle = rnd::getInt(3) * 90.0f + rnd::getFloat(ASTEROID_MIN_ANGLE, ASTEROID_MAX_ANGLE);
-    asteroid.velocity = speed * geom::getDirection(velocityAngle);
-    asteroid.bounds = {
-        glm::vec2(0.5f, 0.0f), glm::vec2(1.0f, 0.5f), glm::vec2(0.75f, 1.0f),
-        glm::vec2(0.25f, 1.0f), glm::vec2(0.0f, 0.75f), glm::vec2(0.15f, 0.25f)
-    };
-    m_asteroids.push_back(asteroid);
-}
-
-glm::vec2 Game::getAsteroidRandomPos(float size) const
-{
-    float randomX = rnd::getFloat(-size, SCR_WIDTH + size);
-    float randomY = rnd::getFloat(-size, SCR_HEIGHT + size);
-    return rnd::choose<glm::vec2>(
-        glm::vec2(randomX, -size),  // top
-        glm::vec2(-size, randomY)   // left
-        );
+    glm::vec2 size = m_simulation.getViewSize();
+    glm::mat4 projection = glm::ortho(camera.x, camera.x + size.x, camera.y + size.y, camera.y, -1.0f, 1.0f);
+    ResourceManager::getShader("simple").use();
+    ResourceManager::getShader("simple").setMat4("u_projection", projection);
 }
\ No newline at end of file
@@ -5,22 +5,47 @@
 #include "ResourceManager.hpp"
 #include "Renderer.hpp"
 #include "GameObject.hpp"
-#include "Player.hpp"
-#include "Asteroid.hpp"
-#include "Remnant.hpp"
+#include "Simulation.hpp"
+#include "InputState.hpp"
+#include "CollisionStats.hpp"
+#include "Clock.hpp"
+#include "Replay.hpp"
+#include "RewindBuffer.hpp"
+#include "SharedExport.hpp"
+#include "FrameReadback.hpp"
+#include "VideoWriter.hpp"
+#include "ResolutionController.hpp"
+#include "ScaledRenderTarget.hpp"
+#include "GpuTimer.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
 
 #include <memory>
-#include <vector>
-#include <cstdlib>
-#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
 
 /**
 * Space game controller.
+* Presents the simulation in a window, reads controls from the keyboard and steps the simulation
+* by fixed updates according to the clock. Holding backspace rewinds the last seconds of the game,
+* except when the game is recorded or played back. In a world larger than the screen the camera follows
+* the player and objects outside the view are culled before drawing. The game can be exported to other processes
+* through shared memory and captured to a video file, frames are read back asynchronously.
+* The scene is drawn offscreen at a resolution adapted to the measured GPU time and stretched over the window,
+* level icons are drawn over it at the resolution of the window.
 */
 class Game final
 {
 public:
+    // Create the game running on real time.
     Game();
+
+    // Create the game reading time from the given clock, random numbers of the simulation are seeded by the given seed.
+    // The world of the simulation has the given number of screens along each side.
+    explicit Game(std::shared_ptr<Clock> clock, unsigned int seed = 1, unsigned int worldScale = 1);
+
     Game(const Game&) = delete;
     Game& operator=(const Game&) = delete;
 
@@ -29,103 +54,82 @@ public:
     // Initialize the game and start the game loop.
     void run();
 
-private:
-    enum class GameState { Start, Running, Over };
-
-    // Screen constants
-    const unsigned int SCR_WIDTH = 800;
-    const unsigned int SCR_HEIGHT = 600;
-    const glm::vec2 SCR_SIZE = glm::vec2(SCR_WIDTH, SCR_HEIGHT);
-    const glm::vec2 SCR_CENTER = SCR_SIZE / 2.0f;
-
-    // Time constants
-    const float UPDATES_PER_SEC = 60.0f;
-    const float UPDATE_INTERVAL = 1.0f / UPDATES_PER_SEC;
-    const double TIME_BETWEEN_STATES = 1.0;
-
-    // Asteroid constants
-    const std::size_t ASTEROID_MIN_COUNT = 5;
-    const float ASTEROID_MIN_ROT_SPEED = -30.0f;
-    const float ASTEROID_MAX_ROT_SPEED = 30.0f;
-    const float ASTEROID_MIN_SPEED = 70.0f;
-    const float ASTEROID_MAX_SPEED = 200.0f;
-    const float ASTEROID_MIN_ANGLE = 20.0f;
-    const float ASTEROID_MAX_ANGLE = 40.0f;
-    const float ASTEROID_SIZE = 40.0f;
-
-    // Player constants
-    const glm::vec2 PLAYER_SIZE = glm::vec2(28.0f, 35.0f);
-    const float PLAYER_FORCE = 400.0f;
-    const float PLAYER_DECAY = 0.99f;
-    const float PLAYER_TURN_SPEED = 225.0f;
-    const float PLAYER_RELOAD_TIME = 0.3f;
-
-    // Bullet constants
-    const float BULLET_SPEED = 400.0f;
-    const glm::vec2 BULLET_SIZE = glm::vec2(3.0f, 10.0f);
-    const float BULLET_RANGE = std::min(SCR_SIZE.x, SCR_SIZE.y);
-    const double BULLET_LIFETIME = BULLET_RANGE / BULLET_SPEED;
+    // Get counters of collision queries since the start of the game.
+    const CollisionStats& getCollisionStats() const;
+
+    // Record inputs of every update and save them to the given file when the game loop ends.
+    void recordTo(const std::string& path);
+
+    // Read inputs from the replay instead of the keyboard, the game ends with the replay.
+    // The replay should be recorded with the same seed as this game.
+    void playBack(const Replay& replay);
+
+    // Publish the table of objects after every update and every rendered frame to shared rings
+    // '<name>-entities' and '<name>-frames' (see SharedExport).
+    void exportTo(const std::string& name);
+
+    // Write a rendered frame for every update to the given file, as Y4M video if the name ends with '.y4m'
+    // and as raw RGB frames otherwise (see VideoWriter). The video runs at the rate of updates,
+    // so it keeps the speed of the game however fast frames are rendered.
+    void captureTo(const std::string& path);
 
+    // Set GPU time in seconds that drawing the scene should take, the resolution of the scene is lowered
+    // while it takes longer. Zero draws the scene directly to the window at full resolution.
+    void setFrameBudget(double budget);
+
+private:
     // Level icon constants
     const glm::vec2 LEVEL_ICON_SIZE = glm::vec2(16.0f, 20.0f);
     const glm::vec3 LEVEL_ICON_COLOR = glm::vec3(0.5f, 0.5f, 0.5f);
     const float LEVEL_ICON_OFFSET = 20.0f;
     const std::size_t LEVEL_ICONS_IN_ROW = 5;
 
-    // Remnant constants
-    const std::size_t REMNANT_COUNT = 10;
-    const glm::vec2 REMNANT_SIZE = glm::vec2(3.0f);
-    const float REMNANT_LIFETIME = 0.5f;
-    const float REMNANT_MIN_SPEED = 40.0f;
-    const float REMNANT_MAX_SPEED = 80.0f;
+    // Rewind constants
+    const std::size_t REWIND_CAPACITY = 600;                // Ten seconds of updates
+    const std::size_t REWIND_MAX_BYTES = 32 * 1024 * 1024;
+
+    // Dynamic resolution constants, the budget leaves the rest of a frame at 60 Hz to the upscaling and icons
+    const double DEFAULT_FRAME_BUDGET = 0.010;
+    const float MIN_RESOLUTION_SCALE = 0.5f;
 
     std::unique_ptr<Window> m_window;
-    std::size_t m_level;    // Current level
-    GameState m_state;      // Current state
-    Timer m_stateTimer;     // Timer for delay between states
+    std::shared_ptr<Clock> m_clock;
     Renderer m_renderer;
-    Player m_player;
-    std::vector<Asteroid> m_asteroids;
-    std::vector<Bullet> m_bullets;
-    std::vector<Remnant> m_remnants;
+    Simulation m_simulation;
+    std::unique_ptr<Replay> m_recording;    // Recording of the current game, if enabled
+    std::string m_recordingPath;
+    std::unique_ptr<Replay::Cursor> m_playback; // Position in the played replay, if enabled
+    RewindBuffer m_rewind;          // Recent states of the simulation, the newest one is the current state
+    bool m_rewinding;               // Set while the rewind key is held
+    std::string m_exportName;       // Empty if the game is not exported
+    std::unique_ptr<SharedExport> m_export;
+    std::string m_capturePath;      // Empty if the game is not captured
+    std::unique_ptr<VideoWriter> m_capture;
+    std::uint64_t m_capturedTick;   // Tick of the last frame given to the capture
+    bool m_hasCapturedFrame;
+    std::unique_ptr<FrameReadback> m_readback;  // Reads frames for the export and capture, needs the context of the window
+    double m_frameBudget;           // Zero if the resolution of the scene is not scaled
+    std::unique_ptr<ResolutionController> m_resolution;
+    std::unique_ptr<ScaledRenderTarget> m_sceneTarget;  // Scaled scene drawn before the window
+    std::unique_ptr<GpuTimer> m_sceneTimer;     // Measures drawing of the scene for the resolution controller
 
     // Initialization
     void init();
     void createWindow();
     void loadResources() const;
-    void setCommonUniforms() const;
-    void createPlayer();
-    void restartGame();             // Set the game to the state of level one
 
     // Game loop
     void gameLoop();
-    void determineState();          // Determines the next state of the game using m_stateTimer
-    void processInput();
-    void shootBullet();
-    void update(float deltaTime);
-    void handleCollisions();
-    void createRemnants(const Asteroid& asteroid);
-    void handleStrayObjects();
-    void rolloverObject(GameObject& gameObject); // "Rollover" the object to the other side of screen
-    void render() const;
+    InputState processInput();      // Read the state of controls from the keyboard
+    bool stepSimulation(const InputState& input);   // Make one update, returns false if the game should end
+    void rewindSimulation();        // Return the simulation one update back if there is a saved state
+    void render();                  // Draw the frame to the back buffer
+    void renderScene() const;       // Draw the background and objects with the current viewport
+    void exportFrame();             // Read the back buffer for the export and capture, pass on frames read earlier
+    void consumeFrame(const unsigned char* pixels, std::uint64_t tick);  // Pass a frame read back to its users
+    void renderObject(const GameObject& object, const Texture2D& texture, glm::vec2 camera) const;
     void renderLevelCount() const;
-
-    // State change
-    void gameOver();
-    void increaseLevel();       // Increase level and spawn new asteroids
-    void spawnAsteroids();      // Spawn asteroids according to current level
-    void createAsteroid();      // Create a new asteroid and places it randomly outside the screen
-    glm::vec2 getAsteroidRandomPos(float size) const; // Get a random position of an asteroid to be created
-
-    // Remove all objects from vector satisfying the given condition.
-    template<typename T, typename F>
-    void removeObjectsIf(std::vector<T>& objects, F function);
+    void setProjection(glm::vec2 camera) const; // Show the view with the given top left corner
 };
 
-template<typename T, typename F>
-void Game::removeObjectsIf(std::vector<T>& objects, F function)
-{
-    objects.erase(std::remove_if(objects.begin(), objects.end(), function), objects.end());
-}
-
 #endif
\ No newline at end of file
@@ -1,13 +1,13 @@
 #include "GameObject.hpp"
 
-#include "Renderer.hpp"
 #include "Geometry.hpp"
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-GameObject::GameObject() : position(0.0f), size(0.0f), color(1.0f), rotation(0.0f)
+GameObject::GameObject() : position(0.0f), size(0.0f), color(1.0f), rotation(0.0f), id(0),
+m_boundingBox{ glm::vec2(0.0f), glm::vec2(0.0f) }, m_hullIndex(0)
 {
 }
 
@@ -15,20 +15,85 @@ GameObject::~GameObject()
 {
 }
 
-void GameObject::draw(const Renderer& renderer) const
+void GameObject::updateBounds(HullBuffer& hulls)
 {
-    renderer.drawQuad(texture, position, size, rotation, color);
+    m_boundingBox = geom::getBoundingBox(position, size, rotation, shape->getBoundingRadius());
+    m_hullIndex = hulls.add(*shape, position + 0.5f * size, rotation);
 }
 
-bool GameObject::collidesWith(const GameObject& other) const
+void GameObject::save(BinaryWriter& writer) const
 {
-    auto bounds1 = applyModelOnBounds();
-    auto bounds2 = other.applyModelOnBounds();
-    return geom::polygonsIntersect(bounds1, bounds2);
+    writer.write(position);
+    writer.write(size);
+    writer.write(color);
+    writer.write(rotation);
+    writer.write(id);
 }
 
-std::vector<glm::vec2> GameObject::applyModelOnBounds() const
+void GameObject::load(BinaryReader& reader)
 {
-    glm::mat4 model = geom::getModelMatrix(position, size, rotation);
-    return geom::transformPolygon(bounds, model);
+    reader.read(position);
+    reader.read(size);
+    reader.read(color);
+    reader.read(rotation);
+    reader.read(id);
+}
+
+const geom::AABB& GameObject::getBoundingBox() const
+{
+    return m_boundingBox;
+}
+
+bool GameObject::collidesWith(const GameObject& other, const HullBuffer& hulls, CollisionStats& stats) const
+{
+    if (!boundsOverlap(other, stats))
+    {
+        return false;
+    }
+    ++stats.polygonTests;
+    bool collides = hulls.intersect(m_hullIndex, other.m_hullIndex);
+    if (collides)
+    {
+        ++stats.hits;
+    }
+    return collides;
+}
+
+bool GameObject::collidesWith(const GameObject& other, const HullBuffer& hulls, CollisionStats& stats,
+    glm::vec2& translation) const
+{
+    if (!boundsOverlap(other, stats))
+    {
+        return false;
+    }
+    ++stats.polygonTests;
+    bool collides = hulls.intersect(m_hullIndex, other.m_hullIndex, translation);
+    if (collides)
+    {
+        ++stats.hits;
+    }
+    return collides;
+}
+
+bool GameObject::boundsOverlap(const GameObject& other, CollisionStats& stats) const
+{
+    ++stats.queries;
+    if (!geom::boxesOverlap(m_boundingBox, other.m_boundingBox))
+    {
+        ++stats.rejectedByBox;
+        return false;
+    }
+    glm::vec2 center = position + 0.5f * size;
+    glm::vec2 otherCenter = other.position + 0.5f * other.size;
+    if (!geom::circlesOverlap(center, shape->getBoundingRadius(), otherCenter, other.shape->getBoundingRadius()))
+    {
+        ++stats.rejectedByCircle;
+        return false;
+    }
+    return true;
+}
+
+std::size_t GameObject::getHullIndex() const
+{
+    return m_hullIndex;
 }
\ No newline at end of file
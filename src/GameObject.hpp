@@ -1,9 +1,11 @@
 #ifndef GAME_OBJECT_HPP
 #define GAME_OBJECT_HPP
 
-#include "Texture2D.hpp"
-#include "Shader.hpp"
-#include "Renderer.hpp"
+#include "Shape.hpp"
+#include "Geometry.hpp"
+#include "CollisionStats.hpp"
+#include "HullBuffer.hpp"
+#include "Serialization.hpp"
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
@@ -11,6 +13,7 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 /**
 * Represents a game object in a game scene.
@@ -22,20 +25,44 @@ public:
     glm::vec2 size;
     glm::vec3 color;
     float rotation;
-    Texture2D texture;
-    std::vector<glm::vec2> bounds;      // Bounds of object (polygon) used for checking collisions
+    std::shared_ptr<const Shape> shape; // Shape of object used for checking collisions
+    std::uint64_t id;                   // Identifier unique among objects of the same type, increasing in order of creation
 
     GameObject();
     virtual ~GameObject();
-    void draw(const Renderer& renderer) const;
-    bool collidesWith(const GameObject& other) const;
+
+    // Compute the bounding box and add the shape in world coordinates to hulls.
+    // Should be called once per update before checking collisions.
+    void updateBounds(HullBuffer& hulls);
+
+    // Get the bounding box computed by the last call of updateBounds.
+    const geom::AABB& getBoundingBox() const;
+
+    // Check collision with another object using hulls given to the last call of updateBounds.
+    // Pairs are first tested by their bounding boxes and circles, polygons are tested only if both tests pass.
+    // The results of the tests are counted in stats.
+    bool collidesWith(const GameObject& other, const HullBuffer& hulls, CollisionStats& stats) const;
+
+    // Same as above, if the objects collide, translation is set to the shortest vector moving this object out of the other.
+    bool collidesWith(const GameObject& other, const HullBuffer& hulls, CollisionStats& stats, glm::vec2& translation) const;
+
+    // Get index of the hull given to the last call of updateBounds.
+    std::size_t getHullIndex() const;
+
+    // Write the transform and identifier of the object / read them as written by save.
+    // The shape is not saved, it is shared by all objects of the same type.
+    void save(BinaryWriter& writer) const;
+    void load(BinaryReader& reader);
 
     // Updates the game object in real time.
     virtual void update(float deltaTime) = 0;
 
 private:
-    // Applies model matrix on bounds of the object.
-    std::vector<glm::vec2> applyModelOnBounds() const;
+    geom::AABB m_boundingBox;
+    std::size_t m_hullIndex;    // Index of the hull in world coordinates in HullBuffer
+
+    // Count the query and test bounding boxes and circles of the pair, rejections are counted in stats.
+    bool boundsOverlap(const GameObject& other, CollisionStats& stats) const;
 };
 
 #endif
\ No newline at end of file
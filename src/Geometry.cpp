@@ -1,8 +1,14 @@
 #include "Geometry.hpp"
 
+#include "GeometrySimd.hpp"
+
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/geometric.hpp>
+#include <glm/common.hpp>
 
 #include <algorithm>
+#include <limits>
+#include <stdexcept>
 
 bool geom::pointOnSegment(glm::vec2 p, glm::vec2 q, glm::vec2 r)
 {
@@ -55,21 +61,238 @@ bool geom::segmentsIntersect(glm::vec2 p1, glm::vec2 q1, glm::vec2 p2, glm::vec2
 
 bool geom::polygonsIntersect(const std::vector<glm::vec2>& polygon1, const std::vector<glm::vec2>& polygon2)
 {
-    glm::vec2 previous1 = polygon1.back();
-    for (auto&& current1 : polygon1)
+    return polygonsIntersect(polygon1.data(), polygon1.size(), polygon2.data(), polygon2.size());
+}
+
+bool geom::polygonsIntersect(const glm::vec2* polygon1, std::size_t count1, const glm::vec2* polygon2, std::size_t count2)
+{
+    static const simd::SegmentKernel kernel = simd::getKernel(simd::getBestPath());
+    return simd::polygonsIntersect(polygon1, count1, polygon2, count2, kernel);
+}
+
+namespace
+{
+    // Get twice the signed area of polygon, positive for counterclockwise order in a y-up system.
+    float getDoubleArea(const std::vector<glm::vec2>& polygon)
+    {
+        float area = 0.0f;
+        glm::vec2 previous = polygon.back();
+        for (const auto& current : polygon)
+        {
+            area += previous.x * current.y - current.x * previous.y;
+            previous = current;
+        }
+        return area;
+    }
+
+    float cross(glm::vec2 u, glm::vec2 v)
+    {
+        return u.x * v.y - u.y * v.x;
+    }
+
+    // Check if point p lies inside or on the triangle 'abc' with the given orientation.
+    bool pointInTriangle(glm::vec2 p, glm::vec2 a, glm::vec2 b, glm::vec2 c, float sign)
     {
-        glm::vec2 previous2 = polygon2.back();
-        for (auto&& current2 : polygon2)
+        return sign * cross(b - a, p - a) >= 0.0f && sign * cross(c - b, p - b) >= 0.0f
+            && sign * cross(a - c, p - c) >= 0.0f;
+    }
+
+    // Project polygon on axis and return the interval.
+    void project(const geom::ConvexPolygon& polygon, glm::vec2 axis, float& min, float& max)
+    {
+        min = max = glm::dot(polygon.points[0], axis);
+        for (std::size_t i = 1; i < polygon.count; i++)
         {
-            if (segmentsIntersect(previous1, current1, previous2, current2))
+            float projection = glm::dot(polygon.points[i], axis);
+            min = std::min(min, projection);
+            max = std::max(max, projection);
+        }
+    }
+
+    // Test axes of the first polygon. Returns false if one of them separates the polygons,
+    // otherwise updates the smallest overlap and its axis oriented from polygon1 to polygon2.
+    bool testAxes(const geom::ConvexPolygon& axesOwner, const geom::ConvexPolygon& polygon1,
+        const geom::ConvexPolygon& polygon2, float& minOverlap, glm::vec2& minAxis)
+    {
+        for (std::size_t i = 0; i < axesOwner.count; i++)
+        {
+            glm::vec2 axis = axesOwner.normals[i];
+            float min1, max1, min2, max2;
+            project(polygon1, axis, min1, max1);
+            project(polygon2, axis, min2, max2);
+            // Distances to move polygon1 against the axis and along it to separate the intervals,
+            // the shorter one also counts the containment of one interval in the other
+            float backward = max1 - min2;
+            float forward = max2 - min1;
+            float overlap = std::min(backward, forward);
+            if (overlap < 0.0f)
+            {
+                return false;
+            }
+            if (overlap < minOverlap)
             {
-                return true;
+                minOverlap = overlap;
+                minAxis = (backward <= forward) ? axis : -axis;
             }
-            previous2 = current2;
         }
-        previous1 = current1;
+        return true;
     }
-    return false;
+}
+
+bool geom::convexPolygonsIntersect(const ConvexPolygon& polygon1, const ConvexPolygon& polygon2, glm::vec2& translation)
+{
+    float minOverlap = std::numeric_limits<float>::max();
+    glm::vec2 minAxis = zeroVector;
+    if (!testAxes(polygon1, polygon1, polygon2, minOverlap, minAxis) ||
+        !testAxes(polygon2, polygon1, polygon2, minOverlap, minAxis))
+    {
+        return false;
+    }
+    translation = -minOverlap * minAxis;
+    return true;
+}
+
+bool geom::segmentIntersectsConvexPolygon(glm::vec2 p, glm::vec2 q, const ConvexPolygon& polygon)
+{
+    float min, max;
+    for (std::size_t i = 0; i < polygon.count; i++)
+    {
+        glm::vec2 axis = polygon.normals[i];
+        project(polygon, axis, min, max);
+        float projectionP = glm::dot(p, axis);
+        float projectionQ = glm::dot(q, axis);
+        if (std::max(projectionP, projectionQ) < min || std::min(projectionP, projectionQ) > max)
+        {
+            return false;
+        }
+    }
+    // The remaining axis is the normal of the segment
+    glm::vec2 direction = q - p;
+    if (direction == zeroVector)
+    {
+        return true;
+    }
+    glm::vec2 axis = glm::vec2(direction.y, -direction.x);
+    project(polygon, axis, min, max);
+    float projection = glm::dot(p, axis);
+    return min <= projection && projection <= max;
+}
+
+float geom::pointSegmentDistance(glm::vec2 point, glm::vec2 p, glm::vec2 q)
+{
+    glm::vec2 direction = q - p;
+    float lengthSquared = glm::dot(direction, direction);
+    if (lengthSquared == 0.0f)
+    {
+        return glm::distance(point, p);
+    }
+    float t = glm::clamp(glm::dot(point - p, direction) / lengthSquared, 0.0f, 1.0f);
+    return glm::distance(point, p + t * direction);
+}
+
+geom::AABB geom::mergeBoxes(const AABB& box1, const AABB& box2)
+{
+    return AABB{ glm::min(box1.min, box2.min), glm::max(box1.max, box2.max) };
+}
+
+bool geom::isConvex(const std::vector<glm::vec2>& polygon)
+{
+    bool hasPositive = false;
+    bool hasNegative = false;
+    std::size_t count = polygon.size();
+    for (std::size_t i = 0; i < count; i++)
+    {
+        glm::vec2 a = polygon[i];
+        glm::vec2 b = polygon[(i + 1) % count];
+        glm::vec2 c = polygon[(i + 2) % count];
+        float turn = cross(b - a, c - b);
+        hasPositive = hasPositive || turn > 0.0f;
+        hasNegative = hasNegative || turn < 0.0f;
+    }
+    return !(hasPositive && hasNegative);
+}
+
+std::vector<std::vector<glm::vec2>> geom::triangulate(const std::vector<glm::vec2>& polygon)
+{
+    std::vector<std::vector<glm::vec2>> triangles;
+    std::vector<glm::vec2> remaining = polygon;
+    float sign = getDoubleArea(polygon) >= 0.0f ? 1.0f : -1.0f;
+    while (remaining.size() > 3)
+    {
+        std::size_t count = remaining.size();
+        bool clipped = false;
+        for (std::size_t i = 0; i < count && !clipped; i++)
+        {
+            glm::vec2 a = remaining[(i + count - 1) % count];
+            glm::vec2 b = remaining[i];
+            glm::vec2 c = remaining[(i + 1) % count];
+            if (sign * cross(b - a, c - b) <= 0.0f)
+            {
+                continue; // Reflex or degenerate vertex
+            }
+            bool isEar = true;
+            for (std::size_t j = 0; j < count && isEar; j++)
+            {
+                glm::vec2 p = remaining[j];
+                if (p != a && p != b && p != c && pointInTriangle(p, a, b, c, sign))
+                {
+                    isEar = false;
+                }
+            }
+            if (isEar)
+            {
+                triangles.push_back({ a, b, c });
+                remaining.erase(remaining.begin() + i);
+                clipped = true;
+            }
+        }
+        if (!clipped)
+        {
+            throw std::logic_error("Polygon could not be triangulated.");
+        }
+    }
+    triangles.push_back(remaining);
+    return triangles;
+}
+
+std::vector<glm::vec2> geom::getEdgeNormals(const std::vector<glm::vec2>& polygon)
+{
+    float sign = getDoubleArea(polygon) >= 0.0f ? 1.0f : -1.0f;
+    std::vector<glm::vec2> normals;
+    normals.reserve(polygon.size());
+    for (std::size_t i = 0; i < polygon.size(); i++)
+    {
+        glm::vec2 edge = polygon[(i + 1) % polygon.size()] - polygon[i];
+        normals.push_back(glm::normalize(sign * glm::vec2(edge.y, -edge.x)));
+    }
+    return normals;
+}
+
+bool geom::boxesOverlap(const AABB& box1, const AABB& box2)
+{
+    return box1.min.x <= box2.max.x && box2.min.x <= box1.max.x &&
+        box1.min.y <= box2.max.y && box2.min.y <= box1.max.y;
+}
+
+bool geom::circlesOverlap(glm::vec2 center1, float radius1, glm::vec2 center2, float radius2)
+{
+    glm::vec2 difference = center2 - center1;
+    float radiusSum = radius1 + radius2;
+    return glm::dot(difference, difference) <= radiusSum * radiusSum;
+}
+
+geom::AABB geom::getBoundingBox(glm::vec2 position, glm::vec2 size, float rotation, float radius)
+{
+    glm::vec2 center = position + 0.5f * size;
+    // Half extents of the rotated rectangle, limited by the bounding circle
+    float cosAbs = glm::abs(glm::cos(glm::radians(rotation)));
+    float sinAbs = glm::abs(glm::sin(glm::radians(rotation)));
+    glm::vec2 halfExtents = 0.5f * glm::vec2(
+        cosAbs * size.x + sinAbs * size.y,
+        sinAbs * size.x + cosAbs * size.y
+    );
+    halfExtents = glm::min(halfExtents, glm::vec2(radius));
+    return AABB{ center - halfExtents, center + halfExtents };
 }
 
 glm::mat4 geom::getModelMatrix(glm::vec2 position, glm::vec2 size, float rotation)
@@ -5,16 +5,33 @@
 #include <glm/mat4x4.hpp>
 
 #include <vector>
+#include <cstddef>
 
 /**
 * Contains geometry functions and algorithms.
 * Source for checking intersection of line segments:
 * https://www.geeksforgeeks.org/check-if-two-given-line-segments-intersect/
+* Intersection of convex polygons is checked by the separating axis theorem.
 */
 namespace geom
 {
     static const glm::vec2 zeroVector = glm::vec2(0.0f);
 
+    // Axis-aligned bounding box.
+    struct AABB
+    {
+        glm::vec2 min;
+        glm::vec2 max;
+    };
+
+    // Convex polygon given by its points and normals of its edges (edge i goes from point i to point i + 1).
+    struct ConvexPolygon
+    {
+        const glm::vec2* points;
+        const glm::vec2* normals;
+        std::size_t count;
+    };
+
     // Given three colinear points p, q, r, the function checks if
     // point q lies on line segment 'pr'
     bool pointOnSegment(glm::vec2 p, glm::vec2 q, glm::vec2 r);
@@ -32,6 +49,42 @@ namespace geom
     // Check if polygons intersect by checking line segments intersection (does not work for polygon inside polygon).
     bool polygonsIntersect(const std::vector<glm::vec2>& polygon1, const std::vector<glm::vec2>& polygon2);
 
+    // Check if polygons given by their first points and point counts intersect (same as above).
+    // Edges are tested in batches by the fastest kernel from geom::simd supported by the CPU.
+    bool polygonsIntersect(const glm::vec2* polygon1, std::size_t count1, const glm::vec2* polygon2, std::size_t count2);
+
+    // Check if convex polygons intersect using edge normals as separating axes. Works for polygon inside polygon.
+    // If they intersect, translation is set to the shortest vector that moves polygon1 out of polygon2.
+    bool convexPolygonsIntersect(const ConvexPolygon& polygon1, const ConvexPolygon& polygon2, glm::vec2& translation);
+
+    // Check if line segment 'pq' intersects convex polygon or lies inside it.
+    bool segmentIntersectsConvexPolygon(glm::vec2 p, glm::vec2 q, const ConvexPolygon& polygon);
+
+    // Get distance between point and line segment 'pq'.
+    float pointSegmentDistance(glm::vec2 point, glm::vec2 p, glm::vec2 q);
+
+    // Get the smallest box containing both boxes.
+    AABB mergeBoxes(const AABB& box1, const AABB& box2);
+
+    // Check if polygon is convex.
+    bool isConvex(const std::vector<glm::vec2>& polygon);
+
+    // Split simple polygon into triangles by ear clipping.
+    std::vector<std::vector<glm::vec2>> triangulate(const std::vector<glm::vec2>& polygon);
+
+    // Get outward unit normals of edges of polygon (edge i goes from point i to point i + 1).
+    std::vector<glm::vec2> getEdgeNormals(const std::vector<glm::vec2>& polygon);
+
+    // Check if two axis-aligned boxes overlap.
+    bool boxesOverlap(const AABB& box1, const AABB& box2);
+
+    // Check if two circles overlap.
+    bool circlesOverlap(glm::vec2 center1, float radius1, glm::vec2 center2, float radius2);
+
+    // Get bounding box of a shape rotated around the center of a rectangle with the given size
+    // that is also contained in a circle with the given radius around the same center.
+    AABB getBoundingBox(glm::vec2 position, glm::vec2 size, float rotation, float radius);
+
     // Get model matrix for normalized shape (coordinates between 0.0 and 1.0) with the target size.
     glm::mat4 getModelMatrix(glm::vec2 position, glm::vec2 size, float rotation);
 
@@ -0,0 +1,267 @@
+#include "GeometrySimd.hpp"
+
+#include "Geometry.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GEOM_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define GEOM_TARGET_AVX
+#else
+#define GEOM_TARGET_AVX __attribute__((target("avx")))
+#endif
+#else
+#define GEOM_SIMD_X86 0
+#endif
+
+namespace
+{
+    bool segmentIntersectsBatchScalar(glm::vec2 p, glm::vec2 q, const geom::simd::EdgeBatch& batch)
+    {
+        for (std::size_t i = 0; i < batch.count; i++)
+        {
+            glm::vec2 start = glm::vec2(batch.startX[i], batch.startY[i]);
+            glm::vec2 end = glm::vec2(batch.endX[i], batch.endY[i]);
+            if (geom::segmentsIntersect(p, q, start, end))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+#if GEOM_SIMD_X86
+    // Lane masks of orientations, colinear lanes have both masks cleared.
+    struct OrientationSse
+    {
+        __m128 clockwise;
+        __m128 counterclockwise;
+    };
+
+    // Orientation of (p, q, r) in each lane. Values in (-1, 1) are colinear,
+    // because geom::orientation truncates the value to integer.
+    inline OrientationSse orientationSse(__m128 px, __m128 py, __m128 qx, __m128 qy, __m128 rx, __m128 ry)
+    {
+        __m128 val = _mm_sub_ps(
+            _mm_mul_ps(_mm_sub_ps(qy, py), _mm_sub_ps(rx, qx)),
+            _mm_mul_ps(_mm_sub_ps(qx, px), _mm_sub_ps(ry, qy))
+        );
+        return OrientationSse{ _mm_cmpge_ps(val, _mm_set1_ps(1.0f)), _mm_cmple_ps(val, _mm_set1_ps(-1.0f)) };
+    }
+
+    inline __m128 differSse(const OrientationSse& o1, const OrientationSse& o2)
+    {
+        return _mm_or_ps(_mm_xor_ps(o1.clockwise, o2.clockwise), _mm_xor_ps(o1.counterclockwise, o2.counterclockwise));
+    }
+
+    inline __m128 colinearSse(const OrientationSse& o)
+    {
+        return _mm_cmpeq_ps(_mm_or_ps(o.clockwise, o.counterclockwise), _mm_setzero_ps());
+    }
+
+    // Lanes where point q lies in the bounding box of segment 'pr'.
+    inline __m128 pointOnSegmentSse(__m128 px, __m128 py, __m128 qx, __m128 qy, __m128 rx, __m128 ry)
+    {
+        __m128 inX = _mm_and_ps(_mm_cmple_ps(qx, _mm_max_ps(px, rx)), _mm_cmpge_ps(qx, _mm_min_ps(px, rx)));
+        __m128 inY = _mm_and_ps(_mm_cmple_ps(qy, _mm_max_ps(py, ry)), _mm_cmpge_ps(qy, _mm_min_ps(py, ry)));
+        return _mm_and_ps(inX, inY);
+    }
+
+    // Lanes where segment 'p1q1' intersects segment 'p2q2', same cases as geom::segmentsIntersect.
+    inline __m128 segmentsIntersectSse(__m128 p1x, __m128 p1y, __m128 q1x, __m128 q1y,
+        __m128 p2x, __m128 p2y, __m128 q2x, __m128 q2y)
+    {
+        OrientationSse o1 = orientationSse(p1x, p1y, q1x, q1y, p2x, p2y);
+        OrientationSse o2 = orientationSse(p1x, p1y, q1x, q1y, q2x, q2y);
+        OrientationSse o3 = orientationSse(p2x, p2y, q2x, q2y, p1x, p1y);
+        OrientationSse o4 = orientationSse(p2x, p2y, q2x, q2y, q1x, q1y);
+        __m128 general = _mm_and_ps(differSse(o1, o2), differSse(o3, o4));
+        __m128 special1 = _mm_and_ps(colinearSse(o1), pointOnSegmentSse(p1x, p1y, p2x, p2y, q1x, q1y));
+        __m128 special2 = _mm_and_ps(colinearSse(o2), pointOnSegmentSse(p1x, p1y, q2x, q2y, q1x, q1y));
+        __m128 special3 = _mm_and_ps(colinearSse(o3), pointOnSegmentSse(p2x, p2y, p1x, p1y, q2x, q2y));
+        __m128 special4 = _mm_and_ps(colinearSse(o4), pointOnSegmentSse(p2x, p2y, q1x, q1y, q2x, q2y));
+        return _mm_or_ps(_mm_or_ps(general, special1), _mm_or_ps(_mm_or_ps(special2, special3), special4));
+    }
+
+    bool segmentIntersectsBatchSse(glm::vec2 p, glm::vec2 q, const geom::simd::EdgeBatch& batch)
+    {
+        __m128 px = _mm_set1_ps(p.x);
+        __m128 py = _mm_set1_ps(p.y);
+        __m128 qx = _mm_set1_ps(q.x);
+        __m128 qy = _mm_set1_ps(q.y);
+        __m128 count = _mm_set1_ps(static_cast<float>(batch.count));
+        for (std::size_t offset = 0; offset < batch.count; offset += 4)
+        {
+            __m128 intersect = segmentsIntersectSse(px, py, qx, qy,
+                _mm_load_ps(batch.startX + offset), _mm_load_ps(batch.startY + offset),
+                _mm_load_ps(batch.endX + offset), _mm_load_ps(batch.endY + offset));
+            float first = static_cast<float>(offset);
+            __m128 valid = _mm_cmplt_ps(_mm_setr_ps(first, first + 1.0f, first + 2.0f, first + 3.0f), count);
+            if (_mm_movemask_ps(_mm_and_ps(intersect, valid)) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    struct OrientationAvx
+    {
+        __m256 clockwise;
+        __m256 counterclockwise;
+    };
+
+    GEOM_TARGET_AVX inline OrientationAvx orientationAvx(__m256 px, __m256 py, __m256 qx, __m256 qy, __m256 rx, __m256 ry)
+    {
+        __m256 val = _mm256_sub_ps(
+            _mm256_mul_ps(_mm256_sub_ps(qy, py), _mm256_sub_ps(rx, qx)),
+            _mm256_mul_ps(_mm256_sub_ps(qx, px), _mm256_sub_ps(ry, qy))
+        );
+        return OrientationAvx{
+            _mm256_cmp_ps(val, _mm256_set1_ps(1.0f), _CMP_GE_OQ),
+            _mm256_cmp_ps(val, _mm256_set1_ps(-1.0f), _CMP_LE_OQ)
+        };
+    }
+
+    GEOM_TARGET_AVX inline __m256 differAvx(const OrientationAvx& o1, const OrientationAvx& o2)
+    {
+        return _mm256_or_ps(_mm256_xor_ps(o1.clockwise, o2.clockwise),
+            _mm256_xor_ps(o1.counterclockwise, o2.counterclockwise));
+    }
+
+    GEOM_TARGET_AVX inline __m256 colinearAvx(const OrientationAvx& o)
+    {
+        return _mm256_cmp_ps(_mm256_or_ps(o.clockwise, o.counterclockwise), _mm256_setzero_ps(), _CMP_EQ_OQ);
+    }
+
+    GEOM_TARGET_AVX inline __m256 pointOnSegmentAvx(__m256 px, __m256 py, __m256 qx, __m256 qy, __m256 rx, __m256 ry)
+    {
+        __m256 inX = _mm256_and_ps(
+            _mm256_cmp_ps(qx, _mm256_max_ps(px, rx), _CMP_LE_OQ),
+            _mm256_cmp_ps(qx, _mm256_min_ps(px, rx), _CMP_GE_OQ));
+        __m256 inY = _mm256_and_ps(
+            _mm256_cmp_ps(qy, _mm256_max_ps(py, ry), _CMP_LE_OQ),
+            _mm256_cmp_ps(qy, _mm256_min_ps(py, ry), _CMP_GE_OQ));
+        return _mm256_and_ps(inX, inY);
+    }
+
+    GEOM_TARGET_AVX bool segmentIntersectsBatchAvx(glm::vec2 p, glm::vec2 q, const geom::simd::EdgeBatch& batch)
+    {
+        __m256 p1x = _mm256_set1_ps(p.x);
+        __m256 p1y = _mm256_set1_ps(p.y);
+        __m256 q1x = _mm256_set1_ps(q.x);
+        __m256 q1y = _mm256_set1_ps(q.y);
+        __m256 p2x = _mm256_load_ps(batch.startX);
+        __m256 p2y = _mm256_load_ps(batch.startY);
+        __m256 q2x = _mm256_load_ps(batch.endX);
+        __m256 q2y = _mm256_load_ps(batch.endY);
+        OrientationAvx o1 = orientationAvx(p1x, p1y, q1x, q1y, p2x, p2y);
+        OrientationAvx o2 = orientationAvx(p1x, p1y, q1x, q1y, q2x, q2y);
+        OrientationAvx o3 = orientationAvx(p2x, p2y, q2x, q2y, p1x, p1y);
+        OrientationAvx o4 = orientationAvx(p2x, p2y, q2x, q2y, q1x, q1y);
+        __m256 general = _mm256_and_ps(differAvx(o1, o2), differAvx(o3, o4));
+        __m256 special1 = _mm256_and_ps(colinearAvx(o1), pointOnSegmentAvx(p1x, p1y, p2x, p2y, q1x, q1y));
+        __m256 special2 = _mm256_and_ps(colinearAvx(o2), pointOnSegmentAvx(p1x, p1y, q2x, q2y, q1x, q1y));
+        __m256 special3 = _mm256_and_ps(colinearAvx(o3), pointOnSegmentAvx(p2x, p2y, p1x, p1y, q2x, q2y));
+        __m256 special4 = _mm256_and_ps(colinearAvx(o4), pointOnSegmentAvx(p2x, p2y, q1x, q1y, q2x, q2y));
+        __m256 intersect = _mm256_or_ps(_mm256_or_ps(general, special1),
+            _mm256_or_ps(_mm256_or_ps(special2, special3), special4));
+        __m256 valid = _mm256_cmp_ps(_mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f),
+            _mm256_set1_ps(static_cast<float>(batch.count)), _CMP_LT_OQ);
+        return _mm256_movemask_ps(_mm256_and_ps(intersect, valid)) != 0;
+    }
+#endif
+}
+
+void geom::simd::loadEdges(const glm::vec2* polygon, std::size_t count, std::size_t first, EdgeBatch& batch)
+{
+    batch.count = 0;
+    for (std::size_t i = 0; i < EdgeBatch::CAPACITY; i++)
+    {
+        std::size_t edge = first + i;
+        if (edge < count)
+        {
+            glm::vec2 start = polygon[(edge + count - 1) % count];
+            glm::vec2 end = polygon[edge];
+            batch.startX[i] = start.x;
+            batch.startY[i] = start.y;
+            batch.endX[i] = end.x;
+            batch.endY[i] = end.y;
+            ++batch.count;
+        }
+        else
+        {
+            // Padding lanes are masked out by the kernels
+            batch.startX[i] = batch.startY[i] = batch.endX[i] = batch.endY[i] = 0.0f;
+        }
+    }
+}
+
+geom::simd::Path geom::simd::getBestPath()
+{
+#if GEOM_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    bool osUsesXsave = (info[2] & (1 << 27)) != 0;
+    bool cpuHasAvx = (info[2] & (1 << 28)) != 0;
+    if (osUsesXsave && cpuHasAvx && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        return Path::Avx;
+    }
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx"))
+    {
+        return Path::Avx;
+    }
+#endif
+    return Path::Sse;
+#else
+    return Path::Scalar;
+#endif
+}
+
+geom::simd::SegmentKernel geom::simd::getKernel(Path path)
+{
+#if GEOM_SIMD_X86
+    switch (path)
+    {
+    case Path::Sse: return segmentIntersectsBatchSse;
+    case Path::Avx: return segmentIntersectsBatchAvx;
+    default: break;
+    }
+#endif
+    return segmentIntersectsBatchScalar;
+}
+
+const char* geom::simd::getPathName(Path path)
+{
+    switch (path)
+    {
+    case Path::Sse: return "SSE";
+    case Path::Avx: return "AVX";
+    default: return "scalar";
+    }
+}
+
+bool geom::simd::polygonsIntersect(const glm::vec2* polygon1, std::size_t count1,
+    const glm::vec2* polygon2, std::size_t count2, SegmentKernel kernel)
+{
+    EdgeBatch batch;
+    for (std::size_t first = 0; first < count2; first += EdgeBatch::CAPACITY)
+    {
+        loadEdges(polygon2, count2, first, batch);
+        glm::vec2 previous1 = polygon1[count1 - 1];
+        for (std::size_t i = 0; i < count1; i++)
+        {
+            if (kernel(previous1, polygon1[i], batch))
+            {
+                return true;
+            }
+            previous1 = polygon1[i];
+        }
+    }
+    return false;
+}
\ No newline at end of file
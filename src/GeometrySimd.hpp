@@ -0,0 +1,55 @@
+#ifndef GEOMETRY_SIMD_HPP
+#define GEOMETRY_SIMD_HPP
+
+#include <glm/vec2.hpp>
+
+#include <cstddef>
+
+/**
+* Batched kernels testing one line segment against several polygon edges at once.
+* Every kernel gives the same results as geom::segmentsIntersect, including the truncation
+* of orientation values to integers, so all paths are interchangeable.
+* The path is selected at runtime by the features of the CPU.
+*/
+namespace geom
+{
+    namespace simd
+    {
+        // Implementation of the kernels.
+        enum class Path { Scalar, Sse, Avx };
+
+        // Edges of a polygon in structure of arrays layout.
+        struct EdgeBatch
+        {
+            static const std::size_t CAPACITY = 8;
+
+            alignas(32) float startX[CAPACITY];
+            alignas(32) float startY[CAPACITY];
+            alignas(32) float endX[CAPACITY];
+            alignas(32) float endY[CAPACITY];
+            std::size_t count;
+        };
+
+        // Kernel checking if segment 'pq' intersects any edge in the batch.
+        using SegmentKernel = bool (*)(glm::vec2 p, glm::vec2 q, const EdgeBatch& batch);
+
+        // Load at most EdgeBatch::CAPACITY edges of polygon starting with the given edge.
+        // Edge i goes from point i - 1 to point i, as in geom::polygonsIntersect.
+        void loadEdges(const glm::vec2* polygon, std::size_t count, std::size_t first, EdgeBatch& batch);
+
+        // Get the fastest path supported by the CPU.
+        Path getBestPath();
+
+        // Get the kernel of the given path. Returns the scalar kernel if the path is not available on this platform.
+        SegmentKernel getKernel(Path path);
+
+        // Get the name of a path.
+        const char* getPathName(Path path);
+
+        // Check if polygons intersect by testing edges of the first polygon against batches of edges of the second one.
+        bool polygonsIntersect(const glm::vec2* polygon1, std::size_t count1,
+            const glm::vec2* polygon2, std::size_t count2, SegmentKernel kernel);
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "GpuTimer.hpp"
+
+#include "Debug.hpp"
+
+GpuTimer::GpuTimer(std::size_t queryCount)
+    : m_queries(queryCount), m_oldest(0), m_pendingCount(0), m_measuring(false)
+{
+    if (queryCount == 0)
+    {
+        throw std::logic_error("GPU timer requires at least one query.");
+    }
+    for (auto&& query : m_queries)
+    {
+        GL_CALL(glGenQueries(1, &query.id));
+        query.tag = 0.0f;
+    }
+}
+
+GpuTimer::~GpuTimer()
+{
+    // Errors are not checked, destructors must not throw
+    for (auto&& query : m_queries)
+    {
+        glDeleteQueries(1, &query.id);
+    }
+}
+
+void GpuTimer::begin(float tag)
+{
+    if (m_measuring)
+    {
+        throw std::logic_error("GPU timer is already measuring.");
+    }
+    if (m_pendingCount == m_queries.size())
+    {
+        return;
+    }
+    Query& query = m_queries[(m_oldest + m_pendingCount) % m_queries.size()];
+    query.tag = tag;
+    GL_CALL(glBeginQuery(GL_TIME_ELAPSED, query.id));
+    m_measuring = true;
+}
+
+void GpuTimer::end()
+{
+    if (!m_measuring)
+    {
+        return;
+    }
+    GL_CALL(glEndQuery(GL_TIME_ELAPSED));
+    m_measuring = false;
+    ++m_pendingCount;
+}
+
+bool GpuTimer::poll(Result& result)
+{
+    if (m_pendingCount == 0)
+    {
+        return false;
+    }
+    const Query& query = m_queries[m_oldest];
+    GLint available = GL_FALSE;
+    GL_CALL(glGetQueryObjectiv(query.id, GL_QUERY_RESULT_AVAILABLE, &available));
+    if (available == GL_FALSE)
+    {
+        return false;
+    }
+    GLuint64 nanoseconds = 0;
+    GL_CALL(glGetQueryObjectui64v(query.id, GL_QUERY_RESULT, &nanoseconds));
+    result.time = static_cast<double>(nanoseconds) * 1e-9;
+    result.tag = query.tag;
+    m_oldest = (m_oldest + 1) % m_queries.size();
+    --m_pendingCount;
+    return true;
+}
\ No newline at end of file
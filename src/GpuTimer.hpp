@@ -0,0 +1,54 @@
+#ifndef GPU_TIMER_HPP
+#define GPU_TIMER_HPP
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <vector>
+
+/**
+* Measures time the GPU spends on commands between begin and end with GL_TIME_ELAPSED queries.
+* Results become available a few frames later, queries are kept in a ring and only polled, so reading
+* them never waits for the GPU. If all queries are still pending, the measurement of a frame is skipped.
+* Only one timer can measure at a time. Requires a current OpenGL 3.3 context for its whole lifetime.
+*/
+class GpuTimer final
+{
+public:
+    // Measured time with the value given to begin.
+    struct Result
+    {
+        double time;        // Seconds
+        float tag;
+    };
+
+    explicit GpuTimer(std::size_t queryCount = 4);
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    ~GpuTimer();
+
+    // Start measuring commands issued from now, the tag is returned with the result.
+    void begin(float tag);
+
+    // Stop measuring started by the last begin.
+    void end();
+
+    // Get the oldest finished measurement. Returns false if none has finished yet.
+    bool poll(Result& result);
+
+private:
+    struct Query
+    {
+        GLuint id;
+        float tag;
+    };
+
+    std::vector<Query> m_queries;
+    std::size_t m_oldest;       // Index of the oldest pending query
+    std::size_t m_pendingCount;
+    bool m_measuring;           // Set between begin and end if a query was free
+};
+
+#endif
\ No newline at end of file
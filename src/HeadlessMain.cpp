@@ -0,0 +1,390 @@
+#include "Simulation.hpp"
+#include "InputState.hpp"
+#include "Replay.hpp"
+#include "RewindBuffer.hpp"
+#include "RollbackSession.hpp"
+#include "Transport.hpp"
+#include "Clock.hpp"
+#include "Timer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // Options of the headless run.
+    struct Options
+    {
+        Tick ticks = 60 * 60 * 60;  // One hour of the game
+        bool ticksSet = false;      // Replays are played to the end unless the number of ticks is given
+        unsigned int seed = 1;
+        unsigned int worldScale = 1;    // Number of views along each side of the world
+        std::string recordPath;     // Empty if the run is not recorded
+        std::string replayPath;     // Empty if the scripted controls are used
+        Tick seekTick = 0;
+        bool seek = false;          // Only seek in the replay instead of playing it
+        Tick rewindTicks = 0;       // Number of ticks to step back at the end of the run
+        std::size_t rollbackTicks = 0;  // Budget of rollback sessions of two peers, zero if the peers are not run
+        LinkConditions link;        // Link between the peers
+    };
+
+    // Read options from command line, returns false if they are not valid.
+    bool parseArguments(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string argument = argv[i];
+            if (i + 1 == argc)
+            {
+                return false;
+            }
+            try
+            {
+                if (argument == "--ticks")
+                {
+                    options.ticks = std::stoull(argv[++i]);
+                    options.ticksSet = true;
+                }
+                else if (argument == "--seed")
+                {
+                    options.seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+                }
+                else if (argument == "--world-scale")
+                {
+                    options.worldScale = static_cast<unsigned int>(std::stoul(argv[++i]));
+                }
+                else if (argument == "--record")
+                {
+                    options.recordPath = argv[++i];
+                }
+                else if (argument == "--replay")
+                {
+                    options.replayPath = argv[++i];
+                }
+                else if (argument == "--rewind")
+                {
+                    options.rewindTicks = std::stoull(argv[++i]);
+                }
+                else if (argument == "--rollback")
+                {
+                    options.rollbackTicks = std::stoul(argv[++i]);
+                }
+                else if (argument == "--latency")
+                {
+                    options.link.latency = std::stod(argv[++i]) / 1000.0;
+                }
+                else if (argument == "--jitter")
+                {
+                    options.link.jitter = std::stod(argv[++i]) / 1000.0;
+                }
+                else if (argument == "--loss")
+                {
+                    options.link.loss = std::stod(argv[++i]) / 100.0;
+                }
+                else if (argument == "--seek")
+                {
+                    options.seekTick = std::stoull(argv[++i]);
+                    options.seek = true;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            catch (const std::logic_error&)
+            {
+                return false;
+            }
+        }
+        // Replays and rollback sessions do not store the size of the world, they run in worlds of one view
+        bool defaultWorld = options.worldScale == 1;
+        return (!options.seek || !options.replayPath.empty()) && options.worldScale > 0
+            && (defaultWorld || (options.recordPath.empty() && options.replayPath.empty() && options.rollbackTicks == 0));
+    }
+
+    // Step back by the given number of ticks and print how long it took and how much memory the buffer used.
+    void rewind(Simulation& simulation, RewindBuffer& buffer, Tick ticks)
+    {
+        std::size_t memoryUsage = buffer.getMemoryUsage();
+        auto start = std::chrono::steady_clock::now();
+        Tick rewound = 0;
+        for (; rewound < ticks && buffer.stepBack(); rewound++)
+        {
+            simulation.loadState(buffer.getState().data(), buffer.getState().size());
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Rewound " << rewound << " ticks to tick " << simulation.getTick() << " in " << elapsed.count() << " s"
+            << ", per tick: " << (rewound > 0 ? elapsed.count() / rewound * 1e6 : 0.0) << " us"
+            << ", buffer memory: " << memoryUsage << " B" << std::endl;
+    }
+
+    // Controls of a player that keeps turning, shooting and now and then moves forward.
+    InputState getScriptedInput(Tick tick)
+    {
+        InputState input(InputState::BUTTON_SHOOT);
+        Tick phase = tick % 240;
+        if (phase < 100)
+        {
+            input.press(InputState::BUTTON_RIGHT);
+        }
+        else if (phase < 160)
+        {
+            input.press(InputState::BUTTON_LEFT);
+        }
+        else if (phase < 180)
+        {
+            input.press(InputState::BUTTON_FORWARD);
+        }
+        return input;
+    }
+
+    // Add bits of the value to FNV-1a hash.
+    template<typename T>
+    void hashValue(std::uint64_t& hash, const T& value)
+    {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (unsigned char byte : bytes)
+        {
+            hash = (hash ^ byte) * 0x100000001B3ull;
+        }
+    }
+
+    void hashObject(std::uint64_t& hash, const GameObject& object)
+    {
+        hashValue(hash, object.position.x);
+        hashValue(hash, object.position.y);
+        hashValue(hash, object.rotation);
+    }
+
+    // Get hash of the state of the simulation, equal runs give equal hashes.
+    std::uint64_t getChecksum(const Simulation& simulation);
+
+    // Jump to the tick of the replay using its keyframes and print the state reached.
+    void seekInReplay(const Options& options)
+    {
+        ReplayReader reader(options.replayPath);
+        Simulation simulation(reader.getSeed());
+        auto start = std::chrono::steady_clock::now();
+        Tick tick = reader.seek(simulation, options.seekTick);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Seeked to tick " << tick << " of " << reader.getTickCount()
+            << " using " << reader.getKeyframeCount() << " keyframes in " << elapsed.count() << " s" << std::endl;
+        std::cout << "Checksum: " << std::hex << getChecksum(simulation) << std::dec << std::endl;
+    }
+
+    // Controls of the second peer of a rollback session, it only shoots in bursts.
+    InputState getSecondPeerInput(Tick tick)
+    {
+        return (tick / 20) % 3 != 0 ? InputState(InputState::BUTTON_SHOOT) : InputState();
+    }
+
+    // Controls of the first peer, it only moves.
+    InputState getFirstPeerInput(Tick tick)
+    {
+        const unsigned char movement = InputState::BUTTON_LEFT | InputState::BUTTON_RIGHT | InputState::BUTTON_FORWARD;
+        return InputState(getScriptedInput(tick).buttons & movement);
+    }
+
+    void printRollbackStats(const char* name, const RollbackSession& session, const LoopbackTransport& transport)
+    {
+        const RollbackSession::Stats& stats = session.getStats();
+        std::cout << name << ": rollbacks: " << stats.rollbacks << ", resimulated ticks: " << stats.resimulatedTicks
+            << ", longest rollback: " << stats.maxRollbackTicks << " ticks"
+            << ", slowest rollback: " << stats.maxRollbackTime * 1000.0 << " ms"
+            << ", average rollback: " << (stats.rollbacks > 0 ? stats.rollbackTime / stats.rollbacks * 1000.0 : 0.0) << " ms"
+            << ", stalls: " << stats.stalls << ", packets sent: " << transport.getSentCount()
+            << ", lost: " << transport.getLostCount() << std::endl;
+    }
+
+    // Run two peers connected by a simulated link and check that both end in the state of a simulation
+    // given the merged inputs of both peers.
+    bool runRollback(const Options& options)
+    {
+        auto clock = std::make_shared<ManualClock>();
+        auto transports = LoopbackTransport::createPair(clock, options.link, options.seed);
+        Simulation simulation1(options.seed);
+        Simulation simulation2(options.seed);
+        RollbackSession session1(simulation1, *transports.first, options.rollbackTicks);
+        RollbackSession session2(simulation2, *transports.second, options.rollbackTicks);
+        auto start = std::chrono::steady_clock::now();
+        // Both peers try to advance once per frame, then they wait until all inputs are confirmed
+        Tick frames = 0;
+        while (session1.getConfirmedTick() < options.ticks || session2.getConfirmedTick() < options.ticks)
+        {
+            if (session1.getTick() < options.ticks)
+            {
+                session1.advance(getFirstPeerInput(session1.getTick()));
+            }
+            else
+            {
+                session1.poll();
+            }
+            if (session2.getTick() < options.ticks)
+            {
+                session2.advance(getSecondPeerInput(session2.getTick()));
+            }
+            else
+            {
+                session2.poll();
+            }
+            clock->advance(simulation1.getUpdateInterval());
+            ++frames;
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        Simulation reference(options.seed);
+        for (Tick tick = 0; tick < options.ticks; tick++)
+        {
+            reference.step(InputState(getFirstPeerInput(tick).buttons | getSecondPeerInput(tick).buttons));
+        }
+        std::cout << "Ticks: " << options.ticks << ", frames: " << frames << ", real time: " << elapsed.count() << " s" << std::endl;
+        printRollbackStats("Peer 1", session1, *transports.first);
+        printRollbackStats("Peer 2", session2, *transports.second);
+        std::uint64_t checksum = getChecksum(reference);
+        std::cout << "Checksums: " << std::hex << getChecksum(simulation1) << ", " << getChecksum(simulation2)
+            << ", reference: " << checksum << std::dec << std::endl;
+        return getChecksum(simulation1) == checksum && getChecksum(simulation2) == checksum;
+    }
+
+    // Get hash of the state of the simulation, equal runs give equal hashes.
+    std::uint64_t getChecksum(const Simulation& simulation)
+    {
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+        hashValue(hash, simulation.getTick());
+        hashValue(hash, simulation.getLevel());
+        hashObject(hash, simulation.getPlayer());
+        for (const auto& asteroid : simulation.getAsteroids())
+        {
+            hashObject(hash, asteroid);
+        }
+        for (const auto& bullet : simulation.getBullets())
+        {
+            hashObject(hash, bullet);
+        }
+        for (const auto& remnant : simulation.getRemnants())
+        {
+            hashObject(hash, remnant);
+        }
+        return hash;
+    }
+}
+
+/**
+* Entry point of the headless simulation.
+* Steps the simulation as fast as possible without a window or OpenGL context and prints how fast it ran.
+* Controls are scripted, or read from a replay given by '--replay <file>'. '--world-scale <views>' runs the scripted
+* controls in a world of the given number of views along each side. The run can be recorded by '--record <file>'.
+* With '--seek <tick>' the replay is not played, the simulation jumps to the tick using keyframes of the replay.
+* '--rewind <ticks>' keeps recent states in a rewind buffer and steps back by the given number of ticks at the end.
+* '--rollback <ticks>' runs two peers in rollback sessions with the given budget over a link with '--latency <ms>',
+* '--jitter <ms>' and '--loss <percent>', and checks that both end in the same state.
+*/
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseArguments(argc, argv, options))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--ticks <count>] [--seed <seed>] [--world-scale <views>] [--record <file>] [--replay <file> [--seek <tick>]] [--rewind <ticks>]"
+            << " [--rollback <ticks> [--latency <ms>] [--jitter <ms>] [--loss <percent>]]" << std::endl;
+        return -1;
+    }
+    try
+    {
+        if (options.seek)
+        {
+            seekInReplay(options);
+            return 0;
+        }
+        if (options.rollbackTicks > 0)
+        {
+            return runRollback(options) ? 0 : -2;
+        }
+        std::unique_ptr<Replay> replay;
+        std::unique_ptr<Replay::Cursor> cursor;
+        if (!options.replayPath.empty())
+        {
+            replay = std::make_unique<Replay>(Replay::load(options.replayPath));
+            cursor = std::make_unique<Replay::Cursor>(*replay);
+            options.seed = replay->getSeed();
+            options.ticks = options.ticksSet ? std::min(options.ticks, replay->getTickCount()) : replay->getTickCount();
+        }
+        Replay recording(options.seed);
+        Simulation simulation(options.seed, options.worldScale);
+        std::unique_ptr<RewindBuffer> rewindBuffer;
+        if (options.rewindTicks > 0)
+        {
+            rewindBuffer = std::make_unique<RewindBuffer>(static_cast<std::size_t>(options.rewindTicks),
+                std::numeric_limits<std::size_t>::max());
+            rewindBuffer->push(simulation.saveState());
+        }
+        std::size_t gamesOver = 0;
+        std::size_t maxLevel = simulation.getLevel();
+        Tick ticks = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (; ticks < options.ticks; ticks++)
+        {
+            InputState input = getScriptedInput(ticks);
+            if (cursor && !cursor->next(input))
+            {
+                break;
+            }
+            if (!options.recordPath.empty())
+            {
+                if (recording.needsKeyframe())
+                {
+                    recording.addKeyframe(simulation.saveState());
+                }
+                recording.record(input);
+            }
+            if (input.isPressed(InputState::BUTTON_QUIT))
+            {
+                break;
+            }
+            Simulation::State previousState = simulation.getState();
+            simulation.step(input);
+            if (simulation.getState() == Simulation::State::Over && previousState != Simulation::State::Over)
+            {
+                ++gamesOver;
+            }
+            maxLevel = std::max(maxLevel, simulation.getLevel());
+            if (rewindBuffer)
+            {
+                rewindBuffer->push(simulation.saveState());
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (!options.recordPath.empty())
+        {
+            recording.save(options.recordPath);
+        }
+        std::cout << "Ticks: " << ticks << ", simulated time: " << ticks * simulation.getUpdateInterval() << " s"
+            << ", real time: " << elapsed.count() << " s"
+            << ", ticks per second: " << ticks / elapsed.count() << std::endl;
+        std::cout << "Games over: " << gamesOver << ", highest level: " << maxLevel
+            << ", asteroids: " << simulation.getAsteroids().size() << std::endl;
+        if (rewindBuffer)
+        {
+            rewind(simulation, *rewindBuffer, options.rewindTicks);
+        }
+        std::cout << "Checksum: " << std::hex << getChecksum(simulation) << std::dec << std::endl;
+        std::cout << "Collisions: " << simulation.getCollisionStats() << std::endl;
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cerr << "Runtime error:" << std::endl << e.what() << std::endl;
+        return -3;
+    }
+    catch (const std::logic_error& e)
+    {
+        std::cerr << "Logic error:" << std::endl << e.what() << std::endl;
+        return -4;
+    }
+    return 0;
+}
\ No newline at end of file
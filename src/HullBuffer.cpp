@@ -0,0 +1,135 @@
+#include "HullBuffer.hpp"
+
+#include <glm/trigonometric.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <limits>
+
+HullBuffer::HullBuffer() : m_partOffsets{ 0 }, m_firstParts{ 0 }
+{
+}
+
+void HullBuffer::clear()
+{
+    m_partPoints.clear();
+    m_partNormals.clear();
+    m_partOffsets.resize(1);
+    m_firstParts.resize(1);
+}
+
+std::size_t HullBuffer::add(const Shape& shape, glm::vec2 center, float rotation)
+{
+    float cos = glm::cos(glm::radians(rotation));
+    float sin = glm::sin(glm::radians(rotation));
+    auto rotate = [cos, sin](glm::vec2 vector)
+    {
+        return glm::vec2(cos * vector.x - sin * vector.y, sin * vector.x + cos * vector.y);
+    };
+    for (const auto& part : shape.getParts())
+    {
+        for (std::size_t i = 0; i < part.vertices.size(); i++)
+        {
+            m_partPoints.push_back(center + rotate(part.vertices[i]));
+            m_partNormals.push_back(rotate(part.normals[i]));
+        }
+        m_partOffsets.push_back(m_partPoints.size());
+    }
+    m_firstParts.push_back(m_partOffsets.size() - 1);
+    return m_firstParts.size() - 2;
+}
+
+std::size_t HullBuffer::getPartCount(std::size_t index) const
+{
+    return m_firstParts[index + 1] - m_firstParts[index];
+}
+
+geom::ConvexPolygon HullBuffer::getPart(std::size_t index, std::size_t part) const
+{
+    std::size_t partIndex = m_firstParts[index] + part;
+    std::size_t offset = m_partOffsets[partIndex];
+    return geom::ConvexPolygon{
+        m_partPoints.data() + offset,
+        m_partNormals.data() + offset,
+        m_partOffsets[partIndex + 1] - offset
+    };
+}
+
+std::size_t HullBuffer::size() const
+{
+    return m_firstParts.size() - 1;
+}
+
+bool HullBuffer::intersect(std::size_t index1, std::size_t index2) const
+{
+    glm::vec2 partTranslation;
+    for (std::size_t i = 0; i < getPartCount(index1); i++)
+    {
+        geom::ConvexPolygon part1 = getPart(index1, i);
+        for (std::size_t j = 0; j < getPartCount(index2); j++)
+        {
+            if (geom::convexPolygonsIntersect(part1, getPart(index2, j), partTranslation))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool HullBuffer::intersect(std::size_t index1, std::size_t index2, glm::vec2& translation) const
+{
+    if (!intersect(index1, index2))
+    {
+        return false;
+    }
+    // Moving the first hull along an axis until its projection leaves the projection of the second hull
+    // separates every pair of parts, the shortest of these moves is chosen
+    float minDistance = std::numeric_limits<float>::max();
+    for (std::size_t index : { index1, index2 })
+    {
+        std::size_t begin = m_partOffsets[m_firstParts[index]];
+        std::size_t end = m_partOffsets[m_firstParts[index + 1]];
+        for (std::size_t i = begin; i < end; i++)
+        {
+            glm::vec2 axis = m_partNormals[i];
+            float min1, max1, min2, max2;
+            project(index1, axis, min1, max1);
+            project(index2, axis, min2, max2);
+            float backward = max1 - min2;
+            float forward = max2 - min1;
+            float distance = std::min(backward, forward);
+            if (distance < minDistance)
+            {
+                minDistance = distance;
+                translation = (backward <= forward) ? -backward * axis : forward * axis;
+            }
+        }
+    }
+    return true;
+}
+
+void HullBuffer::project(std::size_t index, glm::vec2 axis, float& min, float& max) const
+{
+    std::size_t begin = m_partOffsets[m_firstParts[index]];
+    std::size_t end = m_partOffsets[m_firstParts[index + 1]];
+    min = max = glm::dot(m_partPoints[begin], axis);
+    for (std::size_t i = begin + 1; i < end; i++)
+    {
+        float projection = glm::dot(m_partPoints[i], axis);
+        min = std::min(min, projection);
+        max = std::max(max, projection);
+    }
+}
+
+bool HullBuffer::intersectSegment(std::size_t index, glm::vec2 p, glm::vec2 q) const
+{
+    for (std::size_t i = 0; i < getPartCount(index); i++)
+    {
+        if (geom::segmentIntersectsConvexPolygon(p, q, getPart(index, i)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef HULL_BUFFER_HPP
+#define HULL_BUFFER_HPP
+
+#include "Shape.hpp"
+#include "Geometry.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <vector>
+#include <cstddef>
+
+/**
+* Contiguous buffer of polygons in world coordinates.
+* Hulls of all objects are transformed once per update and then read by every collision query,
+* so the cost of transformations grows with the number of objects instead of the number of tested pairs.
+* Each hull consists of the convex parts of the shape with rotated edge normals, the outline is not needed
+* by the separating axis test and is not stored.
+*/
+class HullBuffer final
+{
+public:
+    HullBuffer();
+
+    // Remove all hulls. Allocated memory is kept for the next update.
+    void clear();
+
+    // Transform convex parts of the shape by rotation around the center and translation, and append them.
+    // Returns index of the added hull.
+    std::size_t add(const Shape& shape, glm::vec2 center, float rotation);
+
+    // Get number of convex parts of the hull with the given index.
+    std::size_t getPartCount(std::size_t index) const;
+
+    // Get a convex part of the hull with the given index.
+    geom::ConvexPolygon getPart(std::size_t index, std::size_t part) const;
+
+    // Get number of hulls.
+    std::size_t size() const;
+
+    // Check if convex parts of two hulls intersect using the separating axis theorem.
+    bool intersect(std::size_t index1, std::size_t index2) const;
+
+    // Same as above, if the hulls intersect, translation is set to the shortest vector along an edge normal
+    // of their parts that moves the whole first hull out of the second one. For convex hulls it is the minimum
+    // translation vector, for concave ones it can be longer than a move into a concavity, but it separates all parts.
+    bool intersect(std::size_t index1, std::size_t index2, glm::vec2& translation) const;
+
+    // Check if line segment 'pq' intersects a convex part of the hull with the given index.
+    bool intersectSegment(std::size_t index, glm::vec2 p, glm::vec2 q) const;
+
+private:
+    // Project all points of the hull on axis and return the interval.
+    void project(std::size_t index, glm::vec2 axis, float& min, float& max) const;
+
+    std::vector<glm::vec2> m_partPoints;
+    std::vector<glm::vec2> m_partNormals;   // Normals of edges, same indices as m_partPoints
+    std::vector<std::size_t> m_partOffsets; // Offsets of parts in m_partPoints, the last one is the end of the buffer
+    std::vector<std::size_t> m_firstParts;  // Index of the first part of each hull, the last one is the part count
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include "InputState.hpp"
+
+InputState::InputState() : buttons(0)
+{
+}
+
+InputState::InputState(unsigned char buttons) : buttons(buttons)
+{
+}
+
+bool InputState::isPressed(Button button) const
+{
+    return (buttons & button) != 0;
+}
+
+void InputState::press(Button button)
+{
+    buttons |= button;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef INPUT_STATE_HPP
+#define INPUT_STATE_HPP
+
+/**
+* State of the controls of the player during one update.
+* Buttons are stored as bits, so the state is cheap to copy, record and compare.
+*/
+struct InputState final
+{
+    enum Button : unsigned char
+    {
+        BUTTON_LEFT = 1 << 0,       // Turn counterclockwise
+        BUTTON_RIGHT = 1 << 1,      // Turn clockwise
+        BUTTON_FORWARD = 1 << 2,    // Move forward
+        BUTTON_SHOOT = 1 << 3,
+        BUTTON_QUIT = 1 << 4        // Leave the game, ignored by the simulation
+    };
+
+    unsigned char buttons;  // Pressed buttons as a combination of Button values
+
+    InputState();
+    explicit InputState(unsigned char buttons);
+
+    // Check if the button is pressed.
+    bool isPressed(Button button) const;
+
+    // Mark the button as pressed.
+    void press(Button button);
+};
+
+#endif
\ No newline at end of file
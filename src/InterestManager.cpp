@@ -0,0 +1,178 @@
+#include "InterestManager.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    // Entries of the grid store the type of the object in the highest bits and its index in the others
+    const unsigned int TYPE_SHIFT = 30;
+    const SpatialGrid::Entry INDEX_MASK = (SpatialGrid::Entry(1) << TYPE_SHIFT) - 1;
+
+    glm::vec2 getCenter(const GameObject& object)
+    {
+        return object.position + object.size * 0.5f;
+    }
+}
+
+InterestManager::InterestManager(float radius, std::size_t maxUpdates) : m_radius(radius), m_maxUpdates(maxUpdates), m_updatedCount(0)
+{
+    if (radius <= 0.0f || maxUpdates == 0)
+    {
+        throw std::logic_error("Interest manager requires a positive radius and number of updates.");
+    }
+}
+
+const Snapshot& InterestManager::update(const Simulation& simulation)
+{
+    buildGrid(simulation);
+    const Player& player = simulation.getPlayer();
+    findCandidates(simulation, getCenter(player));
+    // Merge the candidates with the current view, both are ordered the same way
+    m_entities.clear();
+    m_entityPriorities.clear();
+    m_entityInView.clear();
+    m_contenders.clear();
+    std::size_t viewIndex = 0;
+    for (const auto& candidate : m_candidates)
+    {
+        const Snapshot::Entity& entity = candidate.entity;
+        while (viewIndex < m_view.entities.size() && Snapshot::isBefore(m_view.entities[viewIndex], entity))
+        {
+            ++viewIndex;    // Destroyed or too far, removed from the view
+        }
+        bool inView = viewIndex < m_view.entities.size() && !Snapshot::isBefore(entity, m_view.entities[viewIndex]);
+        if (!inView && candidate.distance > m_radius)
+        {
+            continue;
+        }
+        float priority = inView ? m_priorities[viewIndex] : ENTER_PRIORITY;
+        const Snapshot::Entity& previous = inView ? m_view.entities[viewIndex] : entity;
+        bool changed = !inView || previous.x != entity.x || previous.y != entity.y || previous.rotation != entity.rotation
+            || previous.velocityX != entity.velocityX || previous.velocityY != entity.velocityY;
+        if (changed)
+        {
+            // The ship of the client is always updated
+            priority = entity.type == Snapshot::ENTITY_PLAYER ? std::numeric_limits<float>::max() : priority + getPriority(candidate.distance);
+            m_contenders.push_back(m_entities.size());
+        }
+        m_entities.push_back(previous);
+        m_entityPriorities.push_back(priority);
+        m_entityInView.push_back(inView);
+    }
+    // Update the changed entities with the highest priorities
+    auto byPriority = [this](std::size_t index1, std::size_t index2) { return m_entityPriorities[index1] > m_entityPriorities[index2]; };
+    if (m_contenders.size() > m_maxUpdates)
+    {
+        std::nth_element(m_contenders.begin(), m_contenders.begin() + m_maxUpdates, m_contenders.end(), byPriority);
+    }
+    m_updatedCount = std::min(m_contenders.size(), m_maxUpdates);
+    m_entityUpdated.assign(m_entities.size(), false);
+    for (std::size_t i = 0; i < m_updatedCount; i++)
+    {
+        m_entityUpdated[m_contenders[i]] = true;
+    }
+    // Build the new view, new entities that were not updated do not enter it yet
+    m_view.tick = simulation.getTick();
+    m_view.level = static_cast<std::uint32_t>(simulation.getLevel());
+    m_view.state = static_cast<unsigned char>(simulation.getState());
+    m_view.entities.clear();
+    m_priorities.clear();
+    std::size_t candidateIndex = 0;
+    for (std::size_t i = 0; i < m_entities.size(); i++)
+    {
+        while (Snapshot::isBefore(m_candidates[candidateIndex].entity, m_entities[i]))
+        {
+            ++candidateIndex;
+        }
+        if (m_entityUpdated[i])
+        {
+            m_view.entities.push_back(m_candidates[candidateIndex].entity);
+            m_priorities.push_back(0.0f);
+        }
+        else if (m_entityInView[i])
+        {
+            m_view.entities.push_back(m_entities[i]);
+            m_priorities.push_back(m_entityPriorities[i]);
+        }
+    }
+    return m_view;
+}
+
+const Snapshot& InterestManager::getView() const
+{
+    return m_view;
+}
+
+std::size_t InterestManager::getUpdatedCount() const
+{
+    return m_updatedCount;
+}
+
+void InterestManager::buildGrid(const Simulation& simulation)
+{
+    m_grid.reset(simulation.getWorldSize(), m_radius * CELL_SIZE_FACTOR);
+    const auto& asteroids = simulation.getAsteroids();
+    for (std::size_t i = 0; i < asteroids.size(); i++)
+    {
+        m_grid.add(getCenter(asteroids[i]), (SpatialGrid::Entry(Snapshot::ENTITY_ASTEROID) << TYPE_SHIFT) | static_cast<SpatialGrid::Entry>(i));
+    }
+    const auto& bullets = simulation.getBullets();
+    for (std::size_t i = 0; i < bullets.size(); i++)
+    {
+        m_grid.add(getCenter(bullets[i]), (SpatialGrid::Entry(Snapshot::ENTITY_BULLET) << TYPE_SHIFT) | static_cast<SpatialGrid::Entry>(i));
+    }
+    const auto& remnants = simulation.getRemnants();
+    for (std::size_t i = 0; i < remnants.size(); i++)
+    {
+        m_grid.add(getCenter(remnants[i]), (SpatialGrid::Entry(Snapshot::ENTITY_REMNANT) << TYPE_SHIFT) | static_cast<SpatialGrid::Entry>(i));
+    }
+    m_grid.build();
+}
+
+void InterestManager::findCandidates(const Simulation& simulation, glm::vec2 center)
+{
+    m_candidates.clear();
+    m_candidates.push_back(Candidate{ Snapshot::quantize(simulation.getPlayer(), Snapshot::ENTITY_PLAYER, simulation.getPlayer().velocity), 0.0f });
+    float keepRadius = m_radius * KEEP_RADIUS_FACTOR;
+    m_grid.query(center, keepRadius, [this, &simulation, center, keepRadius](SpatialGrid::Entry entry)
+        {
+            std::size_t index = entry & INDEX_MASK;
+            auto type = static_cast<Snapshot::EntityType>(entry >> TYPE_SHIFT);
+            const GameObject* object;
+            glm::vec2 velocity;
+            if (type == Snapshot::ENTITY_ASTEROID)
+            {
+                object = &simulation.getAsteroids()[index];
+                velocity = simulation.getAsteroids()[index].velocity;
+            }
+            else if (type == Snapshot::ENTITY_BULLET)
+            {
+                object = &simulation.getBullets()[index];
+                velocity = simulation.getBullets()[index].velocity;
+            }
+            else
+            {
+                object = &simulation.getRemnants()[index];
+                velocity = simulation.getRemnants()[index].velocity;
+            }
+            glm::vec2 offset = m_grid.getOffset(center, getCenter(*object));
+            float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+            if (distance <= keepRadius)
+            {
+                m_candidates.push_back(Candidate{ Snapshot::quantize(*object, type, velocity), distance });
+            }
+        });
+    // Cells are visited in order of positions, the view is ordered by types and identifiers
+    std::sort(m_candidates.begin(), m_candidates.end(),
+        [](const Candidate& candidate1, const Candidate& candidate2) { return Snapshot::isBefore(candidate1.entity, candidate2.entity); });
+}
+
+float InterestManager::getPriority(float distance) const
+{
+    // One next to the ship, a fifth at the radius
+    return 1.0f / (1.0f + 4.0f * distance / m_radius);
+}
\ No newline at end of file
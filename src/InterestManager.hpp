@@ -0,0 +1,67 @@
+#ifndef INTEREST_MANAGER_HPP
+#define INTEREST_MANAGER_HPP
+
+#include "Simulation.hpp"
+#include "Snapshot.hpp"
+#include "SpatialGrid.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <cstddef>
+#include <vector>
+
+/**
+* Chooses what one client knows about its game: the view, a snapshot of objects near its ship.
+* Objects are found by a spatial grid around the ship, so the work and the size of the view do not grow with
+* the number of objects in the world. Every changed object in the view gains priority each update, more if it
+* is closer to the ship, and only the objects with the highest accumulated priority are updated in the view,
+* the others keep their last sent state. Objects entering the view are preferred.
+*/
+class InterestManager final
+{
+public:
+    // Create the manager for objects within the radius from the ship, updating at most the given number of them per update.
+    InterestManager(float radius, std::size_t maxUpdates);
+
+    // Update the view by the current state of the simulation and return it.
+    const Snapshot& update(const Simulation& simulation);
+
+    const Snapshot& getView() const;
+
+    // Get number of objects updated in the view by the last update.
+    std::size_t getUpdatedCount() const;
+
+private:
+    // Size of cells of the grid relative to the radius
+    const float CELL_SIZE_FACTOR = 0.5f;
+    // Objects in the view are kept until they are this many times farther than the radius, so they do not flicker at its edge
+    const float KEEP_RADIUS_FACTOR = 1.25f;
+    // Priority added to objects entering the view
+    const float ENTER_PRIORITY = 10.0f;
+
+    // Object near the ship
+    struct Candidate
+    {
+        Snapshot::Entity entity;
+        float distance;
+    };
+
+    float m_radius;
+    std::size_t m_maxUpdates;
+    SpatialGrid m_grid;
+    Snapshot m_view;
+    std::vector<float> m_priorities;            // Accumulated priorities of entities of the view
+    std::vector<Candidate> m_candidates;
+    std::vector<Snapshot::Entity> m_entities;   // Entities of the next view
+    std::vector<float> m_entityPriorities;
+    std::vector<bool> m_entityInView;           // Set if the entity is in the current view
+    std::vector<bool> m_entityUpdated;          // Set if the entity was chosen for an update
+    std::vector<std::size_t> m_contenders;      // Indices of entities competing for an update
+    std::size_t m_updatedCount;
+
+    void buildGrid(const Simulation& simulation);
+    void findCandidates(const Simulation& simulation, glm::vec2 center);
+    float getPriority(float distance) const;
+};
+
+#endif
\ No newline at end of file
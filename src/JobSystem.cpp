@@ -0,0 +1,181 @@
+#include "JobSystem.hpp"
+
+#include <algorithm>
+
+namespace
+{
+    // Pool and queue of the current worker thread, threads outside of any pool have no owner.
+    thread_local const JobSystem* t_owner = nullptr;
+    thread_local std::size_t t_queueIndex = 0;
+}
+
+JobSystem::Group::Group() : m_pending(0)
+{
+}
+
+bool JobSystem::Group::finished() const
+{
+    return m_pending.load(std::memory_order_acquire) == 0;
+}
+
+JobSystem::JobSystem(std::size_t threadCount) : m_running(true), m_queuedCount(0)
+{
+    if (threadCount == 0)
+    {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+    for (std::size_t i = 0; i <= threadCount; i++)
+    {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 0; i < threadCount; i++)
+    {
+        m_threads.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+    m_wakeCondition.notify_all();
+    for (auto&& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void JobSystem::submit(Group& group, Job job)
+{
+    group.m_pending.fetch_add(1, std::memory_order_relaxed);
+    Queue& queue = *m_queues[getQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(Task{ std::move(job), &group });
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        ++m_queuedCount;
+    }
+    m_wakeCondition.notify_one();
+}
+
+void JobSystem::wait(Group& group)
+{
+    std::size_t queueIndex = getQueueIndex();
+    while (!group.finished())
+    {
+        if (!tryRunJob(queueIndex))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t minChunkSize,
+    const std::function<void(std::size_t, std::size_t)>& function)
+{
+    std::size_t maxChunks = 4 * (m_threads.size() + 1);
+    std::size_t chunkCount = std::min(count / std::max<std::size_t>(minChunkSize, 1), maxChunks);
+    if (chunkCount <= 1 || m_threads.empty())
+    {
+        if (count > 0)
+        {
+            function(0, count);
+        }
+        return;
+    }
+    Group group;
+    std::size_t chunkSize = count / chunkCount;
+    std::size_t remainder = count % chunkCount;
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < chunkCount; i++)
+    {
+        std::size_t end = begin + chunkSize + (i < remainder ? 1 : 0);
+        if (i + 1 == chunkCount)
+        {
+            function(begin, end);   // The last chunk runs on the calling thread
+        }
+        else
+        {
+            submit(group, [&function, begin, end]() { function(begin, end); });
+        }
+        begin = end;
+    }
+    wait(group);
+}
+
+std::size_t JobSystem::getThreadCount() const
+{
+    return m_threads.size();
+}
+
+std::size_t JobSystem::getQueueIndex() const
+{
+    return t_owner == this ? t_queueIndex : 0;
+}
+
+bool JobSystem::tryRunJob(std::size_t queueIndex)
+{
+    Task task;
+    if (!tryPop(queueIndex, task) && !trySteal(queueIndex, task))
+    {
+        return false;
+    }
+    m_queuedCount.fetch_sub(1, std::memory_order_relaxed);
+    task.job();
+    task.group->m_pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool JobSystem::tryPop(std::size_t queueIndex, Task& task)
+{
+    Queue& queue = *m_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+    {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool JobSystem::trySteal(std::size_t thiefIndex, Task& task)
+{
+    std::size_t queueCount = m_queues.size();
+    for (std::size_t i = 1; i < queueCount; i++)
+    {
+        Queue& queue = *m_queues[(thiefIndex + i) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::workerLoop(std::size_t queueIndex)
+{
+    t_owner = this;
+    t_queueIndex = queueIndex;
+    while (true)
+    {
+        if (tryRunJob(queueIndex))
+        {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeCondition.wait(lock, [this]() { return !m_running || m_queuedCount > 0; });
+        if (!m_running)
+        {
+            return;
+        }
+    }
+}
\ No newline at end of file
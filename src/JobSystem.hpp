@@ -0,0 +1,95 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+* Thread pool with work stealing.
+* Every worker has its own queue, it takes jobs from its back and steals from the front of other queues
+* when it has nothing to do. Threads waiting for a group of jobs run queued jobs instead of blocking.
+* Jobs must not throw exceptions.
+*/
+class JobSystem final
+{
+public:
+    using Job = std::function<void()>;
+
+    // Counter of unfinished jobs used for waiting.
+    class Group final
+    {
+    public:
+        Group();
+        Group(const Group&) = delete;
+        Group& operator=(const Group&) = delete;
+
+        // Check if all jobs of the group finished.
+        bool finished() const;
+
+    private:
+        std::atomic<std::size_t> m_pending;
+
+        friend class JobSystem;
+    };
+
+    // Create a pool with the given number of worker threads. If it is zero,
+    // one less than the number of hardware threads is used, because the calling thread helps with the work.
+    explicit JobSystem(std::size_t threadCount = 0);
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    ~JobSystem();
+
+    // Queue a job belonging to the group.
+    void submit(Group& group, Job job);
+
+    // Run queued jobs until all jobs of the group finish.
+    void wait(Group& group);
+
+    // Split range [0, count) into chunks of at least minChunkSize elements and call function(begin, end)
+    // for each of them in parallel. Returns after all chunks are done. Small ranges run on the calling thread.
+    void parallelFor(std::size_t count, std::size_t minChunkSize, const std::function<void(std::size_t, std::size_t)>& function);
+
+    // Get number of worker threads (without the calling thread).
+    std::size_t getThreadCount() const;
+
+private:
+    struct Task
+    {
+        Job job;
+        Group* group;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // Queue 0 is shared by threads outside the pool, queue i + 1 belongs to worker i.
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<bool> m_running;
+    std::atomic<std::size_t> m_queuedCount;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeCondition;
+
+    // Get index of the queue owned by the calling thread.
+    std::size_t getQueueIndex() const;
+
+    // Pop a job from the own queue or steal one from another queue and run it. Returns false if there was none.
+    bool tryRunJob(std::size_t queueIndex);
+
+    bool tryPop(std::size_t queueIndex, Task& task);
+    bool trySteal(std::size_t thiefIndex, Task& task);
+    void workerLoop(std::size_t queueIndex);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+* Read-only file mapped to memory.
+* Pages of the file are loaded by the operating system when they are accessed, so opening a large file
+* is cheap and reading a small part of it does not read the rest.
+*/
+class MappedFile final
+{
+public:
+    // Map the whole file. Throws std::runtime_error if the file cannot be opened or mapped.
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile();
+
+    const unsigned char* getData() const;
+    std::size_t getSize() const;
+
+private:
+    const unsigned char* m_data;
+    std::size_t m_size;
+#ifdef _WIN32
+    void* m_file;
+    void* m_mapping;
+#endif
+};
+
+#endif
\ No newline at end of file
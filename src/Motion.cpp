@@ -0,0 +1,144 @@
+#include "Motion.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MOTION_SIMD_X86 1
+#include <emmintrin.h>
+#else
+#define MOTION_SIMD_X86 0
+#endif
+
+namespace
+{
+    const float FULL_ANGLE = 360.0f;
+
+#if MOTION_SIMD_X86
+    const std::size_t LANES = 4;
+
+    // Select lanes of 'a' where mask is set and lanes of 'b' elsewhere.
+    inline __m128 select(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    // Wrap one coordinate of four objects, returns mask of wrapped lanes.
+    inline __m128 wrapCoordinate(float* coordinate, const float* size, __m128 limit)
+    {
+        __m128 value = _mm_loadu_ps(coordinate);
+        __m128 negativeSize = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(size));
+        __m128 before = _mm_cmplt_ps(value, negativeSize);
+        __m128 after = _mm_cmpgt_ps(value, limit);
+        value = select(before, limit, select(after, negativeSize, value));
+        _mm_storeu_ps(coordinate, value);
+        return _mm_or_ps(before, after);
+    }
+#endif
+
+    float clampAngle(float angle)
+    {
+        angle += angle < 0.0f ? FULL_ANGLE : 0.0f;
+        angle -= angle > FULL_ANGLE ? FULL_ANGLE : 0.0f;
+        return angle;
+    }
+
+    bool wrapCoordinate(float& coordinate, float size, float limit)
+    {
+        bool before = coordinate < -size;
+        bool after = coordinate > limit;
+        coordinate = before ? limit : (after ? -size : coordinate);
+        return before || after;
+    }
+}
+
+void motion::Transforms::resize(std::size_t count)
+{
+    x.resize(count);
+    y.resize(count);
+    velocityX.resize(count);
+    velocityY.resize(count);
+    rotation.resize(count);
+    rotationSpeed.resize(count);
+    width.resize(count);
+    height.resize(count);
+    wrapped.resize(count);
+}
+
+void motion::Transforms::set(std::size_t index, glm::vec2 position, glm::vec2 velocity, float rotation,
+    float rotationSpeed, glm::vec2 size)
+{
+    x[index] = position.x;
+    y[index] = position.y;
+    velocityX[index] = velocity.x;
+    velocityY[index] = velocity.y;
+    this->rotation[index] = rotation;
+    this->rotationSpeed[index] = rotationSpeed;
+    width[index] = size.x;
+    height[index] = size.y;
+}
+
+void motion::integrate(Transforms& transforms, std::size_t begin, std::size_t end, float deltaTime)
+{
+    float* x = transforms.x.data();
+    float* y = transforms.y.data();
+    const float* velocityX = transforms.velocityX.data();
+    const float* velocityY = transforms.velocityY.data();
+    float* rotation = transforms.rotation.data();
+    const float* rotationSpeed = transforms.rotationSpeed.data();
+    std::size_t i = begin;
+#if MOTION_SIMD_X86
+    __m128 step = _mm_set1_ps(deltaTime);
+    __m128 zero = _mm_setzero_ps();
+    __m128 fullAngle = _mm_set1_ps(FULL_ANGLE);
+    for (; i + LANES <= end; i += LANES)
+    {
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(velocityX + i), step)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(velocityY + i), step)));
+        __m128 angle = _mm_add_ps(_mm_loadu_ps(rotation + i), _mm_mul_ps(_mm_loadu_ps(rotationSpeed + i), step));
+        angle = _mm_add_ps(angle, _mm_and_ps(_mm_cmplt_ps(angle, zero), fullAngle));
+        angle = _mm_sub_ps(angle, _mm_and_ps(_mm_cmpgt_ps(angle, fullAngle), fullAngle));
+        _mm_storeu_ps(rotation + i, angle);
+    }
+#endif
+    for (; i < end; i++)
+    {
+        x[i] += velocityX[i] * deltaTime;
+        y[i] += velocityY[i] * deltaTime;
+        rotation[i] = clampAngle(rotation[i] + rotationSpeed[i] * deltaTime);
+    }
+}
+
+void motion::wrap(Transforms& transforms, std::size_t begin, std::size_t end, glm::vec2 area)
+{
+    float* x = transforms.x.data();
+    float* y = transforms.y.data();
+    const float* width = transforms.width.data();
+    const float* height = transforms.height.data();
+    unsigned char* wrapped = transforms.wrapped.data();
+    std::size_t i = begin;
+#if MOTION_SIMD_X86
+    __m128 areaWidth = _mm_set1_ps(area.x);
+    __m128 areaHeight = _mm_set1_ps(area.y);
+    for (; i + LANES <= end; i += LANES)
+    {
+        __m128 wrappedX = wrapCoordinate(x + i, width + i, areaWidth);
+        __m128 wrappedY = wrapCoordinate(y + i, height + i, areaHeight);
+        int mask = _mm_movemask_ps(_mm_or_ps(wrappedX, wrappedY));
+        for (std::size_t lane = 0; lane < LANES; lane++)
+        {
+            wrapped[i + lane] = static_cast<unsigned char>((mask >> lane) & 1);
+        }
+    }
+#endif
+    for (; i < end; i++)
+    {
+        bool wrappedX = wrapCoordinate(x[i], width[i], area.x);
+        bool wrappedY = wrapCoordinate(y[i], height[i], area.y);
+        wrapped[i] = wrappedX || wrappedY;
+    }
+}
+
+bool motion::wrap(glm::vec2& position, glm::vec2 size, glm::vec2 area)
+{
+    bool wrappedX = wrapCoordinate(position.x, size.x, area.x);
+    bool wrappedY = wrapCoordinate(position.y, size.y, area.y);
+    return wrappedX || wrappedY;
+}
\ No newline at end of file
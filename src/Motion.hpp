@@ -0,0 +1,49 @@
+#ifndef MOTION_HPP
+#define MOTION_HPP
+
+#include <glm/vec2.hpp>
+
+#include <cstddef>
+#include <vector>
+
+/**
+* Batched kernels moving whole arrays of objects at once.
+* Transforms are stored in structure of arrays layout, so the kernels process several objects
+* per instruction and replace branches by selects. Every kernel gives the same results
+* as moving the objects one by one.
+*/
+namespace motion
+{
+    // Transforms of objects of one type in structure of arrays layout.
+    struct Transforms
+    {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> velocityX;
+        std::vector<float> velocityY;
+        std::vector<float> rotation;        // Rotation in degrees
+        std::vector<float> rotationSpeed;   // Rotation speed in degrees per second
+        std::vector<float> width;
+        std::vector<float> height;
+        std::vector<unsigned char> wrapped; // Set by wrap for objects moved to the other side of the area
+
+        // Resize all arrays to the given number of objects.
+        void resize(std::size_t count);
+
+        // Set the transform of one object.
+        void set(std::size_t index, glm::vec2 position, glm::vec2 velocity, float rotation, float rotationSpeed, glm::vec2 size);
+    };
+
+    // Move objects in range [begin, end) by their velocities and rotate them by their rotation speeds.
+    // Rotations are kept in the interval [0, 360] as by geom::clampAngle, rotation speeds must be lower than 360 degrees per step.
+    void integrate(Transforms& transforms, std::size_t begin, std::size_t end, float deltaTime);
+
+    // Move objects in range [begin, end) that left the area to the other side of it.
+    // An object is out of the area when it is whole behind the left or top edge, or its position is behind the right or bottom edge.
+    void wrap(Transforms& transforms, std::size_t begin, std::size_t end, glm::vec2 area);
+
+    // Same as wrap for a single position.
+    bool wrap(glm::vec2& position, glm::vec2 size, glm::vec2 area);
+}
+
+#endif
\ No newline at end of file
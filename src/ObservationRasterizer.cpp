@@ -0,0 +1,149 @@
+#include "ObservationRasterizer.hpp"
+
+#include "Geometry.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+const std::size_t ObservationRasterizer::MAX_VERTICES;
+
+ObservationRasterizer::ObservationRasterizer(std::size_t width, std::size_t height, std::size_t channels)
+    : m_width(width), m_height(height), m_channels(channels)
+{
+    if (width == 0 || height == 0)
+    {
+        throw std::invalid_argument("Observation frame must not be empty.");
+    }
+    if (channels != 1 && channels != CHANNEL_COUNT)
+    {
+        throw std::invalid_argument("Observation frame must have one channel or one channel per type of objects.");
+    }
+}
+
+std::size_t ObservationRasterizer::getFrameSize() const
+{
+    return m_width * m_height * m_channels;
+}
+
+void ObservationRasterizer::render(const Simulation& simulation, unsigned char* frame) const
+{
+    std::fill(frame, frame + getFrameSize(), static_cast<unsigned char>(0));
+    glm::vec2 camera = simulation.getViewPosition();
+    glm::vec2 scale = glm::vec2(static_cast<float>(m_width), static_cast<float>(m_height)) / simulation.getViewSize();
+    glm::vec2 worldSize = simulation.getWorldSize();
+    std::size_t planeSize = m_width * m_height;
+    bool grayscale = m_channels == 1;
+    auto getPlane = [&](Channel channel) { return grayscale ? frame : frame + channel * planeSize; };
+    if (simulation.getState() != Simulation::State::Over)
+    {
+        renderObject(simulation.getPlayer(), camera, scale, worldSize, getPlane(CHANNEL_PLAYER),
+            grayscale ? PLAYER_INTENSITY : OCCUPIED);
+    }
+    for (const auto& asteroid : simulation.getAsteroids())
+    {
+        renderObject(asteroid, camera, scale, worldSize, getPlane(CHANNEL_ASTEROIDS), grayscale ? ASTEROID_INTENSITY : OCCUPIED);
+    }
+    for (const auto& bullet : simulation.getBullets())
+    {
+        renderObject(bullet, camera, scale, worldSize, getPlane(CHANNEL_BULLETS), grayscale ? BULLET_INTENSITY : OCCUPIED);
+    }
+    for (const auto& remnant : simulation.getRemnants())
+    {
+        renderObject(remnant, camera, scale, worldSize, getPlane(CHANNEL_REMNANTS), grayscale ? REMNANT_INTENSITY : OCCUPIED);
+    }
+}
+
+void ObservationRasterizer::renderObject(const GameObject& object, glm::vec2 camera, glm::vec2 scale, glm::vec2 worldSize,
+    unsigned char* plane, unsigned char value) const
+{
+    const std::vector<glm::vec2>& polygon = object.shape ? object.shape->getPolygon() : QUAD;
+    if (polygon.size() > MAX_VERTICES)
+    {
+        return;
+    }
+    glm::vec2 frameSize = glm::vec2(static_cast<float>(m_width), static_cast<float>(m_height));
+    // Rotated polygon stays in the circle around the center of the object
+    glm::vec2 radius = 0.5f * glm::length(object.size) * scale;
+    for (int x = -1; x <= 1; x++)
+    {
+        for (int y = -1; y <= 1; y++)
+        {
+            glm::vec2 position = object.position + glm::vec2(x, y) * worldSize;
+            glm::vec2 center = (position + 0.5f * object.size - camera) * scale;
+            if (center.x + radius.x < 0.0f || center.y + radius.y < 0.0f
+                || center.x - radius.x > frameSize.x || center.y - radius.y > frameSize.y)
+            {
+                continue;
+            }
+            // Same model matrix as used by the renderer, the view is then mapped to the frame
+            glm::mat4 model = geom::getModelMatrix(position, object.size, object.rotation);
+            glm::vec2 vertices[MAX_VERTICES];
+            for (std::size_t i = 0; i < polygon.size(); i++)
+            {
+                vertices[i] = (glm::vec2(model * glm::vec4(polygon[i], 0.0f, 1.0f)) - camera) * scale;
+            }
+            fillPolygon(vertices, polygon.size(), plane, value);
+            // Objects smaller than a pixel still cover the pixel of their center
+            if (center.x >= 0.0f && center.y >= 0.0f && center.x < frameSize.x && center.y < frameSize.y)
+            {
+                unsigned char& pixel = plane[static_cast<std::size_t>(center.y) * m_width + static_cast<std::size_t>(center.x)];
+                pixel = std::max(pixel, value);
+            }
+        }
+    }
+}
+
+void ObservationRasterizer::fillPolygon(const glm::vec2* vertices, std::size_t count, unsigned char* plane, unsigned char value) const
+{
+    float minY = vertices[0].y;
+    float maxY = vertices[0].y;
+    for (std::size_t i = 1; i < count; i++)
+    {
+        minY = std::min(minY, vertices[i].y);
+        maxY = std::max(maxY, vertices[i].y);
+    }
+    // Rows whose centers lie between the lowest and highest vertex
+    long firstRow = std::max(0L, static_cast<long>(std::ceil(minY - 0.5f)));
+    long lastRow = std::min(static_cast<long>(m_height) - 1, static_cast<long>(std::floor(maxY - 0.5f)));
+    for (long row = firstRow; row <= lastRow; row++)
+    {
+        float y = static_cast<float>(row) + 0.5f;
+        // Crossings of edges with the row, sorted by insertion, pairs of them bound the filled spans
+        float crossings[MAX_VERTICES];
+        std::size_t crossingCount = 0;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            glm::vec2 a = vertices[i];
+            glm::vec2 b = vertices[(i + 1) % count];
+            if ((a.y <= y) == (b.y <= y))
+            {
+                continue;
+            }
+            float x = a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+            std::size_t j = crossingCount++;
+            for (; j > 0 && crossings[j - 1] > x; j--)
+            {
+                crossings[j] = crossings[j - 1];
+            }
+            crossings[j] = x;
+        }
+        unsigned char* pixels = plane + row * m_width;
+        for (std::size_t i = 0; i + 1 < crossingCount; i += 2)
+        {
+            long begin = std::max(0L, static_cast<long>(std::ceil(crossings[i] - 0.5f)));
+            long end = std::min(static_cast<long>(m_width) - 1, static_cast<long>(std::floor(crossings[i + 1] - 0.5f)));
+            // Branch-free loop over a span of bytes, compiled to vector instructions
+            for (long x = begin; x <= end; x++)
+            {
+                pixels[x] = std::max(pixels[x], value);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef OBSERVATION_RASTERIZER_HPP
+#define OBSERVATION_RASTERIZER_HPP
+
+#include "Simulation.hpp"
+#include "GameObject.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <cstddef>
+#include <vector>
+
+/**
+* Draws the view of the simulation into small frames on the CPU, used as observations of automated agents.
+* Objects are filled by their collision polygons transformed by model matrices of the renderer, without textures.
+* A frame has one grayscale channel, where each type of objects has its own intensity, or one occupancy
+* channel per type stored one after another. Pixels are bytes, rows go from the top of the view.
+* The rasterizer keeps no state while drawing, one rasterizer can draw frames of many simulations in parallel.
+*/
+class ObservationRasterizer final
+{
+public:
+    // Channels of multichannel frames
+    enum Channel : std::size_t
+    {
+        CHANNEL_PLAYER,
+        CHANNEL_ASTEROIDS,
+        CHANNEL_BULLETS,
+        CHANNEL_REMNANTS,
+        CHANNEL_COUNT
+    };
+
+    // Create a rasterizer of frames with the given size in pixels and number of channels (1 or CHANNEL_COUNT).
+    // Throws std::invalid_argument for other numbers of channels or an empty frame.
+    ObservationRasterizer(std::size_t width, std::size_t height, std::size_t channels);
+
+    // Get number of bytes of one frame.
+    std::size_t getFrameSize() const;
+
+    // Draw the view of the simulation into the frame of getFrameSize bytes.
+    void render(const Simulation& simulation, unsigned char* frame) const;
+
+private:
+    // Intensities of grayscale frames
+    const unsigned char PLAYER_INTENSITY = 255;
+    const unsigned char ASTEROID_INTENSITY = 160;
+    const unsigned char BULLET_INTENSITY = 255;
+    const unsigned char REMNANT_INTENSITY = 96;
+    const unsigned char OCCUPIED = 255;
+
+    // Polygons of the game have only a few vertices, longer ones are not drawn
+    static const std::size_t MAX_VERTICES = 16;
+    // Polygon of objects without a shape
+    const std::vector<glm::vec2> QUAD = { glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 1.0f) };
+
+    std::size_t m_width;
+    std::size_t m_height;
+    std::size_t m_channels;
+
+    // Draw all copies of the object seen in the view, the world wraps around.
+    // Points of the view are mapped to the frame by subtracting camera and multiplying by scale.
+    void renderObject(const GameObject& object, glm::vec2 camera, glm::vec2 scale, glm::vec2 worldSize,
+        unsigned char* plane, unsigned char value) const;
+
+    // Fill pixels whose centers are inside the polygon given in frame coordinates (even-odd rule),
+    // pixels keep the higher of their value and the given one.
+    void fillPolygon(const glm::vec2* vertices, std::size_t count, unsigned char* plane, unsigned char value) const;
+};
+
+#endif
\ No newline at end of file
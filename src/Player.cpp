@@ -1,32 +1,29 @@
 #include "Player.hpp"
 
-#include "Input.hpp"
 #include "Geometry.hpp"
 
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
 #include <glm/geometric.hpp>
 #include <glm/common.hpp>
 #include <glm/trigonometric.hpp>
 #include <glm/gtc/constants.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-Player::Player() : velocity(0.0f), force(0.0f), turnSpeed(0.0f), decay(0.0f), reloadTime(0.0),
+Player::Player() : velocity(0.0f), force(0.0f), turnSpeed(0.0f), decay(0.0f), reloadTime(0),
 m_angularVelocity(0.0f), m_userForce(0.0f)
 {
 }
 
-void Player::processInput()
+void Player::processInput(const InputState& input)
 {
-    if (Input::isKeyPressed(GLFW_KEY_LEFT))
+    if (input.isPressed(InputState::BUTTON_LEFT))
     {
         m_angularVelocity = -turnSpeed;
     }
-    if (Input::isKeyPressed(GLFW_KEY_RIGHT))
+    if (input.isPressed(InputState::BUTTON_RIGHT))
     {
         m_angularVelocity = turnSpeed;
     }
-    if (Input::isKeyPressed(GLFW_KEY_UP))
+    if (input.isPressed(InputState::BUTTON_FORWARD))
     {
         m_userForce = force;
     }
@@ -44,28 +41,42 @@ void Player::update(float deltaTime)
     m_userForce = 0.0f;
 }
 
-bool Player::canShoot() const
+bool Player::canShoot(Tick now) const
 {
-    return m_reloadTimer.finished();
+    return m_reloadTimer.finished(now);
 }
 
-Bullet Player::shoot(glm::vec2 bulletSize, float speed, double lifetime)
+Bullet Player::shoot(glm::vec2 bulletSize, float speed, Tick now)
 {
     Bullet bullet;
     bullet.position = getBulletPosition(bulletSize);
+    bullet.resetPreviousPosition();
     glm::vec2 bulletDir = geom::getDirection(rotation - 90.0f);
     bullet.velocity = (speed + glm::length(velocity)) * bulletDir;
     bullet.size = bulletSize;
     bullet.rotation = rotation;
-    bullet.setLifetime(lifetime);
-    bullet.bounds = {
-        glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f),
-        glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 1.0f)
-    };
-    m_reloadTimer.start(reloadTime);
+    m_reloadTimer.start(now, reloadTime);
     return bullet;
 }
 
+void Player::save(BinaryWriter& writer) const
+{
+    GameObject::save(writer);
+    writer.write(velocity);
+    m_reloadTimer.save(writer);
+    writer.write(m_angularVelocity);
+    writer.write(m_userForce);
+}
+
+void Player::load(BinaryReader& reader)
+{
+    GameObject::load(reader);
+    reader.read(velocity);
+    m_reloadTimer.load(reader);
+    reader.read(m_angularVelocity);
+    reader.read(m_userForce);
+}
+
 glm::vec2 Player::getBulletPosition(glm::vec2 bulletSize) const
 {
     glm::vec2 normalizedBowPos = glm::vec2(0.5f, 0.0f);
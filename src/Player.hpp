@@ -4,6 +4,7 @@
 #include "GameObject.hpp"
 #include "Bullet.hpp"
 #include "Timer.hpp"
+#include "InputState.hpp"
 
 #include <glm/vec2.hpp>
 
@@ -17,21 +18,25 @@ public:
     float force;        // Force pushing the player forward.
     float turnSpeed;    // Turning speed in degrees per second.
     float decay;        // Decay of the player's speed.
-    double reloadTime;  // Time after which the player can shoot again.
+    Tick reloadTime;    // Number of ticks after which the player can shoot again.
 
     Player();
 
-    // Process input from keyboard and determine the next direction.
-    void processInput();
+    // Process the state of controls and determine the next direction.
+    void processInput(const InputState& input);
 
     // Move the player.
     virtual void update(float deltaTime) override;
 
-    // Check if reload time is up.
-    bool canShoot() const;
+    // Check if reload time is up at the given tick.
+    bool canShoot(Tick now) const;
 
-    // Shoot a bullet in the direction of player.
-    Bullet shoot(glm::vec2 bulletSize, float speed, double lifetime);
+    // Shoot a bullet in the direction of player at the given tick. The shape and identifier of the bullet are not set.
+    Bullet shoot(glm::vec2 bulletSize, float speed, Tick now);
+
+    // Write the state of the player / read the state written by save. Parameters of the ship are not saved.
+    void save(BinaryWriter& writer) const;
+    void load(BinaryReader& reader);
 
 private:
     Timer m_reloadTimer;
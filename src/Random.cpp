@@ -1,36 +1,195 @@
 #include "Random.hpp"
 
-#include <cstdlib>
-#include <ctime>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RND_SIMD_X86 1
+#include <emmintrin.h>
+#else
+#define RND_SIMD_X86 0
+#endif
 
-void rnd::setSeed(unsigned int seed)
+namespace
 {
-    if (seed == 0)
+    const std::size_t LANES = 4;
+    const float FLOAT_UNIT = 1.0f / 16777216.0f;   // 2^-24, floats are made from the upper 24 bits
+
+    std::uint64_t splitMix(std::uint64_t& value)
+    {
+        std::uint64_t result = (value += 0x9E3779B97F4A7C15ull);
+        result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ull;
+        result = (result ^ (result >> 27)) * 0x94D049BB133111EBull;
+        return result ^ (result >> 31);
+    }
+
+    std::uint32_t rotateLeft(std::uint32_t value, int bits)
+    {
+        return (value << bits) | (value >> (32 - bits));
+    }
+
+    // States of the parallel sequences used by fill, word i of lane l is at index i * LANES + l.
+    struct LaneStates
+    {
+        alignas(16) std::uint32_t words[4 * LANES];
+    };
+
+    LaneStates createLaneStates(rnd::Generator& generator)
+    {
+        LaneStates states;
+        for (auto&& word : states.words)
+        {
+            word = generator.next();
+        }
+        for (std::size_t lane = 0; lane < LANES; lane++)
+        {
+            // State of xoshiro must not be zero
+            if ((states.words[lane] | states.words[LANES + lane] | states.words[2 * LANES + lane] | states.words[3 * LANES + lane]) == 0)
+            {
+                states.words[lane] = 1;
+            }
+        }
+        return states;
+    }
+
+    // Generate LANES floats, one from each lane.
+    void nextLanesScalar(LaneStates& states, float* values)
+    {
+        std::uint32_t* s = states.words;
+        for (std::size_t lane = 0; lane < LANES; lane++)
+        {
+            std::uint32_t& s0 = s[lane];
+            std::uint32_t& s1 = s[LANES + lane];
+            std::uint32_t& s2 = s[2 * LANES + lane];
+            std::uint32_t& s3 = s[3 * LANES + lane];
+            std::uint32_t result = s0 + s3;
+            std::uint32_t t = s1 << 9;
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= t;
+            s3 = rotateLeft(s3, 11);
+            values[lane] = static_cast<float>(result >> 8) * FLOAT_UNIT;
+        }
+    }
+
+#if RND_SIMD_X86
+    void fillSse(LaneStates& states, float* values, std::size_t count)
     {
-        std::srand(static_cast<unsigned int>(std::time(0)));
+        __m128i s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(states.words));
+        __m128i s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(states.words + LANES));
+        __m128i s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(states.words + 2 * LANES));
+        __m128i s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(states.words + 3 * LANES));
+        __m128 unit = _mm_set1_ps(FLOAT_UNIT);
+        for (std::size_t i = 0; i + LANES <= count; i += LANES)
+        {
+            __m128i result = _mm_add_epi32(s0, s3);
+            __m128i t = _mm_slli_epi32(s1, 9);
+            s2 = _mm_xor_si128(s2, s0);
+            s3 = _mm_xor_si128(s3, s1);
+            s1 = _mm_xor_si128(s1, s2);
+            s0 = _mm_xor_si128(s0, s3);
+            s2 = _mm_xor_si128(s2, t);
+            s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+            // Values below 2^24 are converted exactly as signed integers
+            __m128 value = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(result, 8)), unit);
+            _mm_storeu_ps(values + i, value);
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(states.words), s0);
+        _mm_store_si128(reinterpret_cast<__m128i*>(states.words + LANES), s1);
+        _mm_store_si128(reinterpret_cast<__m128i*>(states.words + 2 * LANES), s2);
+        _mm_store_si128(reinterpret_cast<__m128i*>(states.words + 3 * LANES), s3);
     }
-    else
+#endif
+}
+
+rnd::Generator::Generator(std::uint64_t seed, std::uint64_t stream)
+{
+    setSeed(seed, stream);
+}
+
+void rnd::Generator::setSeed(std::uint64_t seed, std::uint64_t stream)
+{
+    std::uint64_t value = seed ^ splitMix(stream);
+    std::uint64_t first = splitMix(value);
+    std::uint64_t second = splitMix(value);
+    m_state[0] = static_cast<std::uint32_t>(first);
+    m_state[1] = static_cast<std::uint32_t>(first >> 32);
+    m_state[2] = static_cast<std::uint32_t>(second);
+    m_state[3] = static_cast<std::uint32_t>(second >> 32);
+    if ((m_state[0] | m_state[1] | m_state[2] | m_state[3]) == 0)
     {
-        std::srand(seed);
+        m_state[0] = 1;
     }
 }
 
-float rnd::getFloat()
+std::uint32_t rnd::Generator::next()
 {
-    return static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+    std::uint32_t result = m_state[0] + m_state[3];
+    std::uint32_t t = m_state[1] << 9;
+    m_state[2] ^= m_state[0];
+    m_state[3] ^= m_state[1];
+    m_state[1] ^= m_state[2];
+    m_state[0] ^= m_state[3];
+    m_state[2] ^= t;
+    m_state[3] = rotateLeft(m_state[3], 11);
+    return result;
 }
 
-float rnd::getFloat(float value1, float value2)
+float rnd::Generator::getFloat()
+{
+    return static_cast<float>(next() >> 8) * FLOAT_UNIT;
+}
+
+float rnd::Generator::getFloat(float value1, float value2)
 {
     return value1 + getFloat() * (value2 - value1);
 }
 
-int rnd::getInt(int max)
+int rnd::Generator::getInt(int max)
+{
+    // Multiplication maps the bits to the range without division
+    std::uint64_t range = static_cast<std::uint64_t>(max) + 1;
+    return static_cast<int>((static_cast<std::uint64_t>(next()) * range) >> 32);
+}
+
+void rnd::Generator::fill(float* values, std::size_t count)
+{
+    LaneStates states = createLaneStates(*this);
+    std::size_t i = 0;
+#if RND_SIMD_X86
+    fillSse(states, values, count);
+    i = count - count % LANES;
+#else
+    for (; i + LANES <= count; i += LANES)
+    {
+        nextLanesScalar(states, values + i);
+    }
+#endif
+    if (i < count)
+    {
+        float last[LANES];
+        nextLanesScalar(states, last);
+        for (std::size_t lane = 0; i < count; i++, lane++)
+        {
+            values[i] = last[lane];
+        }
+    }
+}
+
+void rnd::Generator::fill(float* values, std::size_t count, float value1, float value2)
 {
-    float randomFloat = getFloat();
-    if (randomFloat == 1.0f)
+    fill(values, count);
+    for (std::size_t i = 0; i < count; i++)
     {
-        return max;
+        values[i] = value1 + values[i] * (value2 - value1);
     }
-    return static_cast<int>(randomFloat * static_cast<float>(max + 1));
+}
+
+const rnd::Generator::State& rnd::Generator::getState() const
+{
+    return m_state;
+}
+
+void rnd::Generator::setState(const State& state)
+{
+    m_state = state;
 }
\ No newline at end of file
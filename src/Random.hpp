@@ -1,38 +1,69 @@
 #ifndef RANDOM_HPP
 #define RANDOM_HPP
 
-#include <glm/vec2.hpp>
-
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 
 /**
-* Contains functions for easier random number generation.
+* Contains the random number generator used by the game.
 */
 namespace rnd
 {
-    // Set seed of random number generator.
-    // This function should be called to initialize the 'rnd' namespace.
-    // If the given seed is zero then the seed is set randomly.
-    void setSeed(unsigned int seed);
+    /**
+    * Fast generator of pseudorandom numbers (xoshiro128+).
+    * Every generator has its own state, so subsystems can use independent streams seeded from one seed
+    * and the results do not depend on the order in which the subsystems run. The state can be saved
+    * and restored to continue the same sequence later.
+    */
+    class Generator final
+    {
+    public:
+        using State = std::array<std::uint32_t, 4>;
+
+        // Create a generator of the given stream, generators of different streams give independent sequences.
+        explicit Generator(std::uint64_t seed = 1, std::uint64_t stream = 0);
+
+        // Restart the sequence of the given stream.
+        void setSeed(std::uint64_t seed, std::uint64_t stream = 0);
+
+        // Get the next 32 random bits.
+        std::uint32_t next();
+
+        // Get float in the interval [0, 1).
+        float getFloat();
+
+        // Get float between two values.
+        float getFloat(float value1, float value2);
+
+        // Get integer from 0 to max.
+        int getInt(int max);
+
+        // Choose one of two values.
+        template<typename T>
+        T choose(T value1, T value2);
+
+        // Fill the array with floats in the interval [0, 1). Four sequences derived from this generator
+        // are computed in parallel, the values do not depend on whether SIMD instructions are available.
+        void fill(float* values, std::size_t count);
 
-    // Get float in the interval [0, 1].
-    float getFloat();
+        // Fill the array with floats between two values.
+        void fill(float* values, std::size_t count, float value1, float value2);
 
-    // Get float between two values.
-    float getFloat(float value1, float value2);
+        // Get the state, a generator given the same state continues with the same sequence.
+        const State& getState() const;
 
-    // Get integer from 0 to max.
-    int getInt(int max);
+        void setState(const State& state);
 
-    // Choose one of two values.
-    template<typename T>
-    T choose(T value1, T value2);
+    private:
+        State m_state;
+    };
 }
 
 template<typename T>
-T rnd::choose(T value1, T value2)
+T rnd::Generator::choose(T value1, T value2)
 {
-    if (getFloat() <= 0.5f)
+    if ((next() >> 31) == 0)
     {
         return value1;
     }
@@ -11,12 +11,14 @@ void Remnant::update(float deltaTime)
     position += velocity * deltaTime;
 }
 
-void Remnant::setLifetime(double lifetime)
+void Remnant::save(BinaryWriter& writer) const
 {
-    m_lifeTimer.start(lifetime);
+    GameObject::save(writer);
+    writer.write(velocity);
 }
 
-bool Remnant::isDestroyed() const
+void Remnant::load(BinaryReader& reader)
 {
-    return m_lifeTimer.finished();
+    GameObject::load(reader);
+    reader.read(velocity);
 }
\ No newline at end of file
@@ -2,7 +2,6 @@
 #define REMNANT_HPP
 
 #include "GameObject.hpp"
-#include "Timer.hpp"
 
 #include <glm/vec2.hpp>
 
@@ -19,14 +18,9 @@ public:
     // Move the remant.
     void update(float deltaTime) override;
 
-    // Set the duration for which the remnant will exist.
-    void setLifetime(double lifetime);
-
-    // Check if lifetime is up.
-    bool isDestroyed() const;
-
-private:
-    Timer m_lifeTimer;
+    // Write the state of the remnant / read the state written by save.
+    void save(BinaryWriter& writer) const;
+    void load(BinaryReader& reader);
 };
 
 #endif
\ No newline at end of file
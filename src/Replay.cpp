@@ -0,0 +1,368 @@
+#include "Replay.hpp"
+
+#include "Simulation.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    // Append the number in LEB128 encoding, 7 bits per byte starting with the lowest ones.
+    void writeVarint(std::vector<unsigned char>& bytes, std::uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            bytes.push_back(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<unsigned char>(value));
+    }
+
+    std::uint64_t readVarint(const unsigned char* bytes, std::size_t size, std::size_t& offset)
+    {
+        std::uint64_t value = 0;
+        for (unsigned int shift = 0; shift < 64; shift += 7)
+        {
+            if (offset == size)
+            {
+                throw std::runtime_error("Replay file ends unexpectedly.");
+            }
+            unsigned char byte = bytes[offset++];
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        throw std::runtime_error("Replay file contains an invalid number.");
+    }
+
+    // Append the number as 8 bytes in little-endian order, used where entries must have a fixed size.
+    void writeFixed(std::vector<unsigned char>& bytes, std::uint64_t value)
+    {
+        for (unsigned int i = 0; i < 8; i++)
+        {
+            bytes.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+
+    std::uint64_t readFixed(const unsigned char* bytes)
+    {
+        std::uint64_t value = 0;
+        for (unsigned int i = 0; i < 8; i++)
+        {
+            value |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    bool hasMagic(const unsigned char* bytes, std::size_t size, const char (&magic)[4])
+    {
+        return size >= sizeof(magic) && std::equal(magic, magic + sizeof(magic), bytes,
+            [](char expected, unsigned char byte) { return static_cast<unsigned char>(expected) == byte; });
+    }
+
+    // Read the seed from the header following the magic and version.
+    unsigned int readSeed(const unsigned char* bytes, std::size_t size, std::size_t& offset, const std::string& path)
+    {
+        std::uint64_t seed = readVarint(bytes, size, offset);
+        if (seed > std::numeric_limits<unsigned int>::max())
+        {
+            throw std::runtime_error("Replay '" + path + "' has an invalid seed.");
+        }
+        return static_cast<unsigned int>(seed);
+    }
+}
+
+const char Replay::MAGIC[4] = { 'S', 'G', 'R', 'P' };
+const char Replay::INDEX_MAGIC[4] = { 'S', 'G', 'R', 'I' };
+const Tick Replay::DEFAULT_KEYFRAME_INTERVAL;
+
+Replay::Cursor::Cursor(const Replay& replay) : m_replay(&replay), m_run(0), m_runTick(0), m_tick(0)
+{
+}
+
+bool Replay::Cursor::next(InputState& input)
+{
+    const std::vector<Run>& runs = m_replay->m_runs;
+    while (m_run < runs.size() && m_runTick == runs[m_run].length)
+    {
+        ++m_run;
+        m_runTick = 0;
+    }
+    if (m_run == runs.size())
+    {
+        return false;
+    }
+    input = InputState(runs[m_run].buttons);
+    ++m_runTick;
+    ++m_tick;
+    return true;
+}
+
+Tick Replay::Cursor::getTick() const
+{
+    return m_tick;
+}
+
+Replay::Replay(unsigned int seed, Tick keyframeInterval) : m_seed(seed), m_keyframeInterval(keyframeInterval), m_tickCount(0)
+{
+    if (keyframeInterval == 0)
+    {
+        throw std::logic_error("Interval between keyframes must be positive.");
+    }
+}
+
+void Replay::record(const InputState& input)
+{
+    if (m_runs.empty() || m_runs.back().buttons != input.buttons)
+    {
+        m_runs.push_back(Run{ input.buttons, 0 });
+    }
+    ++m_runs.back().length;
+    ++m_tickCount;
+}
+
+bool Replay::needsKeyframe() const
+{
+    return m_keyframes.empty() || m_keyframes.back().tick + m_keyframeInterval <= m_tickCount;
+}
+
+void Replay::addKeyframe(std::vector<unsigned char> state)
+{
+    // The next input either continues the last run or starts a new one, the position at the end of the last run covers both
+    std::size_t run = m_runs.empty() ? 0 : m_runs.size() - 1;
+    std::uint64_t runTick = m_runs.empty() ? 0 : m_runs.back().length;
+    m_keyframes.push_back(Keyframe{ m_tickCount, run, runTick, std::move(state) });
+}
+
+unsigned int Replay::getSeed() const
+{
+    return m_seed;
+}
+
+Tick Replay::getTickCount() const
+{
+    return m_tickCount;
+}
+
+const std::vector<Replay::Run>& Replay::getRuns() const
+{
+    return m_runs;
+}
+
+const std::vector<Replay::Keyframe>& Replay::getKeyframes() const
+{
+    return m_keyframes;
+}
+
+void Replay::save(const std::string& path) const
+{
+    // Header and runs, offsets of runs are kept for the index
+    std::vector<unsigned char> bytes(MAGIC, MAGIC + sizeof(MAGIC));
+    writeVarint(bytes, VERSION);
+    writeVarint(bytes, m_seed);
+    writeVarint(bytes, m_keyframeInterval);
+    writeVarint(bytes, m_runs.size());
+    std::vector<std::uint64_t> runOffsets;
+    for (const auto& run : m_runs)
+    {
+        runOffsets.push_back(bytes.size());
+        bytes.push_back(run.buttons);
+        writeVarint(bytes, run.length);
+    }
+    runOffsets.push_back(bytes.size());
+    // States of keyframes
+    std::vector<std::uint64_t> stateOffsets;
+    for (const auto& keyframe : m_keyframes)
+    {
+        stateOffsets.push_back(bytes.size());
+        bytes.insert(bytes.end(), keyframe.state.begin(), keyframe.state.end());
+    }
+    // Index of keyframes with fixed-size entries and the footer pointing to it
+    std::uint64_t indexOffset = bytes.size();
+    for (std::size_t i = 0; i < m_keyframes.size(); i++)
+    {
+        const Keyframe& keyframe = m_keyframes[i];
+        writeFixed(bytes, keyframe.tick);
+        writeFixed(bytes, runOffsets[keyframe.run]);
+        writeFixed(bytes, keyframe.runTick);
+        writeFixed(bytes, stateOffsets[i]);
+        writeFixed(bytes, keyframe.state.size());
+    }
+    writeFixed(bytes, m_tickCount);
+    writeFixed(bytes, indexOffset);
+    writeFixed(bytes, m_keyframes.size());
+    bytes.insert(bytes.end(), INDEX_MAGIC, INDEX_MAGIC + sizeof(INDEX_MAGIC));
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write replay to '" + path + "'.");
+    }
+}
+
+Replay Replay::load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Failed to open replay '" + path + "'.");
+    }
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!hasMagic(bytes.data(), bytes.size(), MAGIC))
+    {
+        throw std::runtime_error("File '" + path + "' is not a replay.");
+    }
+    std::size_t offset = sizeof(MAGIC);
+    std::uint64_t version = readVarint(bytes.data(), bytes.size(), offset);
+    if (version != 1 && version != VERSION)
+    {
+        throw std::runtime_error("Replay '" + path + "' has an unsupported version.");
+    }
+    unsigned int seed = readSeed(bytes.data(), bytes.size(), offset, path);
+    Tick keyframeInterval = version == 1 ? DEFAULT_KEYFRAME_INTERVAL : readVarint(bytes.data(), bytes.size(), offset);
+    if (keyframeInterval == 0)
+    {
+        throw std::runtime_error("Replay '" + path + "' has an invalid interval between keyframes.");
+    }
+    Replay replay(seed, keyframeInterval);
+    std::uint64_t runCount = readVarint(bytes.data(), bytes.size(), offset);
+    std::vector<std::uint64_t> runOffsets;
+    for (std::uint64_t i = 0; i < runCount; i++)
+    {
+        if (offset == bytes.size())
+        {
+            throw std::runtime_error("Replay file ends unexpectedly.");
+        }
+        runOffsets.push_back(offset);
+        unsigned char buttons = bytes[offset++];
+        std::uint64_t length = readVarint(bytes.data(), bytes.size(), offset);
+        replay.m_runs.push_back(Run{ buttons, length });
+        replay.m_tickCount += length;
+    }
+    runOffsets.push_back(offset);
+    if (version == 1)
+    {
+        return replay;  // Replays of the first version have no keyframes
+    }
+    // Keyframes are read through the index, the reader validates it
+    ReplayReader reader(path);
+    for (const auto& entry : reader.m_index)
+    {
+        auto run = std::lower_bound(runOffsets.begin(), runOffsets.end(), entry.runOffset);
+        if (run == runOffsets.end() || *run != entry.runOffset)
+        {
+            throw std::runtime_error("Replay '" + path + "' has an invalid index.");
+        }
+        const unsigned char* state = bytes.data() + entry.stateOffset;
+        replay.m_keyframes.push_back(Keyframe{ entry.tick, static_cast<std::size_t>(run - runOffsets.begin()), entry.runTick,
+            std::vector<unsigned char>(state, state + entry.stateSize) });
+    }
+    return replay;
+}
+
+ReplayReader::ReplayReader(const std::string& path) : m_file(path), m_path(path), m_seed(0), m_tickCount(0)
+{
+    const unsigned char* bytes = m_file.getData();
+    std::size_t size = m_file.getSize();
+    if (!hasMagic(bytes, size, Replay::MAGIC))
+    {
+        throw std::runtime_error("File '" + path + "' is not a replay.");
+    }
+    std::size_t offset = sizeof(Replay::MAGIC);
+    if (readVarint(bytes, size, offset) != Replay::VERSION)
+    {
+        throw std::runtime_error("Replay '" + path + "' has no index of keyframes.");
+    }
+    m_seed = readSeed(bytes, size, offset, path);
+    std::size_t headerSize = offset;
+    if (size < headerSize + Replay::FOOTER_SIZE
+        || !hasMagic(bytes + size - sizeof(Replay::INDEX_MAGIC), sizeof(Replay::INDEX_MAGIC), Replay::INDEX_MAGIC))
+    {
+        throw std::runtime_error("Replay '" + path + "' has an invalid index.");
+    }
+    const unsigned char* footer = bytes + size - Replay::FOOTER_SIZE;
+    m_tickCount = readFixed(footer);
+    std::uint64_t indexOffset = readFixed(footer + 8);
+    std::uint64_t keyframeCount = readFixed(footer + 16);
+    std::uint64_t indexEnd = size - Replay::FOOTER_SIZE;
+    if (indexOffset < headerSize || indexOffset > indexEnd || (indexEnd - indexOffset) / Replay::INDEX_ENTRY_SIZE != keyframeCount
+        || (indexEnd - indexOffset) % Replay::INDEX_ENTRY_SIZE != 0)
+    {
+        throw std::runtime_error("Replay '" + path + "' has an invalid index.");
+    }
+    for (std::uint64_t i = 0; i < keyframeCount; i++)
+    {
+        const unsigned char* entry = bytes + indexOffset + i * Replay::INDEX_ENTRY_SIZE;
+        IndexEntry indexEntry{ readFixed(entry), readFixed(entry + 8), readFixed(entry + 16), readFixed(entry + 24), readFixed(entry + 32) };
+        bool ordered = m_index.empty() || m_index.back().tick < indexEntry.tick;
+        if (!ordered || indexEntry.tick > m_tickCount || indexEntry.runOffset < headerSize || indexEntry.runOffset > indexOffset
+            || indexEntry.stateOffset > indexOffset || indexEntry.stateSize > indexOffset - indexEntry.stateOffset)
+        {
+            throw std::runtime_error("Replay '" + path + "' has an invalid index.");
+        }
+        m_index.push_back(indexEntry);
+    }
+}
+
+unsigned int ReplayReader::getSeed() const
+{
+    return m_seed;
+}
+
+Tick ReplayReader::getTickCount() const
+{
+    return m_tickCount;
+}
+
+std::size_t ReplayReader::getKeyframeCount() const
+{
+    return m_index.size();
+}
+
+Tick ReplayReader::seek(Simulation& simulation, Tick tick) const
+{
+    if (simulation.getSeed() != m_seed)
+    {
+        throw std::logic_error("Simulation has a different seed than the replay.");
+    }
+    tick = std::min(tick, m_tickCount);
+    auto keyframe = std::upper_bound(m_index.begin(), m_index.end(), tick,
+        [](Tick value, const IndexEntry& entry) { return value < entry.tick; });
+    if (keyframe == m_index.begin())
+    {
+        throw std::runtime_error("Replay '" + m_path + "' has no keyframe before update " + std::to_string(tick) + ".");
+    }
+    --keyframe;
+    const unsigned char* bytes = m_file.getData();
+    simulation.loadState(bytes + keyframe->stateOffset, static_cast<std::size_t>(keyframe->stateSize));
+    // Simulate updates from the keyframe, runs are decoded directly from the mapped file
+    std::size_t offset = static_cast<std::size_t>(keyframe->runOffset);
+    std::size_t runsEnd = static_cast<std::size_t>(m_index.front().stateOffset);
+    std::uint64_t runTick = keyframe->runTick;
+    Tick current = keyframe->tick;
+    while (current < tick)
+    {
+        if (offset >= runsEnd)
+        {
+            throw std::runtime_error("Replay file ends unexpectedly.");
+        }
+        InputState input(bytes[offset++]);
+        std::uint64_t length = readVarint(bytes, runsEnd, offset);
+        for (; runTick < length && current < tick; runTick++, current++)
+        {
+            if (input.isPressed(InputState::BUTTON_QUIT))
+            {
+                return current;
+            }
+            simulation.step(input);
+        }
+        runTick = 0;
+    }
+    return current;
+}
\ No newline at end of file
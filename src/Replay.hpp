@@ -0,0 +1,148 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include "InputState.hpp"
+#include "Timer.hpp"
+#include "MappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Simulation;
+
+/**
+* Recording of a game: the seed of the simulation and the state of controls in every update.
+* Consecutive updates with the same controls are stored as one run, and numbers in files are encoded
+* as variable-length integers, so a replay of an hour of play takes only a few kilobytes.
+* Playing the inputs back on a simulation created with the same seed gives exactly the same game.
+* Every few seconds the replay also keeps a keyframe, a full state of the simulation, so a player of the replay
+* can jump to any update without simulating the game from the start (see ReplayReader).
+*/
+class Replay final
+{
+public:
+    // Updates with the same state of controls.
+    struct Run
+    {
+        unsigned char buttons;
+        std::uint64_t length;
+    };
+
+    /**
+    * Reads the inputs of a replay in order of updates.
+    */
+    class Cursor final
+    {
+    public:
+        explicit Cursor(const Replay& replay);
+
+        // Get input of the next update. Returns false if there are no more updates.
+        bool next(InputState& input);
+
+        // Get number of updates read so far.
+        Tick getTick() const;
+
+    private:
+        const Replay* m_replay;
+        std::size_t m_run;          // Index of the current run
+        std::uint64_t m_runTick;    // Number of updates read from the current run
+        Tick m_tick;
+    };
+
+    // Full state of the simulation before an update, with the position of the input of that update.
+    struct Keyframe
+    {
+        Tick tick;
+        std::size_t run;            // Index of the run containing the input
+        std::uint64_t runTick;      // Number of updates of the run before the input, may equal its length
+        std::vector<unsigned char> state;
+    };
+
+    // Default number of updates between keyframes, ten seconds of the game
+    static const Tick DEFAULT_KEYFRAME_INTERVAL = 600;
+
+    explicit Replay(unsigned int seed = 1, Tick keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+
+    // Append input of the next update.
+    void record(const InputState& input);
+
+    // Check if a keyframe should be added before the input of the next update.
+    bool needsKeyframe() const;
+
+    // Add a keyframe with the state of the simulation before the next update (see Simulation::saveState).
+    void addKeyframe(std::vector<unsigned char> state);
+
+    // Get seed of the recorded simulation.
+    unsigned int getSeed() const;
+
+    // Get number of recorded updates.
+    Tick getTickCount() const;
+
+    const std::vector<Run>& getRuns() const;
+    const std::vector<Keyframe>& getKeyframes() const;
+
+    // Write the replay to a file. Throws std::runtime_error if the file cannot be written.
+    void save(const std::string& path) const;
+
+    // Read a replay from a file. Throws std::runtime_error if the file cannot be read or is not a valid replay.
+    static Replay load(const std::string& path);
+
+private:
+    static const char MAGIC[4];
+    static const char INDEX_MAGIC[4];
+    static const std::uint64_t VERSION = 2;
+    static const std::size_t INDEX_ENTRY_SIZE = 5 * 8;
+    static const std::size_t FOOTER_SIZE = 3 * 8 + sizeof(INDEX_MAGIC);
+
+    unsigned int m_seed;
+    Tick m_keyframeInterval;
+    Tick m_tickCount;
+    std::vector<Run> m_runs;
+    std::vector<Keyframe> m_keyframes;
+
+    friend class ReplayReader;
+};
+
+/**
+* Random access to a replay file without loading it.
+* The file is mapped to memory and only its index is read when it is opened. Seeking restores the nearest
+* earlier keyframe and simulates the updates after it, so it takes at most one keyframe interval of updates.
+*/
+class ReplayReader final
+{
+public:
+    // Open a replay file. Throws std::runtime_error if the file cannot be read or has no keyframe index.
+    explicit ReplayReader(const std::string& path);
+
+    unsigned int getSeed() const;
+    Tick getTickCount() const;
+    std::size_t getKeyframeCount() const;
+
+    // Set the simulation to the state before the given update of the replay, the simulation must have the seed
+    // of the replay. Returns the update reached, which is earlier if the replay quits the game before the update.
+    // Throws std::runtime_error if the file is damaged.
+    Tick seek(Simulation& simulation, Tick tick) const;
+
+private:
+    // Entry of the index of keyframes, offsets are relative to the start of the file
+    struct IndexEntry
+    {
+        Tick tick;
+        std::uint64_t runOffset;    // Offset of the run containing the input of the update
+        std::uint64_t runTick;
+        std::uint64_t stateOffset;
+        std::uint64_t stateSize;
+    };
+
+    MappedFile m_file;
+    std::string m_path;
+    unsigned int m_seed;
+    Tick m_tickCount;
+    std::vector<IndexEntry> m_index;
+
+    friend class Replay;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "ResolutionController.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+ResolutionController::ResolutionController(double budget, float minScale)
+    : m_budget(budget), m_minScale(minScale), m_scale(1.0f)
+{
+    if (budget <= 0.0)
+    {
+        throw std::invalid_argument("Frame budget must be positive.");
+    }
+    if (minScale <= 0.0f || minScale > 1.0f)
+    {
+        throw std::invalid_argument("Minimal resolution scale must be in (0, 1].");
+    }
+}
+
+void ResolutionController::update(double time, float scale)
+{
+    if (time <= 0.0 || scale <= 0.0f || std::abs(time - m_budget) <= TOLERANCE * m_budget)
+    {
+        return;
+    }
+    // Time is proportional to the area, the wanted scale makes the area fit the budget
+    double pixelCost = time / (static_cast<double>(scale) * scale);
+    float wanted = static_cast<float>(std::sqrt(m_budget / pixelCost));
+    wanted = std::clamp(wanted, m_minScale, 1.0f);
+    // Without the minimal step the scale would only approach the bounds and never reach them
+    if (std::abs(wanted - m_scale) <= MIN_STEP)
+    {
+        m_scale = wanted;
+    }
+    else
+    {
+        m_scale = std::clamp(m_scale + GAIN * (wanted - m_scale), m_minScale, 1.0f);
+    }
+}
+
+float ResolutionController::getScale() const
+{
+    return m_scale;
+}
+
+double ResolutionController::getBudget() const
+{
+    return m_budget;
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef RESOLUTION_CONTROLLER_HPP
+#define RESOLUTION_CONTROLLER_HPP
+
+/**
+* Chooses the resolution scale of the scene so that drawing it fits into a time budget.
+* The scale multiplies both sides of the rendered image. Drawing time is assumed to grow with the number
+* of pixels, so every measurement gives the cost of a pixel at the scale it was made with. Measurements
+* of the GPU arrive a few frames late, the cost does not depend on the scale used meanwhile.
+* The scale moves only a part of the way to the one fitting the budget, noise of measurements
+* within the tolerance is ignored.
+*/
+class ResolutionController final
+{
+public:
+    // Control the time of drawing the scene in seconds, the scale stays between the minimum and one.
+    // Throws std::invalid_argument if the budget is not positive or the minimum is not in (0, 1].
+    explicit ResolutionController(double budget, float minScale = 0.5f);
+
+    // Update the scale by a measured drawing time of a frame drawn with the given scale.
+    void update(double time, float scale);
+
+    float getScale() const;
+    double getBudget() const;
+
+private:
+    const float GAIN = 0.25f;           // Part of the difference to the wanted scale done by one update
+    const double TOLERANCE = 0.05;      // Relative difference from the budget that is not corrected
+    const float MIN_STEP = 0.01f;       // Smaller differences to the wanted scale are done at once
+
+    double m_budget;
+    float m_minScale;
+    float m_scale;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "RewindBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+RewindBuffer::RewindBuffer(std::size_t capacity, std::size_t maxDeltaBytes)
+    : m_deltas(capacity), m_first(0), m_size(0), m_deltaBytes(0), m_maxDeltaBytes(maxDeltaBytes), m_hasState(false)
+{
+    if (capacity == 0)
+    {
+        throw std::logic_error("Rewind buffer must hold at least one state.");
+    }
+}
+
+void RewindBuffer::clear()
+{
+    while (m_size > 0)
+    {
+        dropOldest();
+    }
+    m_state.clear();
+    m_hasState = false;
+}
+
+void RewindBuffer::push(std::vector<unsigned char>&& state)
+{
+    std::swap(m_previousState, m_state);
+    m_state = std::move(state);
+    if (!m_hasState)
+    {
+        m_hasState = true;
+        return;     // The first state has no older state to encode
+    }
+    if (m_size == m_deltas.size())
+    {
+        dropOldest();
+    }
+    std::vector<unsigned char>& delta = m_deltas[(m_first + m_size) % m_deltas.size()];
+    encode(m_previousState, m_state, delta);
+    ++m_size;
+    m_deltaBytes += delta.size();
+    while (m_deltaBytes > m_maxDeltaBytes && m_size > 0)
+    {
+        dropOldest();
+    }
+}
+
+bool RewindBuffer::stepBack()
+{
+    if (m_size == 0)
+    {
+        return false;
+    }
+    --m_size;
+    std::vector<unsigned char>& delta = m_deltas[(m_first + m_size) % m_deltas.size()];
+    decode(delta, m_state);
+    m_deltaBytes -= delta.size();
+    delta.clear();
+    return true;
+}
+
+const std::vector<unsigned char>& RewindBuffer::getState() const
+{
+    return m_state;
+}
+
+std::size_t RewindBuffer::getSize() const
+{
+    return m_size;
+}
+
+std::size_t RewindBuffer::getCapacity() const
+{
+    return m_deltas.size();
+}
+
+std::size_t RewindBuffer::getMemoryUsage() const
+{
+    std::size_t bytes = m_state.capacity() + m_previousState.capacity() + m_deltas.capacity() * sizeof(m_deltas[0]);
+    for (const auto& delta : m_deltas)
+    {
+        bytes += delta.capacity();
+    }
+    return bytes;
+}
+
+void RewindBuffer::dropOldest()
+{
+    std::vector<unsigned char>& delta = m_deltas[m_first];
+    m_deltaBytes -= delta.size();
+    delta.clear();
+    m_first = (m_first + 1) % m_deltas.size();
+    --m_size;
+}
+
+void RewindBuffer::encode(const std::vector<unsigned char>& older, const std::vector<unsigned char>& newer, std::vector<unsigned char>& delta)
+{
+    // The newer state is treated as padded by zeros, so bytes beyond its end are stored as they are
+    const std::size_t maxLength = std::numeric_limits<TokenLength>::max();
+    auto getXor = [&older, &newer](std::size_t i) -> unsigned char
+    {
+        return static_cast<unsigned char>(older[i] ^ (i < newer.size() ? newer[i] : 0));
+    };
+    delta.clear();
+    std::uint64_t olderSize = older.size();
+    delta.resize(sizeof(olderSize));
+    std::memcpy(delta.data(), &olderSize, sizeof(olderSize));
+    std::size_t i = 0;
+    while (i < older.size())
+    {
+        std::size_t unchanged = 0;
+        while (i < older.size() && unchanged < maxLength && getXor(i) == 0)
+        {
+            ++i;
+            ++unchanged;
+        }
+        std::size_t changedStart = i;
+        while (i < older.size() && i - changedStart < maxLength && getXor(i) != 0)
+        {
+            ++i;
+        }
+        writeLength(delta, unchanged);
+        writeLength(delta, i - changedStart);
+        for (std::size_t j = changedStart; j < i; j++)
+        {
+            delta.push_back(getXor(j));
+        }
+    }
+}
+
+void RewindBuffer::decode(const std::vector<unsigned char>& delta, std::vector<unsigned char>& state)
+{
+    std::uint64_t olderSize;
+    std::memcpy(&olderSize, delta.data(), sizeof(olderSize));
+    state.resize(std::max<std::size_t>(state.size(), static_cast<std::size_t>(olderSize)), 0);
+    std::size_t offset = sizeof(olderSize);
+    std::size_t position = 0;
+    while (offset < delta.size())
+    {
+        position += readLength(delta.data() + offset);
+        std::size_t changed = readLength(delta.data() + offset + sizeof(TokenLength));
+        offset += 2 * sizeof(TokenLength);
+        for (std::size_t j = 0; j < changed; j++)
+        {
+            state[position + j] ^= delta[offset + j];
+        }
+        position += changed;
+        offset += changed;
+    }
+    state.resize(static_cast<std::size_t>(olderSize));
+}
+
+void RewindBuffer::writeLength(std::vector<unsigned char>& bytes, std::size_t length)
+{
+    TokenLength value = static_cast<TokenLength>(length);
+    unsigned char buffer[sizeof(value)];
+    std::memcpy(buffer, &value, sizeof(value));
+    bytes.insert(bytes.end(), buffer, buffer + sizeof(value));
+}
+
+std::size_t RewindBuffer::readLength(const unsigned char* bytes)
+{
+    TokenLength value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef REWIND_BUFFER_HPP
+#define REWIND_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+* Ring of the last states of the simulation for stepping back in time.
+* Only the newest state is kept whole. Every older state is stored as the XOR of it and the state one tick newer,
+* with runs of zero bytes (values that did not change) left out, so stepping back applies one small delta
+* to the newest state. When the ring is full or exceeds its memory budget, the oldest states are dropped.
+*/
+class RewindBuffer final
+{
+public:
+    // Create the ring for the given number of states older than the newest one and the budget for their deltas in bytes.
+    RewindBuffer(std::size_t capacity, std::size_t maxDeltaBytes);
+
+    // Remove all states.
+    void clear();
+
+    // Add a new state (see Simulation::saveState), the buffer takes its memory.
+    void push(std::vector<unsigned char>&& state);
+
+    // Replace the newest state by the one before it. Returns false if there is no older state.
+    bool stepBack();
+
+    // Get the newest state. The state is empty if nothing was pushed.
+    const std::vector<unsigned char>& getState() const;
+
+    // Get number of times it is possible to step back.
+    std::size_t getSize() const;
+
+    std::size_t getCapacity() const;
+
+    // Get bytes allocated by the buffer, including the newest state.
+    std::size_t getMemoryUsage() const;
+
+private:
+    // Deltas are sequences of tokens: number of unchanged bytes, number of changed bytes and XOR of the changed bytes
+    using TokenLength = std::uint16_t;
+
+    std::vector<std::vector<unsigned char>> m_deltas;   // Ring of deltas, kept allocated when states are dropped
+    std::size_t m_first;            // Index of the oldest delta
+    std::size_t m_size;
+    std::size_t m_deltaBytes;       // Sum of sizes of stored deltas
+    std::size_t m_maxDeltaBytes;
+    std::vector<unsigned char> m_state;
+    std::vector<unsigned char> m_previousState;     // Buffer of the state replaced by push, reused by the next push
+    bool m_hasState;                // Set if a state was pushed since the last clear, the state itself may be empty
+
+    void dropOldest();
+
+    // Write the delta that changes newer into older.
+    static void encode(const std::vector<unsigned char>& older, const std::vector<unsigned char>& newer, std::vector<unsigned char>& delta);
+
+    // Change state into the older state using the delta.
+    static void decode(const std::vector<unsigned char>& delta, std::vector<unsigned char>& state);
+
+    static void writeLength(std::vector<unsigned char>& bytes, std::size_t length);
+    static std::size_t readLength(const unsigned char* bytes);
+};
+
+#endif
\ No newline at end of file
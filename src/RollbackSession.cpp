@@ -0,0 +1,181 @@
+#include "RollbackSession.hpp"
+
+#include "Serialization.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+const std::uint32_t RollbackSession::PACKET_MAGIC;
+
+RollbackSession::Stats::Stats() : rollbacks(0), resimulatedTicks(0), maxRollbackTicks(0), stalls(0),
+packetsSent(0), packetsReceived(0), rollbackTime(0.0), maxRollbackTime(0.0)
+{
+}
+
+RollbackSession::RollbackSession(Simulation& simulation, Transport& transport, std::size_t maxRollbackTicks)
+    : m_simulation(simulation), m_transport(transport), m_maxRollbackTicks(maxRollbackTicks),
+    m_tick(0), m_remoteConfirmed(0), m_localAcknowledged(0),
+    // Remote input can be ahead and local input unacknowledged by up to two budgets, see poll
+    m_localInputs(2 * (maxRollbackTicks + 1), 0), m_remoteInputs(2 * (maxRollbackTicks + 1), 0), m_lastRemoteInput(0),
+    m_states(std::max<std::size_t>(maxRollbackTicks, 1), std::numeric_limits<std::size_t>::max())
+{
+    if (maxRollbackTicks == 0)
+    {
+        throw std::logic_error("Rollback session requires a positive rollback budget.");
+    }
+    m_states.push(m_simulation.saveState());
+}
+
+bool RollbackSession::advance(const InputState& localInput)
+{
+    receive();
+    if (m_tick >= m_remoteConfirmed + m_maxRollbackTicks)
+    {
+        ++m_stats.stalls;
+        send();
+        return false;
+    }
+    m_localInputs[getIndex(m_tick)] = localInput.buttons;
+    if (m_tick >= m_remoteConfirmed)
+    {
+        m_remoteInputs[getIndex(m_tick)] = m_lastRemoteInput;
+    }
+    step();
+    send();
+    return true;
+}
+
+void RollbackSession::poll()
+{
+    receive();
+    send();
+}
+
+Tick RollbackSession::getTick() const
+{
+    return m_tick;
+}
+
+Tick RollbackSession::getConfirmedTick() const
+{
+    return std::min(m_tick, m_remoteConfirmed);
+}
+
+const RollbackSession::Stats& RollbackSession::getStats() const
+{
+    return m_stats;
+}
+
+void RollbackSession::receive()
+{
+    Tick rollbackTick = m_tick;
+    while (m_transport.receive(m_packet))
+    {
+        ++m_stats.packetsReceived;
+        try
+        {
+            handlePacket(m_packet, rollbackTick);
+        }
+        catch (const std::runtime_error&)
+        {
+            // Damaged packets are dropped like lost ones
+        }
+    }
+    if (rollbackTick < m_tick)
+    {
+        rollback(rollbackTick);
+    }
+}
+
+void RollbackSession::handlePacket(const std::vector<unsigned char>& packet, Tick& rollbackTick)
+{
+    // Packet: magic, number of updates of the sender's remote input received, first update and inputs from it on
+    BinaryReader reader(packet.data(), packet.size());
+    if (reader.read<std::uint32_t>() != PACKET_MAGIC)
+    {
+        throw std::runtime_error("Packet does not belong to a rollback session.");
+    }
+    Tick acknowledged = reader.read<Tick>();
+    Tick first = reader.read<Tick>();
+    std::uint32_t count = reader.read<std::uint32_t>();
+    if (acknowledged > m_tick || first > m_remoteConfirmed || first + count > m_tick + m_localInputs.size() / 2)
+    {
+        throw std::runtime_error("Packet of a rollback session is out of range.");
+    }
+    m_localAcknowledged = std::max(m_localAcknowledged, acknowledged);
+    for (Tick tick = first; tick < first + count; tick++)
+    {
+        unsigned char input = reader.read<unsigned char>();
+        if (tick < m_remoteConfirmed)
+        {
+            continue;   // Already received in an earlier packet
+        }
+        if (tick < m_tick && m_remoteInputs[getIndex(tick)] != input)
+        {
+            rollbackTick = std::min(rollbackTick, tick);
+        }
+        m_remoteInputs[getIndex(tick)] = input;
+        m_lastRemoteInput = input;
+        m_remoteConfirmed = tick + 1;
+    }
+}
+
+void RollbackSession::rollback(Tick tick)
+{
+    auto start = std::chrono::steady_clock::now();
+    Tick target = m_tick;
+    while (m_tick > tick)
+    {
+        if (!m_states.stepBack())
+        {
+            throw std::logic_error("Rollback session has no state of the mispredicted update.");
+        }
+        --m_tick;
+    }
+    m_simulation.loadState(m_states.getState().data(), m_states.getState().size());
+    while (m_tick < target)
+    {
+        if (m_tick >= m_remoteConfirmed)
+        {
+            m_remoteInputs[getIndex(m_tick)] = m_lastRemoteInput;
+        }
+        step();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    ++m_stats.rollbacks;
+    m_stats.resimulatedTicks += target - tick;
+    m_stats.maxRollbackTicks = std::max<std::uint64_t>(m_stats.maxRollbackTicks, target - tick);
+    m_stats.rollbackTime += elapsed.count();
+    m_stats.maxRollbackTime = std::max(m_stats.maxRollbackTime, elapsed.count());
+}
+
+void RollbackSession::send()
+{
+    // Local inputs are sent until the remote peer acknowledges them, so lost packets need no retransmission
+    BinaryWriter writer;
+    writer.write(PACKET_MAGIC);
+    writer.write(m_remoteConfirmed);
+    writer.write(m_localAcknowledged);
+    writer.write(static_cast<std::uint32_t>(m_tick - m_localAcknowledged));
+    for (Tick tick = m_localAcknowledged; tick < m_tick; tick++)
+    {
+        writer.write(m_localInputs[getIndex(tick)]);
+    }
+    m_transport.send(writer.getBytes());
+    ++m_stats.packetsSent;
+}
+
+void RollbackSession::step()
+{
+    std::size_t index = getIndex(m_tick);
+    m_simulation.step(InputState(static_cast<unsigned char>(m_localInputs[index] | m_remoteInputs[index])));
+    m_states.push(m_simulation.saveState());
+    ++m_tick;
+}
+
+std::size_t RollbackSession::getIndex(Tick tick) const
+{
+    return static_cast<std::size_t>(tick % m_localInputs.size());
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#ifndef ROLLBACK_SESSION_HPP
+#define ROLLBACK_SESSION_HPP
+
+#include "Simulation.hpp"
+#include "Transport.hpp"
+#include "RewindBuffer.hpp"
+#include "InputState.hpp"
+#include "Timer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+* Keeps the simulations of two peers in sync without waiting for the input of the remote peer.
+* The simulation advances with the local input and a predicted remote input (the last one received). States are saved
+* every update, and when the real remote input differs from the prediction, the simulation returns to the update
+* where they differ and simulates the updates again. The local peer never gets more than the rollback budget
+* ahead of the confirmed remote input, it stalls instead.
+* The game has a single ship, so the inputs of the peers are merged: every button is pressed if either peer presses it.
+*/
+class RollbackSession final
+{
+public:
+    // Counters of the session.
+    struct Stats
+    {
+        std::uint64_t rollbacks;
+        std::uint64_t resimulatedTicks;
+        std::uint64_t maxRollbackTicks;
+        std::uint64_t stalls;               // Calls of advance that waited for remote input
+        std::uint64_t packetsSent;
+        std::uint64_t packetsReceived;
+        double rollbackTime;                // Seconds spent by restoring states and simulating again
+        double maxRollbackTime;
+
+        Stats();
+    };
+
+    // Create the session for the simulation, both peers must start with simulations in the same state.
+    // The transport must be connected to the session of the remote peer.
+    RollbackSession(Simulation& simulation, Transport& transport, std::size_t maxRollbackTicks);
+
+    RollbackSession(const RollbackSession&) = delete;
+    RollbackSession& operator=(const RollbackSession&) = delete;
+
+    // Advance the simulation by one update with the local input. Returns false without advancing if the remote
+    // input is too far behind.
+    bool advance(const InputState& localInput);
+
+    // Receive remote input, correct mispredicted updates and send unacknowledged local input. Called by advance,
+    // and should be called while waiting for the remote peer.
+    void poll();
+
+    // Get number of updates simulated, the simulation is at the start of this update.
+    Tick getTick() const;
+
+    // Get number of updates whose remote input is known, the state before them is final.
+    Tick getConfirmedTick() const;
+
+    const Stats& getStats() const;
+
+private:
+    static const std::uint32_t PACKET_MAGIC = 0x4B424C52;   // "RLBK"
+
+    Simulation& m_simulation;
+    Transport& m_transport;
+    std::size_t m_maxRollbackTicks;
+    Tick m_tick;                            // Updates simulated by the session
+    Tick m_remoteConfirmed;                 // Updates with received remote input
+    Tick m_localAcknowledged;               // Updates whose local input the remote peer received
+    std::vector<unsigned char> m_localInputs;   // Ring of inputs, indexed by update modulo size
+    std::vector<unsigned char> m_remoteInputs;  // Received or predicted remote inputs in the same ring
+    unsigned char m_lastRemoteInput;        // Last confirmed remote input, used as the prediction
+    RewindBuffer m_states;                  // States of the last updates, the newest one is the current state
+    std::vector<unsigned char> m_packet;
+    Stats m_stats;
+
+    void receive();
+    void handlePacket(const std::vector<unsigned char>& packet, Tick& rollbackTick);
+    void rollback(Tick tick);
+    void send();
+    void step();                            // Simulate update m_tick with inputs in the rings
+    std::size_t getIndex(Tick tick) const;
+};
+
+#endif
\ No newline at end of file
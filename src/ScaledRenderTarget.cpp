@@ -0,0 +1,55 @@
+#include "ScaledRenderTarget.hpp"
+
+#include "Debug.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+ScaledRenderTarget::ScaledRenderTarget(unsigned int width, unsigned int height)
+    : m_width(width), m_height(height), m_framebuffer(0), m_colorBuffer(0),
+    m_scaledWidth(static_cast<GLsizei>(width)), m_scaledHeight(static_cast<GLsizei>(height))
+{
+    GL_CALL(glGenRenderbuffers(1, &m_colorBuffer));
+    GL_CALL(glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer));
+    GL_CALL(glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, static_cast<GLsizei>(width), static_cast<GLsizei>(height)));
+    GL_CALL(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+    GL_CALL(glGenFramebuffers(1, &m_framebuffer));
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer));
+    GL_CALL(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer));
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        glDeleteFramebuffers(1, &m_framebuffer);
+        glDeleteRenderbuffers(1, &m_colorBuffer);
+        throw std::runtime_error("Failed to create an offscreen framebuffer.");
+    }
+}
+
+ScaledRenderTarget::~ScaledRenderTarget()
+{
+    // Errors are not checked, destructors must not throw
+    glDeleteFramebuffers(1, &m_framebuffer);
+    glDeleteRenderbuffers(1, &m_colorBuffer);
+}
+
+void ScaledRenderTarget::bind(float scale)
+{
+    scale = std::clamp(scale, 0.0f, 1.0f);
+    m_scaledWidth = std::max<GLsizei>(1, static_cast<GLsizei>(std::lround(scale * m_width)));
+    m_scaledHeight = std::max<GLsizei>(1, static_cast<GLsizei>(std::lround(scale * m_height)));
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer));
+    GL_CALL(glViewport(0, 0, m_scaledWidth, m_scaledHeight));
+}
+
+void ScaledRenderTarget::present() const
+{
+    GLsizei width = static_cast<GLsizei>(m_width);
+    GLsizei height = static_cast<GLsizei>(m_height);
+    GL_CALL(glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer));
+    GL_CALL(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0));
+    GL_CALL(glBlitFramebuffer(0, 0, m_scaledWidth, m_scaledHeight, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_LINEAR));
+    // The default framebuffer is also read by FrameReadback
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    GL_CALL(glViewport(0, 0, width, height));
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef SCALED_RENDER_TARGET_HPP
+#define SCALED_RENDER_TARGET_HPP
+
+#include <glad/glad.h>
+
+/**
+* Offscreen framebuffer for drawing at a lower resolution than the window.
+* The buffer has the full size of the window and a scaled image is drawn only into its bottom left part,
+* so changing the scale every frame allocates nothing. The image is then stretched over the window
+* with linear filtering. Requires a current OpenGL 3.3 context for its whole lifetime.
+* Throws std::runtime_error if the framebuffer cannot be created.
+*/
+class ScaledRenderTarget final
+{
+public:
+    // Create a framebuffer of the given full size.
+    ScaledRenderTarget(unsigned int width, unsigned int height);
+
+    ScaledRenderTarget(const ScaledRenderTarget&) = delete;
+    ScaledRenderTarget& operator=(const ScaledRenderTarget&) = delete;
+
+    ~ScaledRenderTarget();
+
+    // Draw the next commands into the framebuffer with both sides multiplied by the scale in (0, 1].
+    void bind(float scale);
+
+    // Stretch the drawn image over the window and draw the next commands into the window.
+    void present() const;
+
+private:
+    unsigned int m_width;
+    unsigned int m_height;
+    GLuint m_framebuffer;
+    GLuint m_colorBuffer;
+    GLsizei m_scaledWidth;      // Size of the image drawn after the last bind
+    GLsizei m_scaledHeight;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "Serialization.hpp"
+
+#include <algorithm>
+#include <utility>
+
+const std::vector<unsigned char>& BinaryWriter::getBytes() const
+{
+    return m_bytes;
+}
+
+std::vector<unsigned char> BinaryWriter::release()
+{
+    std::vector<unsigned char> bytes = std::move(m_bytes);
+    m_bytes.clear();
+    return bytes;
+}
+
+BinaryReader::BinaryReader(const unsigned char* data, std::size_t size) : m_data(data), m_size(size), m_offset(0)
+{
+}
+
+bool BinaryReader::finished() const
+{
+    return m_offset == m_size;
+}
+
+BitWriter::BitWriter() : m_buffer(0), m_bufferBits(0), m_bitCount(0)
+{
+}
+
+void BitWriter::write(std::uint64_t value, unsigned int bits)
+{
+    m_bitCount += bits;
+    while (bits > 0)
+    {
+        unsigned int count = std::min(bits, 64 - m_bufferBits);
+        std::uint64_t mask = count == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+        m_buffer |= (value & mask) << m_bufferBits;
+        m_bufferBits += count;
+        value = count == 64 ? 0 : value >> count;
+        bits -= count;
+        while (m_bufferBits >= 8)
+        {
+            m_bytes.push_back(static_cast<unsigned char>(m_buffer));
+            m_buffer >>= 8;
+            m_bufferBits -= 8;
+        }
+    }
+}
+
+void BitWriter::writeUnsigned(std::uint64_t value)
+{
+    if ((value >> 63) != 0)
+    {
+        throw std::logic_error("Value is too large for a variable-length number.");
+    }
+    unsigned int bits = 0;
+    while ((value >> bits) != 0)
+    {
+        ++bits;
+    }
+    write(bits, 6);
+    write(value, bits);
+}
+
+void BitWriter::writeSigned(std::int64_t value)
+{
+    std::uint64_t bits = static_cast<std::uint64_t>(value);
+    writeUnsigned((bits << 1) ^ (value < 0 ? ~std::uint64_t(0) : 0));
+}
+
+const std::vector<unsigned char>& BitWriter::getBytes()
+{
+    if (m_bufferBits > 0)
+    {
+        m_bytes.push_back(static_cast<unsigned char>(m_buffer));
+        m_buffer = 0;
+        m_bufferBits = 0;
+        // Padding bits of the last byte are not counted, further writes start in a new byte
+        m_bitCount = m_bytes.size() * 8;
+    }
+    return m_bytes;
+}
+
+std::size_t BitWriter::getBitCount() const
+{
+    return m_bitCount;
+}
+
+BitReader::BitReader(const unsigned char* data, std::size_t size) : m_data(data), m_size(size), m_bitOffset(0)
+{
+}
+
+std::uint64_t BitReader::read(unsigned int bits)
+{
+    if (bits > 64 || m_size * 8 - m_bitOffset < bits)
+    {
+        throw std::runtime_error("Bit stream ends unexpectedly.");
+    }
+    std::uint64_t value = 0;
+    for (unsigned int i = 0; i < bits; )
+    {
+        std::size_t byte = m_bitOffset / 8;
+        unsigned int shift = m_bitOffset % 8;
+        unsigned int count = std::min(8 - shift, bits - i);
+        std::uint64_t part = (m_data[byte] >> shift) & ((1u << count) - 1);
+        value |= part << i;
+        i += count;
+        m_bitOffset += count;
+    }
+    return value;
+}
+
+std::uint64_t BitReader::readUnsigned()
+{
+    return read(static_cast<unsigned int>(read(6)));
+}
+
+std::int64_t BitReader::readSigned()
+{
+    std::uint64_t value = readUnsigned();
+    return static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
\ No newline at end of file
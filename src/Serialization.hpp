@@ -0,0 +1,137 @@
+#ifndef SERIALIZATION_HPP
+#define SERIALIZATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+* Writes values as raw bytes to a growing buffer.
+* Values are stored in the layout of the current platform, so the data can be read only
+* by a program built for the same architecture.
+*/
+class BinaryWriter final
+{
+public:
+    // Append bytes of a trivially copyable value.
+    template<typename T>
+    void write(const T& value);
+
+    const std::vector<unsigned char>& getBytes() const;
+
+    // Move the written bytes out of the writer.
+    std::vector<unsigned char> release();
+
+private:
+    std::vector<unsigned char> m_bytes;
+};
+
+/**
+* Reads values written by BinaryWriter from a buffer it does not own.
+*/
+class BinaryReader final
+{
+public:
+    BinaryReader(const unsigned char* data, std::size_t size);
+
+    // Read the next value. Throws std::runtime_error if the buffer ends before the value.
+    template<typename T>
+    T read();
+
+    // Same as above, the value is stored to the given variable.
+    template<typename T>
+    void read(T& value);
+
+    // Check if all bytes were read.
+    bool finished() const;
+
+private:
+    const unsigned char* m_data;
+    std::size_t m_size;
+    std::size_t m_offset;
+};
+
+/**
+* Writes values with the given number of bits to a growing buffer, starting with the lowest bits.
+*/
+class BitWriter final
+{
+public:
+    BitWriter();
+
+    // Write the lowest bits of the value, at most 64 bits.
+    void write(std::uint64_t value, unsigned int bits);
+
+    // Write the number prefixed by its bit length in 6 bits, small numbers take few bits. The highest bit must be zero.
+    void writeUnsigned(std::uint64_t value);
+
+    // Same as above for a signed number, whose sign is stored in the lowest bit (zigzag encoding).
+    // The number must fit in 63 bits.
+    void writeSigned(std::int64_t value);
+
+    // Get the written bytes, the last byte is padded by zeros.
+    const std::vector<unsigned char>& getBytes();
+
+    // Get number of written bits.
+    std::size_t getBitCount() const;
+
+private:
+    std::vector<unsigned char> m_bytes;
+    std::uint64_t m_buffer;     // Bits not yet stored to m_bytes
+    unsigned int m_bufferBits;
+    std::size_t m_bitCount;
+};
+
+/**
+* Reads values written by BitWriter from a buffer it does not own.
+*/
+class BitReader final
+{
+public:
+    BitReader(const unsigned char* data, std::size_t size);
+
+    // Read a value with the given number of bits, at most 64 bits. Throws std::runtime_error if the buffer ends.
+    std::uint64_t read(unsigned int bits);
+
+    std::uint64_t readUnsigned();
+    std::int64_t readSigned();
+
+private:
+    const unsigned char* m_data;
+    std::size_t m_size;
+    std::size_t m_bitOffset;
+};
+
+template<typename T>
+void BinaryWriter::write(const T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written.");
+    std::size_t offset = m_bytes.size();
+    m_bytes.resize(offset + sizeof(T));
+    std::memcpy(m_bytes.data() + offset, &value, sizeof(T));
+}
+
+template<typename T>
+T BinaryReader::read()
+{
+    T value;
+    read(value);
+    return value;
+}
+
+template<typename T>
+void BinaryReader::read(T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read.");
+    if (m_size - m_offset < sizeof(T))
+    {
+        throw std::runtime_error("Serialized data ends unexpectedly.");
+    }
+    std::memcpy(&value, m_data + m_offset, sizeof(T));
+    m_offset += sizeof(T);
+}
+
+#endif
\ No newline at end of file
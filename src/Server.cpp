@@ -0,0 +1,193 @@
+#include "Server.hpp"
+
+#include "Serialization.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <stdexcept>
+
+const std::uint32_t Server::PROTOCOL_MAGIC;
+const Tick Server::NO_TICK;
+
+Server::Stats::Stats() : ticks(0), sessionTicks(0), packetsSent(0), bytesSent(0), bytesReceived(0), fullSnapshots(0),
+worldEntities(0), viewEntities(0), updatedEntities(0), cpuTime(0.0)
+{
+}
+
+Server::Server(std::uint16_t port, std::size_t maxSessions, float interestRadius, std::size_t maxUpdates,
+    unsigned int worldScale, std::size_t threadCount)
+    : m_socket(port), m_maxSessions(maxSessions), m_interestRadius(interestRadius), m_maxUpdates(maxUpdates),
+    m_worldScale(worldScale), m_jobs(threadCount)
+{
+    if (worldScale == 0)
+    {
+        throw std::logic_error("World of the server must contain at least one view.");
+    }
+}
+
+void Server::update(double now)
+{
+    std::clock_t start = std::clock();
+    receiveMessages(now);
+    removeTimedOutSessions(now);
+    // Sessions are independent, each job updates some of them and encodes their snapshots
+    m_jobs.parallelFor(m_sessionList.size(), 1, [this](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; i++)
+            {
+                updateSession(*m_sessionList[i]);
+            }
+        });
+    for (Session* session : m_sessionList)
+    {
+        m_socket.send(session->address, session->packet);
+        ++m_stats.packetsSent;
+        m_stats.bytesSent += session->packet.size();
+        m_stats.fullSnapshots += session->fullSnapshot ? 1 : 0;
+        const Simulation& simulation = *session->simulation;
+        m_stats.worldEntities += 1 + simulation.getAsteroids().size() + simulation.getBullets().size() + simulation.getRemnants().size();
+        m_stats.viewEntities += session->interest->getView().entities.size();
+        m_stats.updatedEntities += session->interest->getUpdatedCount();
+    }
+    ++m_stats.ticks;
+    m_stats.sessionTicks += m_sessionList.size();
+    m_stats.cpuTime += static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+}
+
+std::uint16_t Server::getPort() const
+{
+    return m_socket.getPort();
+}
+
+std::size_t Server::getSessionCount() const
+{
+    return m_sessions.size();
+}
+
+unsigned int Server::getWorldScale() const
+{
+    return m_worldScale;
+}
+
+float Server::getUpdateInterval() const
+{
+    return Simulation::getUpdateInterval();
+}
+
+const Server::Stats& Server::getStats() const
+{
+    return m_stats;
+}
+
+void Server::resetStats()
+{
+    m_stats = Stats();
+}
+
+void Server::receiveMessages(double now)
+{
+    NetAddress sender;
+    while (m_socket.receive(m_received, sender))
+    {
+        m_stats.bytesReceived += m_received.size();
+        try
+        {
+            handleMessage(sender, now);
+        }
+        catch (const std::runtime_error&)
+        {
+            // Invalid packets are ignored
+        }
+    }
+}
+
+void Server::handleMessage(const NetAddress& sender, double now)
+{
+    BinaryReader reader(m_received.data(), m_received.size());
+    if (reader.read<std::uint32_t>() != PROTOCOL_MAGIC)
+    {
+        return;
+    }
+    unsigned char type = reader.read<unsigned char>();
+    auto it = m_sessions.find(sender);
+    if (type == MESSAGE_CONNECT)
+    {
+        if (it != m_sessions.end() || m_sessions.size() >= m_maxSessions)
+        {
+            return;
+        }
+        auto session = std::make_unique<Session>();
+        session->address = sender;
+        session->simulation = std::make_unique<Simulation>(reader.read<std::uint32_t>(), m_jobs, m_worldScale);
+        session->interest = std::make_unique<InterestManager>(m_interestRadius, m_maxUpdates);
+        session->acknowledged = NO_TICK;
+        session->lastReceived = now;
+        session->fullSnapshot = true;
+        m_sessionList.push_back(session.get());
+        m_sessions.emplace(sender, std::move(session));
+        return;
+    }
+    if (it == m_sessions.end())
+    {
+        return;
+    }
+    Session& session = *it->second;
+    session.lastReceived = now;
+    if (type == MESSAGE_INPUT)
+    {
+        Tick acknowledged = reader.read<Tick>();
+        unsigned char buttons = reader.read<unsigned char>();
+        // Packets may come out of order, only newer acknowledgments are used
+        if (acknowledged != NO_TICK && (session.acknowledged == NO_TICK || acknowledged > session.acknowledged))
+        {
+            session.acknowledged = acknowledged;
+        }
+        session.input = InputState(buttons);
+    }
+    else if (type == MESSAGE_DISCONNECT)
+    {
+        session.lastReceived = now - SESSION_TIMEOUT;
+    }
+}
+
+void Server::removeTimedOutSessions(double now)
+{
+    for (auto it = m_sessions.begin(); it != m_sessions.end(); )
+    {
+        if (now - it->second->lastReceived >= SESSION_TIMEOUT)
+        {
+            m_sessionList.erase(std::find(m_sessionList.begin(), m_sessionList.end(), it->second.get()));
+            it = m_sessions.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void Server::updateSession(Session& session)
+{
+    session.simulation->step(session.input);
+    Snapshot snapshot = session.interest->update(*session.simulation);
+    // The acknowledged snapshot is the baseline if it is still in the history
+    const Snapshot* baseline = nullptr;
+    if (session.acknowledged != NO_TICK)
+    {
+        const Snapshot& candidate = session.history[session.acknowledged % HISTORY_SIZE];
+        if (candidate.tick == session.acknowledged && snapshot.tick - candidate.tick < HISTORY_SIZE)
+        {
+            baseline = &candidate;
+        }
+    }
+    BinaryWriter header;
+    header.write(PROTOCOL_MAGIC);
+    header.write(static_cast<unsigned char>(MESSAGE_SNAPSHOT));
+    header.write(baseline != nullptr ? baseline->tick : NO_TICK);
+    BitWriter writer;
+    snapshot.encode(baseline, writer);
+    session.packet = header.release();
+    session.packet.insert(session.packet.end(), writer.getBytes().begin(), writer.getBytes().end());
+    session.fullSnapshot = baseline == nullptr;
+    session.history[snapshot.tick % HISTORY_SIZE] = std::move(snapshot);
+}
\ No newline at end of file
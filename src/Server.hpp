@@ -0,0 +1,112 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include "Simulation.hpp"
+#include "Snapshot.hpp"
+#include "InterestManager.hpp"
+#include "UdpSocket.hpp"
+#include "JobSystem.hpp"
+#include "InputState.hpp"
+#include "Timer.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+/**
+* Authoritative server running a simulation for every connected client.
+* Clients send their controls and the number of the last snapshot they received, the server sends every client
+* a snapshot of its game after each update, encoded as a delta against the acknowledged snapshot.
+* Snapshots contain only objects near the ship of the client chosen by an InterestManager.
+* Simulations of all sessions share one thread pool and are updated in parallel.
+*/
+class Server final
+{
+public:
+    // Types of messages, every packet starts with PROTOCOL_MAGIC and the type
+    enum MessageType : unsigned char
+    {
+        MESSAGE_CONNECT = 1,        // Client: seed of the game
+        MESSAGE_INPUT = 2,          // Client: acknowledged tick and buttons
+        MESSAGE_DISCONNECT = 3,     // Client: nothing
+        MESSAGE_SNAPSHOT = 4        // Server: tick of the baseline and the encoded snapshot
+    };
+
+    static const std::uint32_t PROTOCOL_MAGIC = 0x504E4753;     // "SGNP"
+    static const Tick NO_TICK = ~Tick(0);                       // Acknowledged or baseline tick if there is none
+
+    // Counters since the last reset.
+    struct Stats
+    {
+        std::uint64_t ticks;
+        std::uint64_t sessionTicks;     // Updates of all sessions
+        std::uint64_t packetsSent;
+        std::uint64_t bytesSent;
+        std::uint64_t bytesReceived;
+        std::uint64_t fullSnapshots;    // Snapshots sent without a baseline
+        std::uint64_t worldEntities;    // Objects in the simulations of all sessions, summed over updates
+        std::uint64_t viewEntities;     // Objects in the snapshots
+        std::uint64_t updatedEntities;  // Objects updated in the snapshots
+        double cpuTime;                 // Processor time of all threads spent in updates, in seconds
+
+        Stats();
+    };
+
+    // Listen on the given port. Clients receive objects within the interest radius from their ship, at most the given
+    // number of them are updated per snapshot. Worlds of sessions have the given number of views along each side.
+    // Throws std::runtime_error if the port cannot be opened and std::logic_error if the world scale is zero.
+    Server(std::uint16_t port, std::size_t maxSessions, float interestRadius, std::size_t maxUpdates,
+        unsigned int worldScale = 1, std::size_t threadCount = 0);
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Handle received messages, update all sessions and send snapshots. The time in seconds is used for timeouts.
+    void update(double now);
+
+    std::uint16_t getPort() const;
+    std::size_t getSessionCount() const;
+    unsigned int getWorldScale() const;
+    float getUpdateInterval() const;
+
+    const Stats& getStats() const;
+    void resetStats();
+
+private:
+    static const std::size_t HISTORY_SIZE = 32;     // Snapshots kept as baselines for each session
+    const double SESSION_TIMEOUT = 5.0;
+
+    struct Session
+    {
+        NetAddress address;
+        std::unique_ptr<Simulation> simulation;
+        std::unique_ptr<InterestManager> interest;
+        InputState input;
+        Tick acknowledged;
+        double lastReceived;
+        std::array<Snapshot, HISTORY_SIZE> history;     // Sent snapshots indexed by tick modulo size
+        std::vector<unsigned char> packet;              // Snapshot to be sent after the update
+        bool fullSnapshot;
+    };
+
+    UdpSocket m_socket;
+    std::size_t m_maxSessions;
+    float m_interestRadius;
+    std::size_t m_maxUpdates;
+    unsigned int m_worldScale;
+    JobSystem m_jobs;
+    std::map<NetAddress, std::unique_ptr<Session>> m_sessions;
+    std::vector<Session*> m_sessionList;    // Sessions in the order they are updated
+    std::vector<unsigned char> m_received;
+    Stats m_stats;
+
+    void receiveMessages(double now);
+    void handleMessage(const NetAddress& sender, double now);
+    void removeTimedOutSessions(double now);
+    void updateSession(Session& session);
+};
+
+#endif
\ No newline at end of file
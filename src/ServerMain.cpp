@@ -0,0 +1,313 @@
+#include "Server.hpp"
+#include "Snapshot.hpp"
+#include "UdpSocket.hpp"
+#include "Serialization.hpp"
+#include "Clock.hpp"
+#include "InputState.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Options of the server or of the bots connecting to it.
+    struct Options
+    {
+        std::uint16_t port = 40000;
+        std::size_t maxSessions = 1024;
+        float interestRadius = 400.0f;
+        std::size_t maxUpdates = 48;
+        unsigned int worldScale = 1;    // Number of views along each side of the worlds of sessions
+        std::size_t threads = 0;        // Zero for one less than the number of hardware threads
+        double seconds = 0.0;           // Zero to run until the process is stopped
+        double reportInterval = 5.0;
+        std::size_t bots = 0;           // Number of bots, zero to run the server
+        std::string serverAddress = "127.0.0.1:40000";
+    };
+
+    // Read options from command line, returns false if they are not valid.
+    bool parseArguments(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string argument = argv[i];
+            if (i + 1 == argc)
+            {
+                return false;
+            }
+            try
+            {
+                if (argument == "--port")
+                {
+                    options.port = static_cast<std::uint16_t>(std::stoul(argv[++i]));
+                }
+                else if (argument == "--max-sessions")
+                {
+                    options.maxSessions = std::stoul(argv[++i]);
+                }
+                else if (argument == "--interest-radius")
+                {
+                    options.interestRadius = std::stof(argv[++i]);
+                }
+                else if (argument == "--max-updates")
+                {
+                    options.maxUpdates = std::stoul(argv[++i]);
+                }
+                else if (argument == "--world-scale")
+                {
+                    options.worldScale = static_cast<unsigned int>(std::stoul(argv[++i]));
+                }
+                else if (argument == "--threads")
+                {
+                    options.threads = std::stoul(argv[++i]);
+                }
+                else if (argument == "--seconds")
+                {
+                    options.seconds = std::stod(argv[++i]);
+                }
+                else if (argument == "--report")
+                {
+                    options.reportInterval = std::stod(argv[++i]);
+                }
+                else if (argument == "--bots")
+                {
+                    options.bots = std::stoul(argv[++i]);
+                }
+                else if (argument == "--server")
+                {
+                    options.serverAddress = argv[++i];
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            catch (const std::logic_error&)
+            {
+                return false;
+            }
+        }
+        return options.reportInterval > 0.0 && options.worldScale > 0;
+    }
+
+    // Print counters of the server since the last report.
+    void printServerStats(const Server& server, double elapsed)
+    {
+        const Server::Stats& stats = server.getStats();
+        double sessionSeconds = stats.sessionTicks * server.getUpdateInterval();
+        std::cout << "Sessions: " << server.getSessionCount()
+            << ", ticks per second: " << stats.ticks / elapsed
+            << ", session ticks per CPU second: " << (stats.cpuTime > 0.0 ? stats.sessionTicks / stats.cpuTime : 0.0)
+            << ", load: " << stats.cpuTime / elapsed * 100.0 << " %"
+            << ", bandwidth per client: " << (sessionSeconds > 0.0 ? stats.bytesSent / sessionSeconds / 1000.0 : 0.0) << " kB/s"
+            << ", average snapshot: " << (stats.packetsSent > 0 ? stats.bytesSent / stats.packetsSent : 0) << " B"
+            << ", full snapshots: " << stats.fullSnapshots << std::endl;
+        if (stats.packetsSent > 0)
+        {
+            std::cout << "Objects per session: " << stats.worldEntities / stats.packetsSent
+                << ", in snapshot: " << stats.viewEntities / stats.packetsSent
+                << ", updated: " << stats.updatedEntities / stats.packetsSent << std::endl;
+        }
+    }
+
+    // Run the server at the rate of the simulation.
+    void runServer(const Options& options)
+    {
+        Server server(options.port, options.maxSessions, options.interestRadius, options.maxUpdates, options.worldScale,
+            options.threads);
+        std::cout << "Listening on port " << server.getPort() << ", world scale: " << server.getWorldScale() << std::endl;
+        RealClock clock;
+        const double interval = server.getUpdateInterval();
+        double nextUpdate = clock.getTime();
+        double lastReport = nextUpdate;
+        while (options.seconds <= 0.0 || clock.getTime() < options.seconds)
+        {
+            double now = clock.getTime();
+            if (now < nextUpdate)
+            {
+                std::this_thread::sleep_for(std::chrono::duration<double>(nextUpdate - now));
+                continue;
+            }
+            server.update(now);
+            nextUpdate += interval;
+            if (now - lastReport >= options.reportInterval)
+            {
+                printServerStats(server, now - lastReport);
+                server.resetStats();
+                lastReport = now;
+            }
+        }
+    }
+
+    // Client connected to the server, sends scripted controls and decodes received snapshots.
+    struct Bot
+    {
+        static const std::size_t HISTORY_SIZE = 64;
+
+        std::unique_ptr<UdpSocket> socket;
+        std::array<Snapshot, HISTORY_SIZE> history;    // Decoded snapshots indexed by tick modulo size
+        Tick acknowledged = Server::NO_TICK;
+        std::uint64_t snapshots = 0;
+        std::uint64_t bytesReceived = 0;
+        std::uint64_t failures = 0;         // Snapshots whose baseline was missing or which did not match the checksum
+    };
+
+    void sendMessage(Bot& bot, const NetAddress& server, Server::MessageType type, std::uint64_t frame)
+    {
+        BinaryWriter writer;
+        writer.write(Server::PROTOCOL_MAGIC);
+        writer.write(static_cast<unsigned char>(type));
+        if (type == Server::MESSAGE_CONNECT)
+        {
+            writer.write(static_cast<std::uint32_t>(frame));
+        }
+        else if (type == Server::MESSAGE_INPUT)
+        {
+            // The bot keeps turning and shooting, and moves forward now and then
+            InputState input(InputState::BUTTON_SHOOT | InputState::BUTTON_RIGHT);
+            if (frame % 120 < 30)
+            {
+                input.press(InputState::BUTTON_FORWARD);
+            }
+            writer.write(bot.acknowledged);
+            writer.write(input.buttons);
+        }
+        bot.socket->send(server, writer.getBytes());
+    }
+
+    void receiveSnapshots(Bot& bot)
+    {
+        std::vector<unsigned char> packet;
+        NetAddress sender;
+        while (bot.socket->receive(packet, sender))
+        {
+            bot.bytesReceived += packet.size();
+            try
+            {
+                BinaryReader header(packet.data(), packet.size());
+                if (header.read<std::uint32_t>() != Server::PROTOCOL_MAGIC || header.read<unsigned char>() != Server::MESSAGE_SNAPSHOT)
+                {
+                    continue;
+                }
+                Tick baselineTick = header.read<Tick>();
+                const Snapshot* baseline = nullptr;
+                if (baselineTick != Server::NO_TICK)
+                {
+                    baseline = &bot.history[baselineTick % Bot::HISTORY_SIZE];
+                    if (baseline->tick != baselineTick)
+                    {
+                        throw std::runtime_error("Baseline of the snapshot is missing.");
+                    }
+                }
+                const std::size_t headerSize = sizeof(std::uint32_t) + sizeof(unsigned char) + sizeof(Tick);
+                BitReader reader(packet.data() + headerSize, packet.size() - headerSize);
+                Snapshot snapshot = Snapshot::decode(baseline, reader);
+                if (bot.acknowledged == Server::NO_TICK || snapshot.tick > bot.acknowledged)
+                {
+                    bot.acknowledged = snapshot.tick;
+                }
+                bot.history[snapshot.tick % Bot::HISTORY_SIZE] = std::move(snapshot);
+                ++bot.snapshots;
+            }
+            catch (const std::runtime_error&)
+            {
+                ++bot.failures;
+            }
+        }
+    }
+
+    // Connect bots to the server and print how much data they received.
+    void runBots(const Options& options)
+    {
+        NetAddress server = NetAddress::parse(options.serverAddress);
+        std::vector<Bot> bots(options.bots);
+        for (std::size_t i = 0; i < bots.size(); i++)
+        {
+            bots[i].socket = std::make_unique<UdpSocket>();
+            sendMessage(bots[i], server, Server::MESSAGE_CONNECT, i + 1);
+        }
+        RealClock clock;
+        const double interval = 1.0 / 60.0;
+        const double duration = options.seconds > 0.0 ? options.seconds : 10.0;
+        std::uint64_t frame = 0;
+        while (clock.getTime() < duration)
+        {
+            for (auto&& bot : bots)
+            {
+                receiveSnapshots(bot);
+                sendMessage(bot, server, Server::MESSAGE_INPUT, frame);
+            }
+            ++frame;
+            double next = frame * interval;
+            double now = clock.getTime();
+            if (now < next)
+            {
+                std::this_thread::sleep_for(std::chrono::duration<double>(next - now));
+            }
+        }
+        std::uint64_t snapshots = 0;
+        std::uint64_t bytes = 0;
+        std::uint64_t failures = 0;
+        for (auto&& bot : bots)
+        {
+            sendMessage(bot, server, Server::MESSAGE_DISCONNECT, frame);
+            snapshots += bot.snapshots;
+            bytes += bot.bytesReceived;
+            failures += bot.failures;
+        }
+        double seconds = clock.getTime();
+        std::cout << "Bots: " << bots.size() << ", snapshots: " << snapshots << ", failed snapshots: " << failures
+            << ", bandwidth per bot: " << bytes / seconds / bots.size() / 1000.0 << " kB/s"
+            << ", average snapshot: " << (snapshots > 0 ? bytes / snapshots : 0) << " B" << std::endl;
+    }
+}
+
+/**
+* Entry point of the dedicated server.
+* Runs a simulation for every connected client and sends it snapshots of its game over UDP.
+* Options: '--port <port>', '--max-sessions <count>', '--interest-radius <distance>' of objects sent to clients,
+* '--max-updates <count>' of objects updated per snapshot, '--world-scale <screens>' along each side of the worlds,
+* '--threads <count>', '--seconds <duration>' and
+* '--report <interval>' for printing counters. With '--bots <count>' the program instead connects the given
+* number of bots to the server at '--server <address:port>' and measures the bandwidth they receive.
+*/
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseArguments(argc, argv, options))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--port <port>] [--max-sessions <count>] [--interest-radius <distance>]"
+            << " [--max-updates <count>] [--world-scale <screens>] [--threads <count>]"
+            << " [--seconds <duration>] [--report <interval>] [--bots <count> [--server <address:port>]]" << std::endl;
+        return -1;
+    }
+    try
+    {
+        if (options.bots > 0)
+        {
+            runBots(options);
+        }
+        else
+        {
+            runServer(options);
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cerr << "Runtime error:" << std::endl << e.what() << std::endl;
+        return -3;
+    }
+    catch (const std::logic_error& e)
+    {
+        std::cerr << "Logic error:" << std::endl << e.what() << std::endl;
+        return -4;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "Shape.hpp"
+
+#include "Geometry.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <utility>
+
+Shape::Shape(const std::vector<glm::vec2>& polygon, glm::vec2 size) : m_polygon(polygon), m_boundingRadius(0.0f)
+{
+    glm::vec2 normalizedCenter = glm::vec2(0.5f, 0.5f);
+    m_vertices.reserve(m_polygon.size());
+    for (const auto& point : m_polygon)
+    {
+        glm::vec2 vertex = (point - normalizedCenter) * size;
+        m_vertices.push_back(vertex);
+        m_boundingRadius = std::max(m_boundingRadius, glm::length(vertex));
+    }
+    std::vector<std::vector<glm::vec2>> convexPolygons;
+    if (geom::isConvex(m_vertices))
+    {
+        convexPolygons.push_back(m_vertices);
+    }
+    else
+    {
+        convexPolygons = geom::triangulate(m_vertices);
+    }
+    for (auto&& vertices : convexPolygons)
+    {
+        Part part;
+        part.normals = geom::getEdgeNormals(vertices);
+        part.vertices = std::move(vertices);
+        m_parts.push_back(std::move(part));
+    }
+}
+
+const std::vector<glm::vec2>& Shape::getPolygon() const
+{
+    return m_polygon;
+}
+
+const std::vector<glm::vec2>& Shape::getVertices() const
+{
+    return m_vertices;
+}
+
+const std::vector<Shape::Part>& Shape::getParts() const
+{
+    return m_parts;
+}
+
+float Shape::getBoundingRadius() const
+{
+    return m_boundingRadius;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef SHAPE_HPP
+#define SHAPE_HPP
+
+#include <glm/vec2.hpp>
+
+#include <vector>
+
+/**
+* Collision shape shared by all game objects of the same kind and size.
+* Holds the normalized polygon (coordinates between 0.0 and 1.0) and values precomputed from it,
+* so that they do not have to be computed for every collision query.
+* Vertices are also stored scaled to the object size and relative to its center,
+* so only rotation and translation are needed to get them in world coordinates.
+* For the separating axis test the polygon is split into convex parts with precomputed edge normals
+* (a convex polygon is a single part, a concave one is triangulated).
+*/
+class Shape final
+{
+public:
+    // Convex part of the shape relative to the center of the object.
+    struct Part
+    {
+        std::vector<glm::vec2> vertices;
+        std::vector<glm::vec2> normals;     // Normal i belongs to the edge from vertex i to vertex i + 1
+    };
+
+    // Create a shape from a normalized polygon for objects with the given size.
+    Shape(const std::vector<glm::vec2>& polygon, glm::vec2 size);
+
+    // Get the normalized polygon.
+    const std::vector<glm::vec2>& getPolygon() const;
+
+    // Get vertices scaled to the object size relative to the center of the object.
+    const std::vector<glm::vec2>& getVertices() const;
+
+    // Get convex parts of the shape.
+    const std::vector<Part>& getParts() const;
+
+    // Get the radius of a circle around the center of the object that contains the whole polygon.
+    float getBoundingRadius() const;
+
+private:
+    std::vector<glm::vec2> m_polygon;
+    std::vector<glm::vec2> m_vertices;
+    std::vector<Part> m_parts;
+    float m_boundingRadius;
+};
+
+#endif
\ No newline at end of file
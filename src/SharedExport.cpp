@@ -0,0 +1,80 @@
+#include "SharedExport.hpp"
+
+#include "Snapshot.hpp"
+
+#include <cstring>
+
+const std::size_t SharedExport::MAX_ENTITIES;
+const std::size_t SharedExport::ENTITY_SLOTS;
+const std::size_t SharedExport::FRAME_SLOTS;
+
+namespace
+{
+    template<typename T>
+    void addEntity(const T& object, Snapshot::EntityType type, SharedExport::Entity* entities, std::uint32_t& count)
+    {
+        if (count == SharedExport::MAX_ENTITIES)
+        {
+            return;
+        }
+        SharedExport::Entity& entity = entities[count++];
+        entity.id = object.id;
+        entity.type = type;
+        entity.x = object.position.x;
+        entity.y = object.position.y;
+        entity.rotation = object.rotation;
+        entity.velocityX = object.velocity.x;
+        entity.velocityY = object.velocity.y;
+    }
+
+    template<typename T>
+    void addEntities(const std::vector<T>& objects, Snapshot::EntityType type, SharedExport::Entity* entities, std::uint32_t& count)
+    {
+        for (const auto& object : objects)
+        {
+            addEntity(object, type, entities, count);
+        }
+    }
+}
+
+SharedExport::SharedExport(const std::string& name, unsigned int frameWidth, unsigned int frameHeight)
+    : m_frameWidth(frameWidth), m_frameHeight(frameHeight),
+    m_entities(name + "-entities", ENTITY_SLOTS, sizeof(EntityTableHeader) + MAX_ENTITIES * sizeof(Entity)),
+    m_frames(name + "-frames", FRAME_SLOTS, sizeof(FrameHeader) + static_cast<std::size_t>(frameWidth) * frameHeight * 4)
+{
+}
+
+void SharedExport::publishEntities(const Simulation& simulation)
+{
+    unsigned char* message = m_entities.beginWrite(simulation.getTick());
+    EntityTableHeader header;
+    header.count = 0;
+    header.state = static_cast<std::uint32_t>(simulation.getState());
+    header.level = simulation.getLevel();
+    header.score = simulation.getScore();
+    // The message is aligned to a cache line, so the entities can be written in place
+    Entity* entities = reinterpret_cast<Entity*>(message + sizeof(EntityTableHeader));
+    if (simulation.getState() != Simulation::State::Over)
+    {
+        addEntity(simulation.getPlayer(), Snapshot::ENTITY_PLAYER, entities, header.count);
+    }
+    addEntities(simulation.getAsteroids(), Snapshot::ENTITY_ASTEROID, entities, header.count);
+    addEntities(simulation.getBullets(), Snapshot::ENTITY_BULLET, entities, header.count);
+    addEntities(simulation.getRemnants(), Snapshot::ENTITY_REMNANT, entities, header.count);
+    std::memcpy(message, &header, sizeof(header));
+    m_entities.endWrite(sizeof(EntityTableHeader) + header.count * sizeof(Entity));
+}
+
+void SharedExport::publishFrame(std::uint64_t tick, const unsigned char* pixels)
+{
+    unsigned char* message = m_frames.beginWrite(tick);
+    FrameHeader header{ m_frameWidth, m_frameHeight };
+    std::memcpy(message, &header, sizeof(header));
+    std::size_t rowSize = static_cast<std::size_t>(m_frameWidth) * 4;
+    unsigned char* rows = message + sizeof(FrameHeader);
+    for (unsigned int row = 0; row < m_frameHeight; row++)
+    {
+        std::memcpy(rows + row * rowSize, pixels + (m_frameHeight - 1 - row) * rowSize, rowSize);
+    }
+    m_frames.endWrite(sizeof(FrameHeader) + m_frameHeight * rowSize);
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef SHARED_EXPORT_HPP
+#define SHARED_EXPORT_HPP
+
+#include "SharedRing.hpp"
+#include "Simulation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+* Publishes the game to other processes in two shared rings, so that they can observe it without sockets or copies
+* of the window. Ring '<name>-entities' holds the table of objects after every update, ring '<name>-frames' holds
+* rendered frames. A message of each ring starts with a header described below.
+*/
+class SharedExport final
+{
+public:
+    // Start of a frame message, RGBA pixels follow it in rows from the top of the window.
+    struct FrameHeader
+    {
+        std::uint32_t width;
+        std::uint32_t height;
+    };
+
+    // Start of an entity table message, entities follow it.
+    struct EntityTableHeader
+    {
+        std::uint32_t count;        // Number of entities in the message
+        std::uint32_t state;        // Simulation::State as a number
+        std::uint64_t level;
+        std::uint64_t score;
+    };
+
+    // One object of the simulation.
+    struct Entity
+    {
+        std::uint64_t id;
+        std::uint32_t type;         // Snapshot::EntityType as a number
+        float x;                    // Position of the top left corner
+        float y;
+        float rotation;             // Rotation in degrees
+        float velocityX;
+        float velocityY;
+    };
+
+    // Objects exceeding the capacity of a message are left out
+    static const std::size_t MAX_ENTITIES = 16384;
+    static const std::size_t ENTITY_SLOTS = 8;
+    static const std::size_t FRAME_SLOTS = 4;
+
+    // Create both rings, frames have the given size in pixels. Throws std::runtime_error if they cannot be created.
+    SharedExport(const std::string& name, unsigned int frameWidth, unsigned int frameHeight);
+
+    // Publish objects of the simulation after an update.
+    void publishEntities(const Simulation& simulation);
+
+    // Publish a frame rendered at the given tick. Pixels are RGBA rows from the bottom as read by OpenGL,
+    // they are flipped while they are copied to the ring.
+    void publishFrame(std::uint64_t tick, const unsigned char* pixels);
+
+private:
+    unsigned int m_frameWidth;
+    unsigned int m_frameHeight;
+    SharedRing m_entities;
+    SharedRing m_frames;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "SharedMemory.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+SharedMemory::SharedMemory(const std::string& name, std::size_t size)
+    : m_name("Local\\" + name), m_data(nullptr), m_size(size), m_owner(true), m_mapping(nullptr)
+{
+    unsigned long long size64 = size;
+    m_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64), m_name.c_str());
+    if (m_mapping != nullptr)
+    {
+        m_data = static_cast<unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+    }
+    if (m_data == nullptr)
+    {
+        if (m_mapping != nullptr)
+        {
+            CloseHandle(m_mapping);
+        }
+        throw std::runtime_error("Failed to create shared memory '" + name + "'.");
+    }
+    std::memset(m_data, 0, size);
+}
+
+SharedMemory::SharedMemory(const std::string& name)
+    : m_name("Local\\" + name), m_data(nullptr), m_size(0), m_owner(false), m_mapping(nullptr)
+{
+    m_mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, m_name.c_str());
+    if (m_mapping != nullptr)
+    {
+        m_data = static_cast<unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    }
+    MEMORY_BASIC_INFORMATION info;
+    if (m_data == nullptr || VirtualQuery(m_data, &info, sizeof(info)) == 0)
+    {
+        if (m_data != nullptr)
+        {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping != nullptr)
+        {
+            CloseHandle(m_mapping);
+        }
+        throw std::runtime_error("Failed to open shared memory '" + name + "'.");
+    }
+    m_size = info.RegionSize;   // Rounded up to whole pages
+}
+
+SharedMemory::~SharedMemory()
+{
+    // The region disappears when the last process closes it
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mapping);
+}
+
+#else
+
+SharedMemory::SharedMemory(const std::string& name, std::size_t size) : m_name("/" + name), m_data(nullptr), m_size(size), m_owner(true)
+{
+    shm_unlink(m_name.c_str());
+    int file = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (file < 0 || ftruncate(file, static_cast<off_t>(size)) != 0)
+    {
+        if (file >= 0)
+        {
+            close(file);
+            shm_unlink(m_name.c_str());
+        }
+        throw std::runtime_error("Failed to create shared memory '" + name + "'.");
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    close(file);    // The mapping stays valid after the descriptor is closed
+    if (data == MAP_FAILED)
+    {
+        shm_unlink(m_name.c_str());
+        throw std::runtime_error("Failed to map shared memory '" + name + "'.");
+    }
+    m_data = static_cast<unsigned char*>(data);     // New regions are filled with zeros
+}
+
+SharedMemory::SharedMemory(const std::string& name) : m_name("/" + name), m_data(nullptr), m_size(0), m_owner(false)
+{
+    int file = shm_open(m_name.c_str(), O_RDWR, 0);
+    struct stat status;
+    if (file < 0 || fstat(file, &status) != 0 || status.st_size == 0)
+    {
+        if (file >= 0)
+        {
+            close(file);
+        }
+        throw std::runtime_error("Failed to open shared memory '" + name + "'.");
+    }
+    m_size = static_cast<std::size_t>(status.st_size);
+    void* data = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    close(file);
+    if (data == MAP_FAILED)
+    {
+        throw std::runtime_error("Failed to map shared memory '" + name + "'.");
+    }
+    m_data = static_cast<unsigned char*>(data);
+}
+
+SharedMemory::~SharedMemory()
+{
+    munmap(m_data, m_size);
+    if (m_owner)
+    {
+        shm_unlink(m_name.c_str());
+    }
+}
+
+#endif
+
+unsigned char* SharedMemory::getData() const
+{
+    return m_data;
+}
+
+std::size_t SharedMemory::getSize() const
+{
+    return m_size;
+}
\ No newline at end of file
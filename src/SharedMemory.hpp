@@ -0,0 +1,41 @@
+#ifndef SHARED_MEMORY_HPP
+#define SHARED_MEMORY_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+* Named region of memory shared with other processes.
+* The process creating the region owns it and removes its name on destruction, processes that opened it
+* keep their mapping until they close it. Names are plain words, they are adapted to the rules of the platform.
+*/
+class SharedMemory final
+{
+public:
+    // Create a zeroed region of the given size, a region with the same name is replaced.
+    // Throws std::runtime_error if the region cannot be created.
+    SharedMemory(const std::string& name, std::size_t size);
+
+    // Open a region created by another process for reading and writing.
+    // Throws std::runtime_error if the region does not exist or cannot be mapped.
+    explicit SharedMemory(const std::string& name);
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    ~SharedMemory();
+
+    unsigned char* getData() const;
+    std::size_t getSize() const;
+
+private:
+    std::string m_name;     // Name of the region on the platform
+    unsigned char* m_data;
+    std::size_t m_size;
+    bool m_owner;           // Set if the region was created by this object
+#ifdef _WIN32
+    void* m_mapping;
+#endif
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "SharedRing.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+const std::uint32_t SharedRing::MAGIC;
+const std::uint32_t SharedRing::VERSION;
+
+SharedRing::SharedRing(const std::string& name, std::size_t slotCount, std::size_t slotSize)
+    : m_memory(name, sizeof(Header) + slotCount * getStride(slotSize)), m_header(nullptr), m_slotStride(getStride(slotSize)), m_writing(0)
+{
+    if (slotCount == 0 || slotSize > UINT32_MAX || slotCount > UINT32_MAX)
+    {
+        throw std::logic_error("Shared ring must have at least one slot and slots must be smaller than 4 GiB.");
+    }
+    // The memory is zeroed, counters are constructed in place so that they can be used as atomics
+    m_header = new (m_memory.getData()) Header();
+    for (std::size_t i = 0; i < slotCount; i++)
+    {
+        new (m_memory.getData() + sizeof(Header) + i * m_slotStride) Slot();
+    }
+    m_header->magic = MAGIC;
+    m_header->version = VERSION;
+    m_header->slotCount = static_cast<std::uint32_t>(slotCount);
+    m_header->slotSize = static_cast<std::uint32_t>(slotSize);
+    m_header->published.store(0, std::memory_order_release);
+}
+
+SharedRing::SharedRing(const std::string& name) : m_memory(name), m_header(nullptr), m_slotStride(0), m_writing(0)
+{
+    if (m_memory.getSize() < sizeof(Header))
+    {
+        throw std::runtime_error("Shared memory '" + name + "' is not a ring.");
+    }
+    m_header = reinterpret_cast<Header*>(m_memory.getData());
+    if (m_header->magic != MAGIC || m_header->version != VERSION)
+    {
+        throw std::runtime_error("Shared memory '" + name + "' is not a ring of a supported version.");
+    }
+    if (m_header->slotCount == 0)
+    {
+        throw std::runtime_error("Shared ring '" + name + "' has no slots.");
+    }
+    // The header comes from another process, sizes computed from it must not overflow
+    const std::size_t maxSize = std::numeric_limits<std::size_t>::max();
+    if (m_header->slotSize > maxSize - sizeof(Slot) - alignof(Slot))
+    {
+        throw std::runtime_error("Shared ring '" + name + "' is truncated.");
+    }
+    m_slotStride = getStride(m_header->slotSize);
+    std::size_t slotCount = m_header->slotCount;
+    if (slotCount > (maxSize - sizeof(Header)) / m_slotStride || m_memory.getSize() < sizeof(Header) + slotCount * m_slotStride)
+    {
+        throw std::runtime_error("Shared ring '" + name + "' is truncated.");
+    }
+}
+
+unsigned char* SharedRing::beginWrite(std::uint64_t tick)
+{
+    m_writing = m_header->published.load(std::memory_order_relaxed);
+    Slot* slot = getSlot(m_writing);
+    slot->sequence.store(2 * m_writing + 1, std::memory_order_relaxed);
+    // Readers must see the odd counter before any byte of the new message
+    std::atomic_thread_fence(std::memory_order_release);
+    slot->tick = tick;
+    return reinterpret_cast<unsigned char*>(slot) + sizeof(Slot);
+}
+
+void SharedRing::endWrite(std::size_t size)
+{
+    if (size > m_header->slotSize)
+    {
+        throw std::logic_error("Message does not fit the slot of the shared ring.");
+    }
+    Slot* slot = getSlot(m_writing);
+    slot->size = size;
+    slot->sequence.store(2 * m_writing + 2, std::memory_order_release);
+    m_header->published.store(m_writing + 1, std::memory_order_release);
+}
+
+std::uint64_t SharedRing::getPublishedCount() const
+{
+    return m_header->published.load(std::memory_order_acquire);
+}
+
+bool SharedRing::read(std::uint64_t index, std::vector<unsigned char>& message, std::uint64_t& tick) const
+{
+    const Slot* slot = getSlot(index);
+    std::uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * index + 2)
+    {
+        return false;
+    }
+    std::size_t size = static_cast<std::size_t>(std::min<std::uint64_t>(slot->size, m_header->slotSize));
+    message.resize(size);
+    std::memcpy(message.data(), reinterpret_cast<const unsigned char*>(slot) + sizeof(Slot), size);
+    tick = slot->tick;
+    // The copy must be finished before the counter is checked again
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot->sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+std::size_t SharedRing::getSlotCount() const
+{
+    return m_header->slotCount;
+}
+
+std::size_t SharedRing::getSlotSize() const
+{
+    return m_header->slotSize;
+}
+
+SharedRing::Slot* SharedRing::getSlot(std::uint64_t index) const
+{
+    unsigned char* slots = m_memory.getData() + sizeof(Header);
+    return reinterpret_cast<Slot*>(slots + (index % m_header->slotCount) * m_slotStride);
+}
+
+std::size_t SharedRing::getStride(std::size_t slotSize)
+{
+    // Slots start at cache lines, so that counters of different slots do not share them
+    return sizeof(Slot) + (slotSize + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef SHARED_RING_HPP
+#define SHARED_RING_HPP
+
+#include "SharedMemory.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+* Ring of messages in shared memory written by one process and read by any number of other processes without locks.
+* Message n is stored in slot n % slotCount. Every slot has a sequence counter, which is 2n + 1 while the writer
+* fills the slot with message n and 2n + 2 when the message is complete. A reader copies the message and checks
+* that the counter did not change meanwhile, otherwise the message was overwritten by a newer one.
+* The header counts published messages, so readers find the newest one without scanning the slots.
+*/
+class SharedRing final
+{
+public:
+    static const std::uint32_t MAGIC = 0x52534753;     // "SGSR"
+    static const std::uint32_t VERSION = 1;
+
+    // Layout of the start of the shared memory, slots follow it.
+    struct alignas(64) Header
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t slotCount;
+        std::uint32_t slotSize;             // Capacity of a slot for the message
+        std::atomic<std::uint64_t> published;   // Number of published messages
+    };
+
+    // Layout of the start of a slot, the message follows it.
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint64_t> sequence;
+        std::uint64_t tick;                 // Tick of the simulation the message belongs to
+        std::uint64_t size;                 // Size of the message
+    };
+
+    // Create a ring with the given number of slots, each of them can hold a message of slotSize bytes.
+    // Throws std::runtime_error if the shared memory cannot be created.
+    SharedRing(const std::string& name, std::size_t slotCount, std::size_t slotSize);
+
+    // Open a ring created by another process for reading.
+    // Throws std::runtime_error if it does not exist, it is not a ring of this version, it has no slots
+    // or its slots do not fit the shared memory.
+    explicit SharedRing(const std::string& name);
+
+    SharedRing(const SharedRing&) = delete;
+    SharedRing& operator=(const SharedRing&) = delete;
+
+    // Get the slot of the next message to be filled by the writer, readers ignore it until endWrite.
+    unsigned char* beginWrite(std::uint64_t tick);
+
+    // Publish the message filled since beginWrite. Throws std::logic_error if its size does not fit the slot.
+    void endWrite(std::size_t size);
+
+    // Get number of messages published so far, the newest one has index count - 1.
+    std::uint64_t getPublishedCount() const;
+
+    // Copy the message with the given index. Returns false if it was not published yet or it was overwritten.
+    bool read(std::uint64_t index, std::vector<unsigned char>& message, std::uint64_t& tick) const;
+
+    std::size_t getSlotCount() const;
+    std::size_t getSlotSize() const;
+
+private:
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Counters shared by processes must be lock-free.");
+
+    SharedMemory m_memory;
+    Header* m_header;
+    std::size_t m_slotStride;   // Distance of slots including their headers
+    std::uint64_t m_writing;    // Index of the message being written by this process
+
+    Slot* getSlot(std::uint64_t index) const;
+    static std::size_t getStride(std::size_t slotSize);
+};
+
+#endif
\ No newline at end of file
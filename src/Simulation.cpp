@@ -0,0 +1,649 @@
+#include "Simulation.hpp"
+
+#include "Random.hpp"
+#include "Geometry.hpp"
+#include "Motion.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/vector_relational.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+const std::uint32_t Simulation::STATE_MAGIC;
+const unsigned int Simulation::UPDATES_PER_SEC;
+
+Simulation::Simulation(unsigned int seed, unsigned int worldScale) : Simulation(seed, worldScale, nullptr)
+{
+}
+
+Simulation::Simulation(unsigned int seed, JobSystem& jobs, unsigned int worldScale) : Simulation(seed, worldScale, &jobs)
+{
+}
+
+Simulation::Simulation(unsigned int seed, unsigned int worldScale, JobSystem* jobs) : WORLD_SCALE(worldScale), m_seed(seed), m_level(1), m_score(0), m_state(State::Running), m_tick(0),
+m_nextObjectId(0), m_ownJobs(jobs == nullptr ? std::make_unique<JobSystem>() : nullptr), m_jobs(jobs == nullptr ? *m_ownJobs : *jobs),
+m_deltaTime(0.0f)
+{
+    if (worldScale == 0)
+    {
+        throw std::logic_error("World of the simulation must contain at least one view.");
+    }
+    createShapes();
+    createPlayer();
+    createSystems();
+    m_asteroidRandom.setSeed(seed, STREAM_ASTEROIDS);
+    m_remnantRandom.setSeed(seed, STREAM_REMNANTS);
+    restart();
+}
+
+void Simulation::restart()
+{
+    m_level = 1;
+    m_score = 0;
+    m_player.position = WORLD_CENTER;
+    m_player.velocity = glm::vec2(0.0f);
+    m_player.rotation = 0.0f;
+    m_asteroids.clear();
+    m_bullets.clear();
+    m_remnants.clear();
+    m_bulletTimers.clear(m_tick);
+    m_remnantTimers.clear(m_tick);
+    spawnAsteroids();
+    m_state = State::Start;
+    m_stateTimer.start(m_tick, TICKS_BETWEEN_STATES);
+}
+
+void Simulation::step(const InputState& input)
+{
+    determineState();
+    processInput(input);
+    update(getUpdateInterval());
+}
+
+glm::vec2 Simulation::getWorldSize() const
+{
+    return WORLD_SIZE;
+}
+
+glm::vec2 Simulation::getViewSize() const
+{
+    return VIEW_SIZE;
+}
+
+glm::vec2 Simulation::getViewPosition() const
+{
+    glm::vec2 position = m_player.position + 0.5f * m_player.size - 0.5f * VIEW_SIZE;
+    return glm::mix(glm::vec2(0.0f), position, glm::greaterThan(WORLD_SIZE, VIEW_SIZE));
+}
+
+unsigned int Simulation::getWorldScale() const
+{
+    return WORLD_SCALE;
+}
+
+float Simulation::getUpdateInterval()
+{
+    return 1.0f / UPDATES_PER_SEC;
+}
+
+unsigned int Simulation::getUpdatesPerSecond()
+{
+    return UPDATES_PER_SEC;
+}
+
+unsigned int Simulation::getSeed() const
+{
+    return m_seed;
+}
+
+Simulation::State Simulation::getState() const
+{
+    return m_state;
+}
+
+std::size_t Simulation::getLevel() const
+{
+    return m_level;
+}
+
+std::uint64_t Simulation::getScore() const
+{
+    return m_score;
+}
+
+Tick Simulation::getTick() const
+{
+    return m_tick;
+}
+
+const Player& Simulation::getPlayer() const
+{
+    return m_player;
+}
+
+const std::vector<Asteroid>& Simulation::getAsteroids() const
+{
+    return m_asteroids;
+}
+
+const std::vector<Bullet>& Simulation::getBullets() const
+{
+    return m_bullets;
+}
+
+const std::vector<Remnant>& Simulation::getRemnants() const
+{
+    return m_remnants;
+}
+
+const CollisionStats& Simulation::getCollisionStats() const
+{
+    return m_collisionStats;
+}
+
+std::vector<unsigned char> Simulation::saveState() const
+{
+    BinaryWriter writer;
+    writer.write(STATE_MAGIC);
+    writer.write(m_seed);
+    writer.write(WORLD_SCALE);
+    writer.write(static_cast<std::uint64_t>(m_level));
+    writer.write(m_score);
+    writer.write(m_state);
+    writer.write(m_tick);
+    m_stateTimer.save(writer);
+    writer.write(m_nextObjectId);
+    writer.write(m_collisionStats);
+    writer.write(m_asteroidRandom.getState());
+    writer.write(m_remnantRandom.getState());
+    m_bulletTimers.save(writer);
+    m_remnantTimers.save(writer);
+    m_player.save(writer);
+    saveObjects(writer, m_asteroids);
+    saveObjects(writer, m_bullets);
+    saveObjects(writer, m_remnants);
+    return writer.release();
+}
+
+void Simulation::loadState(const unsigned char* data, std::size_t size)
+{
+    BinaryReader reader(data, size);
+    if (reader.read<std::uint32_t>() != STATE_MAGIC)
+    {
+        throw std::runtime_error("Data is not a state of the simulation.");
+    }
+    if (reader.read<unsigned int>() != m_seed)
+    {
+        throw std::runtime_error("State was saved by a simulation with a different seed.");
+    }
+    if (reader.read<unsigned int>() != WORLD_SCALE)
+    {
+        throw std::runtime_error("State was saved by a simulation with a different size of the world.");
+    }
+    m_level = static_cast<std::size_t>(reader.read<std::uint64_t>());
+    reader.read(m_score);
+    reader.read(m_state);
+    reader.read(m_tick);
+    m_stateTimer.load(reader);
+    reader.read(m_nextObjectId);
+    reader.read(m_collisionStats);
+    m_asteroidRandom.setState(reader.read<rnd::Generator::State>());
+    m_remnantRandom.setState(reader.read<rnd::Generator::State>());
+    m_bulletTimers.load(reader);
+    m_remnantTimers.load(reader);
+    m_player.load(reader);
+    loadObjects(reader, m_asteroids);
+    loadObjects(reader, m_bullets);
+    loadObjects(reader, m_remnants);
+    if (!reader.finished())
+    {
+        throw std::runtime_error("State of the simulation has unexpected data at the end.");
+    }
+    // Shapes are shared by all objects of a type and are not part of the state
+    for (auto&& asteroid : m_asteroids)
+    {
+        asteroid.shape = m_asteroidShape;
+    }
+    for (auto&& bullet : m_bullets)
+    {
+        bullet.shape = m_bulletShape;
+    }
+}
+
+void Simulation::createShapes()
+{
+    m_asteroidShape = std::make_shared<Shape>(std::vector<glm::vec2>{
+        glm::vec2(0.5f, 0.0f), glm::vec2(1.0f, 0.5f), glm::vec2(0.75f, 1.0f),
+        glm::vec2(0.25f, 1.0f), glm::vec2(0.0f, 0.75f), glm::vec2(0.15f, 0.25f)
+    }, glm::vec2(ASTEROID_SIZE));
+    m_bulletShape = std::make_shared<Shape>(std::vector<glm::vec2>{
+        glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f),
+        glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 1.0f)
+    }, BULLET_SIZE);
+}
+
+void Simulation::createPlayer()
+{
+    m_player.size = PLAYER_SIZE;
+    m_player.reloadTime = PLAYER_RELOAD_TICKS;
+    m_player.force = PLAYER_FORCE;
+    m_player.decay = PLAYER_DECAY;
+    m_player.turnSpeed = PLAYER_TURN_SPEED;
+    m_player.shape = std::make_shared<Shape>(std::vector<glm::vec2>{
+        glm::vec2(0.0f, 1.0f), glm::vec2(0.5f, 0.75f),
+        glm::vec2(1.0f, 1.0f), glm::vec2(0.5f, 0.0f)
+    }, PLAYER_SIZE);
+}
+
+void Simulation::createSystems()
+{
+    m_scheduler.addSystem("bounds", DATA_PLAYER | DATA_ASTEROIDS | DATA_BULLETS, DATA_HULLS,
+        [this]() { updateBounds(); });
+    m_scheduler.addSystem("detection", DATA_HULLS | DATA_PLAYER | DATA_ASTEROIDS | DATA_BULLETS, DATA_EVENTS | DATA_STATE,
+        [this]() { detectCollisions(); });
+    m_scheduler.addSystem("resolution", DATA_ASTEROIDS | DATA_BULLETS, DATA_EVENTS | DATA_REMNANTS | DATA_STATE,
+        [this]() { resolveCollisions(); });
+    m_scheduler.addSystem("compaction", DATA_EVENTS, DATA_ASTEROIDS | DATA_BULLETS | DATA_REMNANTS,
+        [this]() { removeDestroyedObjects(); });
+    // New asteroids are placed away from the player
+    m_scheduler.addSystem("level", DATA_PLAYER, DATA_ASTEROIDS | DATA_STATE,
+        [this]()
+        {
+            if (m_asteroids.size() == 0)
+            {
+                increaseLevel();
+            }
+        });
+    m_scheduler.addSystem("player", 0, DATA_PLAYER,
+        [this]()
+        {
+            m_player.update(m_deltaTime);
+            motion::wrap(m_player.position, m_player.size, WORLD_SIZE);
+        });
+    // Detail of asteroids depends on the position of the player after it moves
+    m_scheduler.addSystem("asteroids", DATA_PLAYER, DATA_ASTEROIDS, [this]() { updateAsteroids(m_deltaTime); });
+    m_scheduler.addSystem("bullets", 0, DATA_BULLETS, [this]() { updateBullets(m_deltaTime); });
+    m_scheduler.addSystem("remnants", 0, DATA_REMNANTS, [this]() { updateRemnants(m_deltaTime); });
+}
+
+void Simulation::determineState()
+{
+    if (m_state == State::Start && m_stateTimer.finished(m_tick))
+    {
+        m_state = State::Running;
+    }
+    else if (m_state == State::Over && m_stateTimer.finished(m_tick))
+    {
+        restart();
+    }
+}
+
+void Simulation::processInput(const InputState& input)
+{
+    if (input.isPressed(InputState::BUTTON_SHOOT) && m_state == State::Running && m_player.canShoot(m_tick))
+    {
+        shootBullet();
+    }
+    m_player.processInput(input);
+}
+
+void Simulation::shootBullet()
+{
+    Bullet bullet = m_player.shoot(BULLET_SIZE, BULLET_SPEED, m_tick);
+    bullet.shape = m_bulletShape;
+    bullet.id = m_nextObjectId++;
+    m_bulletTimers.schedule(bullet.id, m_tick + BULLET_LIFETIME_TICKS);
+    m_bullets.push_back(bullet);
+}
+
+void Simulation::update(float deltaTime)
+{
+    ++m_tick;
+    if (m_state != State::Running)
+    {
+        return;
+    }
+    m_deltaTime = deltaTime;
+    m_scheduler.run(m_jobs);
+}
+
+void Simulation::updateBounds()
+{
+    m_hulls.clear();
+    m_player.updateBounds(m_hulls);
+    // Far asteroids out of reach of bullets are not tested for collisions, so they need no bounds
+    m_nearAsteroids.clear();
+    for (std::size_t i = 0; i < m_asteroids.size(); i++)
+    {
+        if (isNearPlayer(m_asteroids[i]) || isNearBullet(m_asteroids[i]))
+        {
+            m_asteroids[i].updateBounds(m_hulls);
+            m_nearAsteroids.push_back(i);
+        }
+    }
+    for (auto&& bullet : m_bullets)
+    {
+        bullet.updateBounds(m_hulls);
+    }
+}
+
+void Simulation::detectCollisions()
+{
+    std::size_t chunkCount = (m_nearAsteroids.size() + COLLISION_CHUNK_SIZE - 1) / COLLISION_CHUNK_SIZE;
+    if (m_collisionChunks.size() < chunkCount)
+    {
+        m_collisionChunks.resize(chunkCount);
+    }
+    m_jobs.parallelFor(chunkCount, 1,
+        [this](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t chunk = begin; chunk < end; chunk++)
+            {
+                detectCollisionsInChunk(chunk);
+            }
+        });
+    // Chunks are ordered by asteroids and their events by asteroids and bullets,
+    // so concatenating them gives the same order as a serial loop
+    m_collisionEvents.clear();
+    for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+    {
+        const CollisionChunk& results = m_collisionChunks[chunk];
+        m_collisionEvents.insert(m_collisionEvents.end(), results.events.begin(), results.events.end());
+        m_collisionStats += results.stats;
+    }
+}
+
+void Simulation::detectCollisionsInChunk(std::size_t chunk)
+{
+    CollisionChunk& results = m_collisionChunks[chunk];
+    results.events.clear();
+    results.stats.reset();
+    std::size_t end = std::min((chunk + 1) * COLLISION_CHUNK_SIZE, m_nearAsteroids.size());
+    for (std::size_t near = chunk * COLLISION_CHUNK_SIZE; near < end; near++)
+    {
+        std::size_t asteroid = m_nearAsteroids[near];
+        const Asteroid& target = m_asteroids[asteroid];
+        for (std::size_t bullet = 0; bullet < m_bullets.size(); bullet++)
+        {
+            if (m_bullets[bullet].hits(target, target.displacement, m_hulls, results.stats))
+            {
+                results.events.push_back(CollisionEvent{ CollisionEvent::Type::BulletHitsAsteroid, asteroid, bullet });
+            }
+        }
+        if (m_player.collidesWith(target, m_hulls, results.stats))
+        {
+            results.events.push_back(CollisionEvent{ CollisionEvent::Type::AsteroidHitsPlayer, asteroid, 0 });
+        }
+    }
+}
+
+void Simulation::resolveCollisions()
+{
+    m_destroyedAsteroids.assign(m_asteroids.size(), false);
+    m_destroyedBullets.assign(m_bullets.size(), false);
+    m_destroyedRemnants.assign(m_remnants.size(), false);
+    m_remnantOrigins.clear();
+    // Bullet hits are resolved first, asteroids destroyed by bullets cannot hit the player
+    for (const auto& event : m_collisionEvents)
+    {
+        // The first bullet that was not used for another asteroid destroys the asteroid
+        if (event.type == CollisionEvent::Type::BulletHitsAsteroid
+            && !m_destroyedAsteroids[event.asteroid] && !m_destroyedBullets[event.bullet])
+        {
+            m_destroyedAsteroids[event.asteroid] = true;
+            m_destroyedBullets[event.bullet] = true;
+            ++m_score;
+            m_remnantOrigins.push_back(m_asteroids[event.asteroid].getRemnantOrigin());
+        }
+    }
+    for (const auto& event : m_collisionEvents)
+    {
+        if (event.type == CollisionEvent::Type::AsteroidHitsPlayer && !m_destroyedAsteroids[event.asteroid])
+        {
+            gameOver();
+            break;
+        }
+    }
+    markExpiredObjects();
+    spawnRemnants();
+}
+
+void Simulation::markExpiredObjects()
+{
+    m_expiredIds.clear();
+    while (m_bulletTimers.getCurrentTick() < m_tick)
+    {
+        m_bulletTimers.advance(m_expiredIds);
+    }
+    flagObjectsById(m_bullets, m_expiredIds, m_destroyedBullets);
+    m_expiredIds.clear();
+    while (m_remnantTimers.getCurrentTick() < m_tick)
+    {
+        m_remnantTimers.advance(m_expiredIds);
+    }
+    flagObjectsById(m_remnants, m_expiredIds, m_destroyedRemnants);
+}
+
+void Simulation::spawnRemnants()
+{
+    std::size_t count = m_remnantOrigins.size() * REMNANT_COUNT;
+    if (count == 0)
+    {
+        return;
+    }
+    // Speeds and angles of all remnants are generated at once, speeds at even indices and angles at odd ones
+    m_remnantRandomValues.resize(2 * count);
+    m_remnantRandom.fill(m_remnantRandomValues.data(), m_remnantRandomValues.size());
+    m_remnants.reserve(m_remnants.size() + count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        Remnant remnant;
+        remnant.position = m_remnantOrigins[i / REMNANT_COUNT];
+        remnant.size = REMNANT_SIZE;
+        remnant.id = m_nextObjectId++;
+        m_remnantTimers.schedule(remnant.id, m_tick + REMNANT_LIFETIME_TICKS);
+        float speed = REMNANT_MIN_SPEED + m_remnantRandomValues[2 * i] * (REMNANT_MAX_SPEED - REMNANT_MIN_SPEED);
+        float velocityAngle = m_remnantRandomValues[2 * i + 1] * 360.0f;
+        remnant.velocity = speed * geom::getDirection(velocityAngle);
+        m_remnants.push_back(remnant);
+    }
+    // New remnants are not destroyed
+    m_destroyedRemnants.resize(m_remnants.size(), false);
+}
+
+void Simulation::removeDestroyedObjects()
+{
+    removeFlaggedObjects(m_asteroids, m_destroyedAsteroids);
+    removeFlaggedObjects(m_bullets, m_destroyedBullets);
+    removeFlaggedObjects(m_remnants, m_destroyedRemnants);
+}
+
+void Simulation::updateAsteroids(float deltaTime)
+{
+    m_movedAsteroids.clear();
+    for (std::size_t i = 0; i < m_asteroids.size(); i++)
+    {
+        if ((m_tick + m_asteroids[i].id) % FAR_UPDATE_INTERVAL == 0 || isNearPlayer(m_asteroids[i]))
+        {
+            m_movedAsteroids.push_back(i);
+        }
+        else
+        {
+            m_asteroids[i].displacement = glm::vec2(0.0f);
+        }
+    }
+    m_asteroidTransforms.resize(m_movedAsteroids.size());
+    m_jobs.parallelFor(m_movedAsteroids.size(), PARALLEL_CHUNK_SIZE,
+        [this, deltaTime](std::size_t begin, std::size_t end)
+        {
+            // Kernels use one time step for all objects, far asteroids make the longer step by scaled velocities
+            for (std::size_t i = begin; i < end; i++)
+            {
+                const Asteroid& asteroid = m_asteroids[m_movedAsteroids[i]];
+                float steps = isNearPlayer(asteroid) ? 1.0f : static_cast<float>(FAR_UPDATE_INTERVAL);
+                m_asteroidTransforms.set(i, asteroid.position, steps * asteroid.velocity, asteroid.rotation,
+                    steps * asteroid.rotationSpeed, asteroid.size);
+            }
+            motion::integrate(m_asteroidTransforms, begin, end, deltaTime);
+            motion::wrap(m_asteroidTransforms, begin, end, WORLD_SIZE);
+            for (std::size_t i = begin; i < end; i++)
+            {
+                Asteroid& asteroid = m_asteroids[m_movedAsteroids[i]];
+                // Bullets are swept against the real movement, a far asteroid moves by several steps at once
+                asteroid.displacement = glm::vec2(m_asteroidTransforms.velocityX[i], m_asteroidTransforms.velocityY[i]) * deltaTime;
+                asteroid.position = glm::vec2(m_asteroidTransforms.x[i], m_asteroidTransforms.y[i]);
+                asteroid.rotation = m_asteroidTransforms.rotation[i];
+            }
+        });
+}
+
+void Simulation::updateBullets(float deltaTime)
+{
+    m_bulletTransforms.resize(m_bullets.size());
+    m_jobs.parallelFor(m_bullets.size(), PARALLEL_CHUNK_SIZE,
+        [this, deltaTime](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; i++)
+            {
+                const Bullet& bullet = m_bullets[i];
+                m_bulletTransforms.set(i, bullet.position, bullet.velocity, bullet.rotation, 0.0f, bullet.size);
+            }
+            motion::integrate(m_bulletTransforms, begin, end, deltaTime);
+            motion::wrap(m_bulletTransforms, begin, end, WORLD_SIZE);
+            for (std::size_t i = begin; i < end; i++)
+            {
+                Bullet& bullet = m_bullets[i];
+                bullet.resetPreviousPosition();     // Remember the position before the move
+                bullet.position = glm::vec2(m_bulletTransforms.x[i], m_bulletTransforms.y[i]);
+                if (m_bulletTransforms.wrapped[i])
+                {
+                    bullet.resetPreviousPosition();
+                }
+            }
+        });
+}
+
+void Simulation::updateRemnants(float deltaTime)
+{
+    m_remnantTransforms.resize(m_remnants.size());
+    m_jobs.parallelFor(m_remnants.size(), PARALLEL_CHUNK_SIZE,
+        [this, deltaTime](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; i++)
+            {
+                const Remnant& remnant = m_remnants[i];
+                m_remnantTransforms.set(i, remnant.position, remnant.velocity, remnant.rotation, 0.0f, remnant.size);
+            }
+            motion::integrate(m_remnantTransforms, begin, end, deltaTime);
+            motion::wrap(m_remnantTransforms, begin, end, WORLD_SIZE);
+            for (std::size_t i = begin; i < end; i++)
+            {
+                m_remnants[i].position = glm::vec2(m_remnantTransforms.x[i], m_remnantTransforms.y[i]);
+            }
+        });
+}
+
+Tick Simulation::getTicks(double seconds) const
+{
+    return static_cast<Tick>(std::llround(seconds * UPDATES_PER_SEC));
+}
+
+void Simulation::gameOver()
+{
+    m_state = State::Over;
+    m_stateTimer.start(m_tick, TICKS_BETWEEN_STATES);
+}
+
+void Simulation::increaseLevel()
+{
+    ++m_level;
+    spawnAsteroids();
+}
+
+void Simulation::spawnAsteroids()
+{
+    std::size_t count = m_level * ASTEROID_MIN_COUNT * WORLD_SCALE * WORLD_SCALE;
+    for (size_t i = 0; i < count; i++)
+    {
+        createAsteroid();
+    }
+}
+
+void Simulation::createAsteroid()
+{
+    Asteroid asteroid;
+    asteroid.size = glm::vec2(ASTEROID_SIZE);
+    asteroid.position = getAsteroidRandomPos(ASTEROID_SIZE);
+    asteroid.rotation = m_asteroidRandom.getFloat(0.0f, 360.0f);
+    asteroid.rotationSpeed = m_asteroidRandom.getFloat(ASTEROID_MIN_ROT_SPEED, ASTEROID_MAX_ROT_SPEED);
+    float speed = m_asteroidRandom.getFloat(ASTEROID_MIN_SPEED, ASTEROID_MAX_SPEED);
+    float velocityAngle = m_asteroidRandom.getInt(3) * 90.0f + m_asteroidRandom.getFloat(ASTEROID_MIN_ANGLE, ASTEROID_MAX_ANGLE);
+    asteroid.velocity = speed * geom::getDirection(velocityAngle);
+    asteroid.shape = m_asteroidShape;
+    asteroid.id = m_nextObjectId++;
+    m_asteroids.push_back(asteroid);
+}
+
+glm::vec2 Simulation::getAsteroidRandomPos(float size)
+{
+    float randomX = m_asteroidRandom.getFloat(-size, VIEW_WIDTH + size);
+    float randomY = m_asteroidRandom.getFloat(-size, VIEW_HEIGHT + size);
+    glm::vec2 position = m_asteroidRandom.choose<glm::vec2>(
+        glm::vec2(randomX, -size),  // top
+        glm::vec2(-size, randomY)   // left
+        );
+    if (WORLD_SCALE == 1)
+    {
+        return position;
+    }
+    // In a larger world the asteroid is placed at the edge of a random view,
+    // views seen by the player are swapped for the ones on the opposite side of the world
+    int maxView = static_cast<int>(WORLD_SCALE) - 1;
+    glm::vec2 view = glm::vec2(m_asteroidRandom.getInt(maxView), m_asteroidRandom.getInt(maxView));
+    position += view * VIEW_SIZE;
+    glm::vec2 distance = getDistanceToPlayer(position + glm::vec2(size / 2.0f));
+    if (distance.x < (VIEW_SIZE.x + size) / 2.0f && distance.y < (VIEW_SIZE.y + size) / 2.0f)
+    {
+        position += WORLD_SIZE / 2.0f;
+        motion::wrap(position, glm::vec2(size), WORLD_SIZE);
+    }
+    return position;
+}
+
+glm::vec2 Simulation::getDistance(glm::vec2 point1, glm::vec2 point2) const
+{
+    // Distances along both axes are measured the shorter way around the world
+    glm::vec2 distance = glm::mod(glm::abs(point1 - point2), WORLD_SIZE);
+    return glm::min(distance, WORLD_SIZE - distance);
+}
+
+glm::vec2 Simulation::getDistanceToPlayer(glm::vec2 point) const
+{
+    return getDistance(point, m_player.position + m_player.size / 2.0f);
+}
+
+bool Simulation::isNearPlayer(const GameObject& object) const
+{
+    glm::vec2 distance = getDistanceToPlayer(object.position + object.size / 2.0f);
+    return distance.x <= NEAR_HALF_SIZE.x && distance.y <= NEAR_HALF_SIZE.y;
+}
+
+bool Simulation::isNearBullet(const Asteroid& asteroid) const
+{
+    glm::vec2 center = asteroid.position + asteroid.size / 2.0f;
+    for (const auto& bullet : m_bullets)
+    {
+        // Bullets are swept along their last step relative to the asteroid, see Bullet::hits
+        float reach = bullet.shape->getBoundingRadius() + asteroid.shape->getBoundingRadius()
+            + glm::length(bullet.velocity) * m_deltaTime + glm::length(asteroid.displacement);
+        glm::vec2 distance = getDistance(center, bullet.position + bullet.size / 2.0f);
+        if (glm::dot(distance, distance) <= reach * reach)
+        {
+            return true;
+        }
+    }
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,347 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include "GameObject.hpp"
+#include "Player.hpp"
+#include "Asteroid.hpp"
+#include "Bullet.hpp"
+#include "Remnant.hpp"
+#include "Shape.hpp"
+#include "CollisionStats.hpp"
+#include "HullBuffer.hpp"
+#include "Motion.hpp"
+#include "JobSystem.hpp"
+#include "SystemScheduler.hpp"
+#include "Timer.hpp"
+#include "TimingWheel.hpp"
+#include "InputState.hpp"
+#include "Random.hpp"
+#include "Serialization.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+/**
+* Core of the game without any presentation: objects, collisions, levels and states.
+* The simulation advances by fixed steps driven by the caller with the state of controls,
+* it does not read time, input or any other state of GLFW or OpenGL.
+*/
+class Simulation final
+{
+public:
+    enum class State { Start, Running, Over };
+
+    // Create the simulation at the start of level one, random numbers are seeded by the given seed.
+    // The world is a square grid of worldScale x worldScale views, asteroids are spawned in proportion to its area.
+    explicit Simulation(unsigned int seed = 1, unsigned int worldScale = 1);
+
+    // Same as above, the simulation runs its jobs in the given thread pool instead of creating its own.
+    // Used by servers running many simulations, which would otherwise create a pool for each of them.
+    Simulation(unsigned int seed, JobSystem& jobs, unsigned int worldScale = 1);
+
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // Set the simulation to the state of level one.
+    void restart();
+
+    // Advance the simulation by one update with the given controls.
+    void step(const InputState& input);
+
+    // Get size of the world, objects leaving it appear on the other side.
+    glm::vec2 getWorldSize() const;
+
+    // Get size of the part of the world shown on one screen around the player.
+    glm::vec2 getViewSize() const;
+
+    // Get top left corner of the view following the player. The view only moves along the sides
+    // of the world longer than the view, it may reach over the edge of the world.
+    glm::vec2 getViewPosition() const;
+
+    // Get number of views along each side of the world given to the constructor.
+    unsigned int getWorldScale() const;
+
+    // Get duration of one update in seconds, it is the same for all simulations.
+    static float getUpdateInterval();
+
+    // Get number of updates in a second of the game, it is the same for all simulations.
+    static unsigned int getUpdatesPerSecond();
+
+    // Get seed of random numbers given to the constructor.
+    unsigned int getSeed() const;
+
+    State getState() const;
+    std::size_t getLevel() const;
+    std::uint64_t getScore() const;    // Number of asteroids destroyed since the start of the game
+    Tick getTick() const;
+    const Player& getPlayer() const;
+    const std::vector<Asteroid>& getAsteroids() const;
+    const std::vector<Bullet>& getBullets() const;
+    const std::vector<Remnant>& getRemnants() const;
+
+    // Get counters of collision queries since the creation of the simulation.
+    const CollisionStats& getCollisionStats() const;
+
+    // Serialize the full state: level, game state, tick, timers, states of random generators and all objects.
+    // A simulation loading the state continues exactly as the saved one, it must be built for the same platform.
+    std::vector<unsigned char> saveState() const;
+
+    // Restore the state returned by saveState. Throws std::runtime_error if the data is not a valid state.
+    void loadState(const unsigned char* data, std::size_t size);
+
+private:
+    // Collision found by detection, all of them are resolved after detection finishes
+    struct CollisionEvent
+    {
+        enum class Type { BulletHitsAsteroid, AsteroidHitsPlayer };
+
+        Type type;
+        std::size_t asteroid;
+        std::size_t bullet;     // Not used for AsteroidHitsPlayer
+    };
+
+    // Collisions found in one chunk of asteroids
+    struct CollisionChunk
+    {
+        std::vector<CollisionEvent> events;
+        CollisionStats stats;
+    };
+
+    // Streams of random numbers, every subsystem has its own generator
+    enum RandomStream : std::uint64_t
+    {
+        STREAM_ASTEROIDS = 1,
+        STREAM_REMNANTS = 2
+    };
+
+    // Marks the start of a serialized state
+    static const std::uint32_t STATE_MAGIC = 0x54534753;   // "SGST"
+
+    // Data accessed by systems of the update, used for scheduling them
+    enum Data : SystemScheduler::DataMask
+    {
+        DATA_PLAYER = 1 << 0,
+        DATA_ASTEROIDS = 1 << 1,
+        DATA_BULLETS = 1 << 2,
+        DATA_REMNANTS = 1 << 3,
+        DATA_HULLS = 1 << 4,
+        DATA_EVENTS = 1 << 5,   // Collision events and destruction marks
+        DATA_STATE = 1 << 6     // Level, game state and collision stats
+    };
+
+    // World constants
+    const unsigned int VIEW_WIDTH = 800;
+    const unsigned int VIEW_HEIGHT = 600;
+    const glm::vec2 VIEW_SIZE = glm::vec2(VIEW_WIDTH, VIEW_HEIGHT);
+    const unsigned int WORLD_SCALE;     // Number of views along each side of the world
+    const glm::vec2 WORLD_SIZE = VIEW_SIZE * static_cast<float>(WORLD_SCALE);
+    const glm::vec2 WORLD_CENTER = WORLD_SIZE / 2.0f;
+
+    // Time constants
+    static const unsigned int UPDATES_PER_SEC = 60;
+    const double TIME_BETWEEN_STATES = 1.0;
+    const Tick TICKS_BETWEEN_STATES = getTicks(TIME_BETWEEN_STATES);
+
+    // Minimal number of objects updated by one job
+    const std::size_t PARALLEL_CHUNK_SIZE = 256;
+    // Number of asteroids tested for collisions by one job
+    const std::size_t COLLISION_CHUNK_SIZE = 16;
+
+    // Asteroid constants
+    const std::size_t ASTEROID_MIN_COUNT = 5;
+    const float ASTEROID_MIN_ROT_SPEED = -30.0f;
+    const float ASTEROID_MAX_ROT_SPEED = 30.0f;
+    const float ASTEROID_MIN_SPEED = 70.0f;
+    const float ASTEROID_MAX_SPEED = 200.0f;
+    const float ASTEROID_MIN_ANGLE = 20.0f;
+    const float ASTEROID_MAX_ANGLE = 40.0f;
+    const float ASTEROID_SIZE = 40.0f;
+
+    // Player constants
+    const glm::vec2 PLAYER_SIZE = glm::vec2(28.0f, 35.0f);
+    const float PLAYER_FORCE = 400.0f;
+    const float PLAYER_DECAY = 0.99f;
+    const float PLAYER_TURN_SPEED = 225.0f;
+    const float PLAYER_RELOAD_TIME = 0.3f;
+    const Tick PLAYER_RELOAD_TICKS = getTicks(PLAYER_RELOAD_TIME);
+
+    // Bullet constants
+    const float BULLET_SPEED = 400.0f;
+    const glm::vec2 BULLET_SIZE = glm::vec2(3.0f, 10.0f);
+    const float BULLET_RANGE = std::min(VIEW_SIZE.x, VIEW_SIZE.y);
+    const double BULLET_LIFETIME = BULLET_RANGE / BULLET_SPEED;
+    const Tick BULLET_LIFETIME_TICKS = getTicks(BULLET_LIFETIME);
+
+    // Remnant constants
+    const std::size_t REMNANT_COUNT = 10;
+    const glm::vec2 REMNANT_SIZE = glm::vec2(3.0f);
+    const float REMNANT_LIFETIME = 0.5f;
+    const Tick REMNANT_LIFETIME_TICKS = getTicks(REMNANT_LIFETIME);
+    const float REMNANT_MIN_SPEED = 40.0f;
+    const float REMNANT_MAX_SPEED = 80.0f;
+
+    // Level of detail constants. Asteroids farther from the player than half of the view and the bullet range
+    // move only once per FAR_UPDATE_INTERVAL updates by a longer step, updates of far asteroids are spread over
+    // the interval by their identifiers. Far asteroids are tested for collisions only if a live bullet can reach
+    // them in the current update, bullets fired from a moving ship fly farther than the bullet range.
+    // In a world of one view all asteroids are near.
+    const glm::vec2 NEAR_HALF_SIZE = VIEW_SIZE / 2.0f + glm::vec2(BULLET_RANGE);
+    const Tick FAR_UPDATE_INTERVAL = 4;
+
+    unsigned int m_seed;
+    std::size_t m_level;    // Current level
+    std::uint64_t m_score;  // Number of asteroids destroyed since the last restart
+    State m_state;          // Current state
+    Tick m_tick;            // Number of fixed updates since the start
+    Timer m_stateTimer;     // Timer for delay between states
+    Player m_player;
+    std::vector<Asteroid> m_asteroids;
+    std::vector<Bullet> m_bullets;
+    std::vector<Remnant> m_remnants;
+    std::shared_ptr<const Shape> m_asteroidShape;
+    std::shared_ptr<const Shape> m_bulletShape;
+    HullBuffer m_hulls;             // Hulls of objects in world coordinates for the current update
+    CollisionStats m_collisionStats;
+    std::vector<CollisionChunk> m_collisionChunks;
+    std::vector<CollisionEvent> m_collisionEvents;  // Events of the current update ordered by asteroid and bullet
+    std::vector<bool> m_destroyedAsteroids;
+    std::vector<bool> m_destroyedBullets;
+    std::vector<bool> m_destroyedRemnants;
+    std::vector<glm::vec2> m_remnantOrigins;        // Origins of remnants to be spawned in the current update
+    std::uint64_t m_nextObjectId;
+    rnd::Generator m_asteroidRandom;
+    rnd::Generator m_remnantRandom;
+    std::vector<float> m_remnantRandomValues;   // Random values of remnants spawned in the current update
+    TimingWheel m_bulletTimers;     // Lifetimes of bullets, advanced to m_tick by collision resolution
+    TimingWheel m_remnantTimers;
+    std::vector<TimingWheel::Id> m_expiredIds;
+    std::vector<std::size_t> m_nearAsteroids;   // Indices of asteroids near the player or a bullet, tested for collisions in the current update
+    std::vector<std::size_t> m_movedAsteroids;  // Indices of asteroids moved in the current update
+    motion::Transforms m_asteroidTransforms;   // Transforms of objects moved by batched kernels in the current update
+    motion::Transforms m_bulletTransforms;
+    motion::Transforms m_remnantTransforms;
+    std::unique_ptr<JobSystem> m_ownJobs;   // Pool created by the simulation if it was not given one
+    JobSystem& m_jobs;
+    SystemScheduler m_scheduler;
+    float m_deltaTime;              // Time step of the current update
+
+    Simulation(unsigned int seed, unsigned int worldScale, JobSystem* jobs);
+
+    // Initialization
+    void createShapes();
+    void createPlayer();
+    void createSystems();           // Add systems of the update to m_scheduler
+
+    // Update
+    void determineState();          // Determines the next state of the game using m_stateTimer
+    void processInput(const InputState& input);
+    void shootBullet();
+    void update(float deltaTime);
+    void updateBounds();            // Compute bounding boxes and hulls of objects for the current update
+    void detectCollisions();        // Find all collision events in parallel, results do not depend on threads
+    void detectCollisionsInChunk(std::size_t chunk);
+    void resolveCollisions();                   // Mark hit and expired objects as destroyed and spawn remnants
+    void spawnRemnants();                       // Create remnants at all origins collected in the current update
+    void removeDestroyedObjects();              // Compact containers of objects, once per update
+    void markExpiredObjects();                  // Advance timing wheels and mark objects whose lifetime is up as destroyed
+    void updateAsteroids(float deltaTime);     // Move near asteroids and far asteroids whose turn it is
+    void updateBullets(float deltaTime);
+    void updateRemnants(float deltaTime);
+
+    // State change
+    void gameOver();
+    void increaseLevel();       // Increase level and spawn new asteroids
+    void spawnAsteroids();      // Spawn asteroids according to current level
+    void createAsteroid();      // Create a new asteroid and places it randomly outside the screen
+    glm::vec2 getAsteroidRandomPos(float size); // Get a random position of an asteroid to be created
+
+    // Get distances between the points along both axes, the world wraps around.
+    glm::vec2 getDistance(glm::vec2 point1, glm::vec2 point2) const;
+
+    // Get distances of the point from the center of the player along both axes, the world wraps around.
+    glm::vec2 getDistanceToPlayer(glm::vec2 point) const;
+
+    // Check whether the object is close enough to the player to be simulated in full detail.
+    bool isNearPlayer(const GameObject& object) const;
+
+    // Check whether a bullet can hit the asteroid in the current update.
+    bool isNearBullet(const Asteroid& asteroid) const;
+
+    // Write / read all objects of the vector.
+    template<typename T>
+    static void saveObjects(BinaryWriter& writer, const std::vector<T>& objects);
+    template<typename T>
+    static void loadObjects(BinaryReader& reader, std::vector<T>& objects);
+
+    // Convert time in seconds to the nearest number of updates.
+    Tick getTicks(double seconds) const;
+
+    // Set flags of objects whose identifiers are given. Identifiers of objects that no longer exist are ignored.
+    template<typename T>
+    void flagObjectsById(const std::vector<T>& objects, const std::vector<TimingWheel::Id>& ids, std::vector<bool>& flags) const;
+
+    // Remove all objects from vector whose flag is set, keeping the order of the others.
+    template<typename T>
+    void removeFlaggedObjects(std::vector<T>& objects, const std::vector<bool>& flags);
+};
+
+template<typename T>
+void Simulation::saveObjects(BinaryWriter& writer, const std::vector<T>& objects)
+{
+    writer.write(static_cast<std::uint64_t>(objects.size()));
+    for (const auto& object : objects)
+    {
+        object.save(writer);
+    }
+}
+
+template<typename T>
+void Simulation::loadObjects(BinaryReader& reader, std::vector<T>& objects)
+{
+    std::uint64_t count = reader.read<std::uint64_t>();
+    objects.clear();
+    for (std::uint64_t i = 0; i < count; i++)
+    {
+        objects.emplace_back();
+        objects.back().load(reader);
+    }
+}
+
+template<typename T>
+void Simulation::flagObjectsById(const std::vector<T>& objects, const std::vector<TimingWheel::Id>& ids, std::vector<bool>& flags) const
+{
+    // Objects are created with increasing identifiers and removed keeping their order, so they are sorted by identifiers
+    for (TimingWheel::Id id : ids)
+    {
+        auto it = std::lower_bound(objects.begin(), objects.end(), id,
+            [](const T& object, TimingWheel::Id value) { return object.id < value; });
+        if (it != objects.end() && it->id == id)
+        {
+            flags[it - objects.begin()] = true;
+        }
+    }
+}
+
+template<typename T>
+void Simulation::removeFlaggedObjects(std::vector<T>& objects, const std::vector<bool>& flags)
+{
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < objects.size(); i++)
+    {
+        if (!flags[i])
+        {
+            if (kept != i)
+            {
+                objects[kept] = std::move(objects[i]);
+            }
+            ++kept;
+        }
+    }
+    objects.erase(objects.begin() + kept, objects.end());
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "Snapshot.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+const int Snapshot::POSITION_SCALE;
+const unsigned int Snapshot::ROTATION_BITS;
+const int Snapshot::VELOCITY_SCALE;
+const unsigned int Snapshot::CHANGE_X;
+const unsigned int Snapshot::CHANGE_Y;
+const unsigned int Snapshot::CHANGE_ROTATION;
+const unsigned int Snapshot::CHANGE_VELOCITY;
+
+Snapshot::Snapshot() : tick(0), level(0), state(0)
+{
+}
+
+Snapshot Snapshot::capture(const Simulation& simulation)
+{
+    Snapshot snapshot;
+    snapshot.tick = simulation.getTick();
+    snapshot.level = static_cast<std::uint32_t>(simulation.getLevel());
+    snapshot.state = static_cast<unsigned char>(simulation.getState());
+    const Player& player = simulation.getPlayer();
+    snapshot.entities.push_back(quantize(player, ENTITY_PLAYER, player.velocity));
+    for (const auto& asteroid : simulation.getAsteroids())
+    {
+        snapshot.entities.push_back(quantize(asteroid, ENTITY_ASTEROID, asteroid.velocity));
+    }
+    for (const auto& bullet : simulation.getBullets())
+    {
+        snapshot.entities.push_back(quantize(bullet, ENTITY_BULLET, bullet.velocity));
+    }
+    for (const auto& remnant : simulation.getRemnants())
+    {
+        snapshot.entities.push_back(quantize(remnant, ENTITY_REMNANT, remnant.velocity));
+    }
+    return snapshot;
+}
+
+void Snapshot::encode(const Snapshot* baseline, BitWriter& writer) const
+{
+    writer.write(getChecksum(), 32);
+    writer.writeUnsigned(tick);
+    writer.writeUnsigned(level);
+    writer.write(state, 2);
+    // Every entity of the baseline is marked as removed, unchanged or changed
+    std::vector<Entity> emptyBaseline;
+    const std::vector<Entity>& previous = baseline != nullptr ? baseline->entities : emptyBaseline;
+    std::size_t current = 0;
+    for (const auto& entity : previous)
+    {
+        while (current < entities.size() && isBefore(entities[current], entity))
+        {
+            ++current;      // New entity, written after the baseline
+        }
+        bool kept = current < entities.size() && !isBefore(entity, entities[current]);
+        writer.write(kept ? 1 : 0, 1);
+        if (!kept)
+        {
+            continue;
+        }
+        const Entity& next = entities[current++];
+        unsigned int changes = (next.x != entity.x ? CHANGE_X : 0) | (next.y != entity.y ? CHANGE_Y : 0)
+            | (next.rotation != entity.rotation ? CHANGE_ROTATION : 0)
+            | (next.velocityX != entity.velocityX || next.velocityY != entity.velocityY ? CHANGE_VELOCITY : 0);
+        writer.write(changes, CHANGE_BITS);
+        if ((changes & CHANGE_X) != 0)
+        {
+            writer.writeSigned(static_cast<std::int64_t>(next.x) - entity.x);
+        }
+        if ((changes & CHANGE_Y) != 0)
+        {
+            writer.writeSigned(static_cast<std::int64_t>(next.y) - entity.y);
+        }
+        if ((changes & CHANGE_ROTATION) != 0)
+        {
+            // The shorter way around the circle
+            std::int64_t difference = static_cast<std::int64_t>(next.rotation) - entity.rotation;
+            const std::int64_t turn = std::int64_t(1) << ROTATION_BITS;
+            writer.writeSigned(difference > turn / 2 ? difference - turn : (difference < -turn / 2 ? difference + turn : difference));
+        }
+        if ((changes & CHANGE_VELOCITY) != 0)
+        {
+            writer.writeSigned(static_cast<std::int64_t>(next.velocityX) - entity.velocityX);
+            writer.writeSigned(static_cast<std::int64_t>(next.velocityY) - entity.velocityY);
+        }
+    }
+    // New entities, identifiers are written as differences from the previous new entity of the same type
+    std::vector<const Entity*> created;
+    std::size_t baselineIndex = 0;
+    for (const auto& entity : entities)
+    {
+        while (baselineIndex < previous.size() && isBefore(previous[baselineIndex], entity))
+        {
+            ++baselineIndex;
+        }
+        if (baselineIndex == previous.size() || isBefore(entity, previous[baselineIndex]))
+        {
+            created.push_back(&entity);
+        }
+    }
+    writer.writeUnsigned(created.size());
+    const Entity* last = nullptr;
+    for (const Entity* entity : created)
+    {
+        writer.write(entity->type, TYPE_BITS);
+        bool sameType = last != nullptr && last->type == entity->type;
+        writer.writeUnsigned(sameType ? entity->id - last->id : entity->id);
+        writeEntity(*entity, writer);
+        last = entity;
+    }
+}
+
+Snapshot Snapshot::decode(const Snapshot* baseline, BitReader& reader)
+{
+    Snapshot snapshot;
+    std::uint32_t checksum = static_cast<std::uint32_t>(reader.read(32));
+    snapshot.tick = reader.readUnsigned();
+    snapshot.level = static_cast<std::uint32_t>(reader.readUnsigned());
+    snapshot.state = static_cast<unsigned char>(reader.read(2));
+    if (baseline != nullptr)
+    {
+        for (const auto& entity : baseline->entities)
+        {
+            if (reader.read(1) == 0)
+            {
+                continue;
+            }
+            Entity next = entity;
+            unsigned int changes = static_cast<unsigned int>(reader.read(CHANGE_BITS));
+            if ((changes & CHANGE_X) != 0)
+            {
+                next.x = static_cast<std::int32_t>(entity.x + reader.readSigned());
+            }
+            if ((changes & CHANGE_Y) != 0)
+            {
+                next.y = static_cast<std::int32_t>(entity.y + reader.readSigned());
+            }
+            if ((changes & CHANGE_ROTATION) != 0)
+            {
+                const std::int64_t turn = std::int64_t(1) << ROTATION_BITS;
+                next.rotation = static_cast<std::uint32_t>(((entity.rotation + reader.readSigned()) % turn + turn) % turn);
+            }
+            if ((changes & CHANGE_VELOCITY) != 0)
+            {
+                next.velocityX = static_cast<std::int32_t>(entity.velocityX + reader.readSigned());
+                next.velocityY = static_cast<std::int32_t>(entity.velocityY + reader.readSigned());
+            }
+            snapshot.entities.push_back(next);
+        }
+    }
+    std::uint64_t createdCount = reader.readUnsigned();
+    std::size_t keptCount = snapshot.entities.size();
+    for (std::uint64_t i = 0; i < createdCount; i++)
+    {
+        unsigned char type = static_cast<unsigned char>(reader.read(TYPE_BITS));
+        std::uint64_t id = reader.readUnsigned();
+        if (i > 0 && snapshot.entities.back().type == type)
+        {
+            id += snapshot.entities.back().id;
+        }
+        Entity entity = readEntity(reader);
+        entity.type = type;
+        entity.id = id;
+        snapshot.entities.push_back(entity);
+    }
+    std::inplace_merge(snapshot.entities.begin(), snapshot.entities.begin() + keptCount, snapshot.entities.end(), isBefore);
+    if (snapshot.getChecksum() != checksum)
+    {
+        throw std::runtime_error("Snapshot does not match its checksum.");
+    }
+    return snapshot;
+}
+
+std::uint32_t Snapshot::getChecksum() const
+{
+    // FNV-1a over the quantized values
+    std::uint32_t hash = 2166136261u;
+    auto add = [&hash](std::uint64_t value)
+    {
+        for (unsigned int i = 0; i < 8; i++)
+        {
+            hash = (hash ^ static_cast<unsigned char>(value >> (8 * i))) * 16777619u;
+        }
+    };
+    add(tick);
+    add(level);
+    add(state);
+    for (const auto& entity : entities)
+    {
+        add(entity.id);
+        add(entity.type);
+        add(static_cast<std::uint32_t>(entity.x));
+        add(static_cast<std::uint32_t>(entity.y));
+        add(entity.rotation);
+        add(static_cast<std::uint32_t>(entity.velocityX));
+        add(static_cast<std::uint32_t>(entity.velocityY));
+    }
+    return hash;
+}
+
+float Snapshot::getPosition(std::int32_t value)
+{
+    return static_cast<float>(value) / POSITION_SCALE;
+}
+
+float Snapshot::getVelocity(std::int32_t value)
+{
+    return static_cast<float>(value) / VELOCITY_SCALE;
+}
+
+float Snapshot::getRotation(std::uint32_t value)
+{
+    return static_cast<float>(value) * 360.0f / static_cast<float>(1u << ROTATION_BITS);
+}
+
+Snapshot::Entity Snapshot::quantize(const GameObject& object, EntityType type, glm::vec2 velocity)
+{
+    const float turn = static_cast<float>(1u << ROTATION_BITS);
+    float rotation = std::fmod(object.rotation / 360.0f, 1.0f);
+    Entity entity;
+    entity.id = object.id;
+    entity.type = type;
+    entity.x = static_cast<std::int32_t>(std::lround(object.position.x * POSITION_SCALE));
+    entity.y = static_cast<std::int32_t>(std::lround(object.position.y * POSITION_SCALE));
+    entity.rotation = static_cast<std::uint32_t>(std::lround((rotation < 0.0f ? rotation + 1.0f : rotation) * turn)) & ((1u << ROTATION_BITS) - 1);
+    entity.velocityX = static_cast<std::int32_t>(std::lround(velocity.x * VELOCITY_SCALE));
+    entity.velocityY = static_cast<std::int32_t>(std::lround(velocity.y * VELOCITY_SCALE));
+    return entity;
+}
+
+bool Snapshot::isBefore(const Entity& entity1, const Entity& entity2)
+{
+    return entity1.type != entity2.type ? entity1.type < entity2.type : entity1.id < entity2.id;
+}
+
+void Snapshot::writeEntity(const Entity& entity, BitWriter& writer)
+{
+    writer.writeSigned(entity.x);
+    writer.writeSigned(entity.y);
+    writer.write(entity.rotation, ROTATION_BITS);
+    writer.writeSigned(entity.velocityX);
+    writer.writeSigned(entity.velocityY);
+}
+
+Snapshot::Entity Snapshot::readEntity(BitReader& reader)
+{
+    Entity entity;
+    entity.x = static_cast<std::int32_t>(reader.readSigned());
+    entity.y = static_cast<std::int32_t>(reader.readSigned());
+    entity.rotation = static_cast<std::uint32_t>(reader.read(ROTATION_BITS));
+    entity.velocityX = static_cast<std::int32_t>(reader.readSigned());
+    entity.velocityY = static_cast<std::int32_t>(reader.readSigned());
+    return entity;
+}
\ No newline at end of file
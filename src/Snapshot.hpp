@@ -0,0 +1,91 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include "Simulation.hpp"
+#include "Serialization.hpp"
+#include "Timer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+* State of the simulation visible to a client, with positions, angles and velocities quantized to integers.
+* A snapshot is encoded as a delta against a baseline snapshot the client already has: only removed objects,
+* changed values (as differences of quantized values) and new objects are written, packed into bits.
+* Without a baseline all objects are written as new.
+*/
+class Snapshot final
+{
+public:
+    enum EntityType : unsigned char
+    {
+        ENTITY_PLAYER,
+        ENTITY_ASTEROID,
+        ENTITY_BULLET,
+        ENTITY_REMNANT
+    };
+
+    // Quantized state of one object. Entities are ordered by type and identifier.
+    struct Entity
+    {
+        std::uint64_t id;
+        unsigned char type;
+        std::int32_t x;             // Position in 1/16 of a unit
+        std::int32_t y;
+        std::uint32_t rotation;     // Angle in 1/4096 of a full turn
+        std::int32_t velocityX;     // Velocity in 1/8 of a unit per second
+        std::int32_t velocityY;
+    };
+
+    // Resolution of quantized values
+    static const int POSITION_SCALE = 16;
+    static const unsigned int ROTATION_BITS = 12;
+    static const int VELOCITY_SCALE = 8;
+
+    Tick tick;
+    std::uint32_t level;
+    unsigned char state;        // Value of Simulation::State
+    std::vector<Entity> entities;
+
+    Snapshot();
+
+    // Quantize the current state of the simulation.
+    static Snapshot capture(const Simulation& simulation);
+
+    // Write the snapshot as a delta against the baseline, which may be null.
+    void encode(const Snapshot* baseline, BitWriter& writer) const;
+
+    // Read a snapshot written by encode with the same baseline. Throws std::runtime_error if the data
+    // are damaged or the baseline is not the one used by encode (detected by a checksum).
+    static Snapshot decode(const Snapshot* baseline, BitReader& reader);
+
+    // Get hash of all values of the snapshot.
+    std::uint32_t getChecksum() const;
+
+    // Quantize the state of one object.
+    static Entity quantize(const GameObject& object, EntityType type, glm::vec2 velocity);
+
+    // Check if the first entity is ordered before the second one in snapshots.
+    static bool isBefore(const Entity& entity1, const Entity& entity2);
+
+    // Get the position or velocity in units of the game.
+    static float getPosition(std::int32_t value);
+    static float getVelocity(std::int32_t value);
+    static float getRotation(std::uint32_t value);
+
+private:
+    // Bits of the mask of changed values of an entity
+    static const unsigned int CHANGE_X = 1 << 0;
+    static const unsigned int CHANGE_Y = 1 << 1;
+    static const unsigned int CHANGE_ROTATION = 1 << 2;
+    static const unsigned int CHANGE_VELOCITY = 1 << 3;
+
+    static const unsigned int CHANGE_BITS = 4;
+    static const unsigned int TYPE_BITS = 2;
+
+    static void writeEntity(const Entity& entity, BitWriter& writer);
+    static Entity readEntity(BitReader& reader);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "SpatialGrid.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+SpatialGrid::SpatialGrid() : m_area(1.0f), m_cellSize(1.0f), m_columns(1), m_rows(1), m_cellStarts(2, 0)
+{
+}
+
+void SpatialGrid::reset(glm::vec2 area, float cellSize)
+{
+    if (cellSize <= 0.0f || area.x <= 0.0f || area.y <= 0.0f)
+    {
+        throw std::logic_error("Spatial grid requires a positive area and size of cells.");
+    }
+    m_area = area;
+    m_columns = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(std::ceil(area.x / cellSize)));
+    m_rows = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(std::ceil(area.y / cellSize)));
+    m_cellSize = area / glm::vec2(static_cast<float>(m_columns), static_cast<float>(m_rows));
+    m_pending.clear();
+    m_entries.clear();
+    m_cellStarts.assign(static_cast<std::size_t>(m_columns) * m_rows + 1, 0);
+}
+
+void SpatialGrid::add(glm::vec2 position, Entry entry)
+{
+    std::uint32_t column = getCell(position.x, m_cellSize.x, m_columns);
+    std::uint32_t row = getCell(position.y, m_cellSize.y, m_rows);
+    m_pending.push_back(PendingEntry{ row * m_columns + column, entry });
+}
+
+void SpatialGrid::build()
+{
+    // Counting sort: count entries of cells, compute where each cell starts and place the entries
+    std::fill(m_cellStarts.begin(), m_cellStarts.end(), 0);
+    for (const auto& pending : m_pending)
+    {
+        ++m_cellStarts[pending.cell + 1];
+    }
+    for (std::size_t i = 1; i < m_cellStarts.size(); i++)
+    {
+        m_cellStarts[i] += m_cellStarts[i - 1];
+    }
+    m_entries.resize(m_pending.size());
+    for (const auto& pending : m_pending)
+    {
+        m_entries[m_cellStarts[pending.cell]++] = pending.entry;
+    }
+    // Placing moved every start to the start of the next cell
+    for (std::size_t i = m_cellStarts.size() - 1; i > 0; i--)
+    {
+        m_cellStarts[i] = m_cellStarts[i - 1];
+    }
+    m_cellStarts[0] = 0;
+    m_pending.clear();
+}
+
+glm::vec2 SpatialGrid::getOffset(glm::vec2 from, glm::vec2 to) const
+{
+    glm::vec2 offset = to - from;
+    offset -= m_area * glm::vec2(std::round(offset.x / m_area.x), std::round(offset.y / m_area.y));
+    return offset;
+}
+
+std::size_t SpatialGrid::getEntryCount() const
+{
+    return m_entries.size();
+}
+
+std::uint32_t SpatialGrid::getCell(float coordinate, float cellSize, std::uint32_t count)
+{
+    std::int64_t cell = static_cast<std::int64_t>(std::floor(coordinate / cellSize)) % static_cast<std::int64_t>(count);
+    return static_cast<std::uint32_t>(cell < 0 ? cell + count : cell);
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef SPATIAL_GRID_HPP
+#define SPATIAL_GRID_HPP
+
+#include <glm/vec2.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+* Uniform grid of cells over a wrapping area, used for finding objects near a point.
+* Entries are added and then sorted into cells at once by counting, so rebuilding the grid every update
+* is cheap and the entries of a cell are stored next to each other. Queries visit only the cells
+* overlapping the queried square, cells on the other side of the area are visited across its edges.
+*/
+class SpatialGrid final
+{
+public:
+    // Value stored for an object, for example its type and index.
+    using Entry = std::uint32_t;
+
+    SpatialGrid();
+
+    // Remove all entries and set the area and the largest size of cells. Cells are made slightly smaller
+    // if needed, so a whole number of them covers the area.
+    void reset(glm::vec2 area, float cellSize);
+
+    // Add an entry at the position, it is not found by queries until build is called.
+    void add(glm::vec2 position, Entry entry);
+
+    // Sort added entries into cells.
+    void build();
+
+    // Call function(entry) for all entries in cells overlapping the square around the center.
+    template<typename F>
+    void query(glm::vec2 center, float halfSize, F function) const;
+
+    // Get the shortest vector from a point to another one in the wrapping area.
+    glm::vec2 getOffset(glm::vec2 from, glm::vec2 to) const;
+
+    std::size_t getEntryCount() const;
+
+private:
+    struct PendingEntry
+    {
+        std::uint32_t cell;
+        Entry entry;
+    };
+
+    glm::vec2 m_area;
+    glm::vec2 m_cellSize;
+    std::uint32_t m_columns;
+    std::uint32_t m_rows;
+    std::vector<PendingEntry> m_pending;
+    std::vector<std::uint32_t> m_cellStarts;    // Index of the first entry of each cell, one more for the end
+    std::vector<Entry> m_entries;               // Entries ordered by cells
+
+    // Get index of the column or row containing the coordinate, coordinates outside of the area are wrapped.
+    static std::uint32_t getCell(float coordinate, float cellSize, std::uint32_t count);
+};
+
+template<typename F>
+void SpatialGrid::query(glm::vec2 center, float halfSize, F function) const
+{
+    // Cells are counted from the lowest coordinate of the square, the count is limited to the whole grid
+    std::uint32_t columns = std::min<std::uint32_t>(m_columns, static_cast<std::uint32_t>(
+        std::floor((center.x + halfSize) / m_cellSize.x) - std::floor((center.x - halfSize) / m_cellSize.x)) + 1);
+    std::uint32_t rows = std::min<std::uint32_t>(m_rows, static_cast<std::uint32_t>(
+        std::floor((center.y + halfSize) / m_cellSize.y) - std::floor((center.y - halfSize) / m_cellSize.y)) + 1);
+    std::uint32_t firstColumn = getCell(center.x - halfSize, m_cellSize.x, m_columns);
+    std::uint32_t firstRow = getCell(center.y - halfSize, m_cellSize.y, m_rows);
+    for (std::uint32_t row = 0; row < rows; row++)
+    {
+        std::uint32_t rowStart = ((firstRow + row) % m_rows) * m_columns;
+        for (std::uint32_t column = 0; column < columns; column++)
+        {
+            std::uint32_t cell = rowStart + (firstColumn + column) % m_columns;
+            for (std::uint32_t i = m_cellStarts[cell]; i < m_cellStarts[cell + 1]; i++)
+            {
+                function(m_entries[i]);
+            }
+        }
+    }
+}
+
+#endif
\ No newline at end of file
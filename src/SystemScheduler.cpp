@@ -0,0 +1,83 @@
+#include "SystemScheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+SystemScheduler::SystemScheduler() : m_phasesValid(false)
+{
+}
+
+void SystemScheduler::addSystem(const std::string& name, DataMask reads, DataMask writes, System system)
+{
+    m_entries.push_back(Entry{ name, reads, writes, std::move(system) });
+    m_phasesValid = false;
+}
+
+void SystemScheduler::run(JobSystem& jobs)
+{
+    buildPhases();
+    for (const auto& phase : m_phases)
+    {
+        if (phase.size() == 1)
+        {
+            m_entries[phase.front()].system();
+            continue;
+        }
+        JobSystem::Group group;
+        for (std::size_t i = 1; i < phase.size(); i++)
+        {
+            jobs.submit(group, m_entries[phase[i]].system);
+        }
+        m_entries[phase.front()].system();
+        jobs.wait(group);
+    }
+}
+
+std::vector<std::vector<std::string>> SystemScheduler::getPhases()
+{
+    buildPhases();
+    std::vector<std::vector<std::string>> phases;
+    for (const auto& phase : m_phases)
+    {
+        std::vector<std::string> names;
+        for (std::size_t index : phase)
+        {
+            names.push_back(m_entries[index].name);
+        }
+        phases.push_back(names);
+    }
+    return phases;
+}
+
+void SystemScheduler::buildPhases()
+{
+    if (m_phasesValid)
+    {
+        return;
+    }
+    m_phases.clear();
+    std::vector<std::size_t> entryPhases;
+    for (std::size_t i = 0; i < m_entries.size(); i++)
+    {
+        std::size_t phase = 0;
+        for (std::size_t j = 0; j < i; j++)
+        {
+            if (conflict(m_entries[i], m_entries[j]))
+            {
+                phase = std::max(phase, entryPhases[j] + 1);
+            }
+        }
+        entryPhases.push_back(phase);
+        if (phase == m_phases.size())
+        {
+            m_phases.emplace_back();
+        }
+        m_phases[phase].push_back(i);
+    }
+    m_phasesValid = true;
+}
+
+bool SystemScheduler::conflict(const Entry& entry1, const Entry& entry2)
+{
+    return (entry1.writes & (entry2.reads | entry2.writes)) != 0 || (entry2.writes & entry1.reads) != 0;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef SYSTEM_SCHEDULER_HPP
+#define SYSTEM_SCHEDULER_HPP
+
+#include "JobSystem.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+* Runs systems (functions updating parts of the game) in the order they were added.
+* Every system declares which data it reads and writes as bit masks. Systems are grouped into phases,
+* a system runs in a later phase than every earlier system it conflicts with (one of them writes data
+* the other one accesses). Systems in the same phase run concurrently.
+*/
+class SystemScheduler final
+{
+public:
+    using DataMask = unsigned int;
+    using System = std::function<void()>;
+
+    SystemScheduler();
+
+    // Add a system accessing the given data.
+    void addSystem(const std::string& name, DataMask reads, DataMask writes, System system);
+
+    // Run all systems and wait until they finish.
+    void run(JobSystem& jobs);
+
+    // Get names of systems grouped by phases.
+    std::vector<std::vector<std::string>> getPhases();
+
+private:
+    struct Entry
+    {
+        std::string name;
+        DataMask reads;
+        DataMask writes;
+        System system;
+    };
+
+    std::vector<Entry> m_entries;
+    std::vector<std::vector<std::size_t>> m_phases;     // Indices of entries in each phase
+    bool m_phasesValid;
+
+    void buildPhases();
+    static bool conflict(const Entry& entry1, const Entry& entry2);
+};
+
+#endif
\ No newline at end of file
@@ -1,19 +1,25 @@
 #include "Timer.hpp"
 
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
+Timer::Timer() : m_endTick(0)
+{
+}
 
-Timer::Timer() : m_duration(0.0), m_startTime(0.0)
+void Timer::start(Tick now, Tick duration)
 {
+    m_endTick = now + duration;
 }
 
-void Timer::start(double duration)
+bool Timer::finished(Tick now) const
 {
-    m_duration = duration;
-    m_startTime = glfwGetTime();
+    return m_endTick <= now;
 }
 
-bool Timer::finished() const
+void Timer::save(BinaryWriter& writer) const
 {
-    return m_startTime + m_duration <= glfwGetTime();
+    writer.write(m_endTick);
 }
+
+void Timer::load(BinaryReader& reader)
+{
+    reader.read(m_endTick);
+}
\ No newline at end of file
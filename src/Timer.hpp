@@ -1,23 +1,35 @@
 #ifndef TIMER_HPP
 #define TIMER_HPP
 
+#include "Serialization.hpp"
+
+#include <cstdint>
+
+// Number of fixed updates of the simulation.
+using Tick = std::uint64_t;
+
 /**
-* Timer that can be used as stopwatch.
+* Timer measuring time in simulation ticks.
+* The current tick is passed by the caller, so the timer never reads the clock
+* and finishes at the same update in every run.
 */
 class Timer final
 {
 public:
     Timer();
 
-    // Set duration and start measuring time.
-    void start(double duration);
+    // Set duration in ticks and start measuring time from the given tick.
+    void start(Tick now, Tick duration);
+
+    // Check if the set time is up at the given tick.
+    bool finished(Tick now) const;
 
-    // Check if the set time is up.
-    bool finished() const;
+    // Write the state of the timer / read the state written by save.
+    void save(BinaryWriter& writer) const;
+    void load(BinaryReader& reader);
 
 private:
-    double m_duration;
-    double m_startTime;
+    Tick m_endTick;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "TimingWheel.hpp"
+
+#include <utility>
+
+TimingWheel::TimingWheel() : m_currentTick(0), m_size(0)
+{
+}
+
+void TimingWheel::clear(Tick now)
+{
+    for (auto&& level : m_levels)
+    {
+        for (auto&& slot : level)
+        {
+            slot.clear();
+        }
+    }
+    m_overflow.clear();
+    m_currentTick = now;
+    m_size = 0;
+}
+
+void TimingWheel::schedule(Id id, Tick expiration)
+{
+    if (expiration <= m_currentTick)
+    {
+        expiration = m_currentTick + 1;
+    }
+    insert(Entry{ id, expiration });
+    ++m_size;
+}
+
+void TimingWheel::advance(std::vector<Id>& expired)
+{
+    ++m_currentTick;
+    // Slots are cascaded from the highest level, so their entries can fall into slots cascaded afterwards
+    const Tick rangeMask = (Tick(1) << (SLOT_BITS * LEVEL_COUNT)) - 1;
+    if ((m_currentTick & rangeMask) == 0)
+    {
+        cascade(m_overflow, expired);
+    }
+    for (std::size_t level = LEVEL_COUNT - 1; level > 0; level--)
+    {
+        const Tick levelMask = (Tick(1) << (SLOT_BITS * level)) - 1;
+        if ((m_currentTick & levelMask) == 0)
+        {
+            std::size_t slot = (m_currentTick >> (SLOT_BITS * level)) & (SLOT_COUNT - 1);
+            cascade(m_levels[level][slot], expired);
+        }
+    }
+    Slot& slot = m_levels[0][m_currentTick & (SLOT_COUNT - 1)];
+    for (const auto& entry : slot)
+    {
+        expired.push_back(entry.id);
+    }
+    m_size -= slot.size();
+    slot.clear();
+}
+
+Tick TimingWheel::getCurrentTick() const
+{
+    return m_currentTick;
+}
+
+std::size_t TimingWheel::size() const
+{
+    return m_size;
+}
+
+void TimingWheel::save(BinaryWriter& writer) const
+{
+    writer.write(m_currentTick);
+    writer.write(static_cast<std::uint64_t>(m_size));
+    for (const auto& level : m_levels)
+    {
+        for (const auto& slot : level)
+        {
+            for (const auto& entry : slot)
+            {
+                writer.write(entry);
+            }
+        }
+    }
+    for (const auto& entry : m_overflow)
+    {
+        writer.write(entry);
+    }
+}
+
+void TimingWheel::load(BinaryReader& reader)
+{
+    clear(reader.read<Tick>());
+    // Timers are inserted relative to the loaded tick, so they may end up on lower levels than before saving
+    std::uint64_t count = reader.read<std::uint64_t>();
+    for (std::uint64_t i = 0; i < count; i++)
+    {
+        insert(reader.read<Entry>());
+    }
+    m_size = static_cast<std::size_t>(count);
+}
+
+void TimingWheel::insert(const Entry& entry)
+{
+    // The level is given by the highest bit in which the expiration differs from the current tick
+    Tick difference = entry.expiration ^ m_currentTick;
+    for (std::size_t level = 0; level < LEVEL_COUNT; level++)
+    {
+        if (difference < (Tick(1) << (SLOT_BITS * (level + 1))))
+        {
+            std::size_t slot = (entry.expiration >> (SLOT_BITS * level)) & (SLOT_COUNT - 1);
+            m_levels[level][slot].push_back(entry);
+            return;
+        }
+    }
+    m_overflow.push_back(entry);
+}
+
+void TimingWheel::cascade(Slot& slot, std::vector<Id>& expired)
+{
+    std::swap(slot, m_cascaded);
+    for (const auto& entry : m_cascaded)
+    {
+        if (entry.expiration == m_currentTick)
+        {
+            expired.push_back(entry.id);
+            --m_size;
+        }
+        else
+        {
+            insert(entry);
+        }
+    }
+    m_cascaded.clear();
+}
\ No newline at end of file
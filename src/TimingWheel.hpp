@@ -0,0 +1,69 @@
+#ifndef TIMING_WHEEL_HPP
+#define TIMING_WHEEL_HPP
+
+#include "Timer.hpp"
+#include "Serialization.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+* Hierarchical timing wheel reporting timers that expire at each tick.
+* Every level has 64 slots, a slot of level L covers 64^L ticks. A timer is stored at the lowest level
+* whose slot can hold it and moves one level down each time the wheel reaches the start of its slot,
+* so scheduling is O(1) and every timer is touched at most once per level before it expires.
+* Timers too far in the future wait in an overflow list.
+*/
+class TimingWheel final
+{
+public:
+    // Identifier of the owner of a timer, reported on expiration.
+    using Id = std::uint64_t;
+
+    TimingWheel();
+
+    // Remove all timers and set the current tick.
+    void clear(Tick now);
+
+    // Add a timer expiring at the given tick. Timers expiring at the current tick or earlier expire at the next tick.
+    void schedule(Id id, Tick expiration);
+
+    // Advance the wheel by one tick and append identifiers of timers expiring at the new tick to expired.
+    void advance(std::vector<Id>& expired);
+
+    // Get the tick the wheel has advanced to.
+    Tick getCurrentTick() const;
+
+    // Get number of scheduled timers that have not expired yet.
+    std::size_t size() const;
+
+    // Write the current tick and all timers / read them as written by save.
+    void save(BinaryWriter& writer) const;
+    void load(BinaryReader& reader);
+
+private:
+    static const unsigned int SLOT_BITS = 6;
+    static const std::size_t SLOT_COUNT = std::size_t(1) << SLOT_BITS;
+    static const std::size_t LEVEL_COUNT = 4;
+
+    struct Entry
+    {
+        Id id;
+        Tick expiration;
+    };
+
+    using Slot = std::vector<Entry>;
+
+    std::array<std::array<Slot, SLOT_COUNT>, LEVEL_COUNT> m_levels;
+    Slot m_overflow;        // Timers beyond the range of the highest level
+    Slot m_cascaded;        // Entries of the slot being moved to lower levels, kept to reuse memory
+    Tick m_currentTick;
+    std::size_t m_size;
+
+    void insert(const Entry& entry);
+    void cascade(Slot& slot, std::vector<Id>& expired);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "Transport.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+Transport::~Transport()
+{
+}
+
+LinkConditions::LinkConditions() : latency(0.0), jitter(0.0), loss(0.0)
+{
+}
+
+LinkConditions::LinkConditions(double latency, double jitter, double loss) : latency(latency), jitter(jitter), loss(loss)
+{
+}
+
+std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>> LoopbackTransport::createPair(
+    std::shared_ptr<Clock> clock, const LinkConditions& conditions, std::uint64_t seed)
+{
+    if (!clock)
+    {
+        throw std::logic_error("Loopback transport requires a clock.");
+    }
+    auto queue1 = std::make_shared<Queue>();
+    auto queue2 = std::make_shared<Queue>();
+    std::unique_ptr<LoopbackTransport> end1(new LoopbackTransport(clock, conditions, seed, 1, queue1, queue2));
+    std::unique_ptr<LoopbackTransport> end2(new LoopbackTransport(clock, conditions, seed, 2, queue2, queue1));
+    return std::make_pair(std::move(end1), std::move(end2));
+}
+
+LoopbackTransport::LoopbackTransport(std::shared_ptr<Clock> clock, const LinkConditions& conditions, std::uint64_t seed,
+    std::uint64_t stream, std::shared_ptr<Queue> outgoing, std::shared_ptr<Queue> incoming)
+    : m_clock(std::move(clock)), m_conditions(conditions), m_random(seed, stream), m_outgoing(std::move(outgoing)),
+    m_incoming(std::move(incoming)), m_sentCount(0), m_lostCount(0)
+{
+}
+
+void LoopbackTransport::send(const std::vector<unsigned char>& packet)
+{
+    ++m_sentCount;
+    if (m_random.getFloat() < m_conditions.loss)
+    {
+        ++m_lostCount;
+        return;
+    }
+    double deliveryTime = m_clock->getTime() + m_conditions.latency + m_conditions.jitter * m_random.getFloat();
+    std::lock_guard<std::mutex> lock(m_outgoing->mutex);
+    m_outgoing->packets.push(Packet{ deliveryTime, m_sentCount, packet });
+}
+
+bool LoopbackTransport::receive(std::vector<unsigned char>& packet)
+{
+    std::lock_guard<std::mutex> lock(m_incoming->mutex);
+    if (m_incoming->packets.empty() || m_incoming->packets.top().deliveryTime > m_clock->getTime())
+    {
+        return false;
+    }
+    packet = m_incoming->packets.top().bytes;
+    m_incoming->packets.pop();
+    return true;
+}
+
+std::uint64_t LoopbackTransport::getSentCount() const
+{
+    return m_sentCount;
+}
+
+std::uint64_t LoopbackTransport::getLostCount() const
+{
+    return m_lostCount;
+}
+
+bool LoopbackTransport::Packet::operator>(const Packet& other) const
+{
+    if (deliveryTime != other.deliveryTime)
+    {
+        return deliveryTime > other.deliveryTime;
+    }
+    return sequence > other.sequence;
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef TRANSPORT_HPP
+#define TRANSPORT_HPP
+
+#include "Clock.hpp"
+#include "Random.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+/**
+* Unreliable channel sending packets to one peer.
+* Packets may be delayed, reordered or lost, but a delivered packet is never damaged.
+*/
+class Transport
+{
+public:
+    virtual ~Transport();
+
+    // Send the packet to the peer.
+    virtual void send(const std::vector<unsigned char>& packet) = 0;
+
+    // Get the next received packet. Returns false if no packet is waiting.
+    virtual bool receive(std::vector<unsigned char>& packet) = 0;
+};
+
+/**
+* Properties of a simulated network link.
+*/
+struct LinkConditions final
+{
+    double latency;     // One-way delay in seconds
+    double jitter;      // Maximal random delay added to the latency in seconds
+    double loss;        // Probability that a packet is lost
+
+    LinkConditions();
+    LinkConditions(double latency, double jitter, double loss);
+};
+
+/**
+* Transport between two peers in one process with simulated latency, jitter and packet loss.
+* Time of delivery is read from a clock, so a link driven by a manual clock behaves the same in every run.
+* Both ends of a link are thread-safe and can be used from different threads.
+*/
+class LoopbackTransport final : public Transport
+{
+public:
+    // Create both ends of a link, packets in each direction are delayed and lost independently.
+    static std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>> createPair(
+        std::shared_ptr<Clock> clock, const LinkConditions& conditions, std::uint64_t seed = 1);
+
+    void send(const std::vector<unsigned char>& packet) override;
+    bool receive(std::vector<unsigned char>& packet) override;
+
+    // Get number of packets sent from this end and number of them that were lost.
+    std::uint64_t getSentCount() const;
+    std::uint64_t getLostCount() const;
+
+private:
+    struct Packet
+    {
+        double deliveryTime;
+        std::uint64_t sequence;     // Orders packets delivered at the same time
+        std::vector<unsigned char> bytes;
+
+        bool operator>(const Packet& other) const;
+    };
+
+    // Packets travelling in one direction
+    struct Queue
+    {
+        std::mutex mutex;
+        std::priority_queue<Packet, std::vector<Packet>, std::greater<Packet>> packets;
+    };
+
+    std::shared_ptr<Clock> m_clock;
+    LinkConditions m_conditions;
+    rnd::Generator m_random;
+    std::shared_ptr<Queue> m_outgoing;
+    std::shared_ptr<Queue> m_incoming;
+    std::uint64_t m_sentCount;
+    std::uint64_t m_lostCount;
+
+    LoopbackTransport(std::shared_ptr<Clock> clock, const LinkConditions& conditions, std::uint64_t seed, std::uint64_t stream,
+        std::shared_ptr<Queue> outgoing, std::shared_ptr<Queue> incoming);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "UdpSocket.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+#include <tuple>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef _WIN32
+    // Winsock must be initialized before the first socket is opened.
+    void initializeSockets()
+    {
+        static bool initialized = false;
+        if (!initialized)
+        {
+            WSADATA data;
+            if (WSAStartup(MAKEWORD(2, 2), &data) != 0)
+            {
+                throw std::runtime_error("Failed to initialize Winsock.");
+            }
+            initialized = true;
+        }
+    }
+
+    void closeSocket(std::uintptr_t handle)
+    {
+        closesocket(static_cast<SOCKET>(handle));
+    }
+
+    const std::uintptr_t INVALID_HANDLE = static_cast<std::uintptr_t>(INVALID_SOCKET);
+#else
+    void initializeSockets()
+    {
+    }
+
+    void closeSocket(int handle)
+    {
+        close(handle);
+    }
+
+    const int INVALID_HANDLE = -1;
+#endif
+}
+
+NetAddress::NetAddress() : host(0), port(0)
+{
+}
+
+NetAddress::NetAddress(std::uint32_t host, std::uint16_t port) : host(host), port(port)
+{
+}
+
+NetAddress NetAddress::parse(const std::string& text)
+{
+    unsigned int a, b, c, d, port;
+    char end;
+    if (std::sscanf(text.c_str(), "%u.%u.%u.%u:%u%c", &a, &b, &c, &d, &port, &end) != 5
+        || a > 255 || b > 255 || c > 255 || d > 255 || port > 65535)
+    {
+        throw std::runtime_error("'" + text + "' is not a valid address.");
+    }
+    return NetAddress((a << 24) | (b << 16) | (c << 8) | d, static_cast<std::uint16_t>(port));
+}
+
+std::string NetAddress::toString() const
+{
+    return std::to_string(host >> 24) + "." + std::to_string((host >> 16) & 0xFF) + "."
+        + std::to_string((host >> 8) & 0xFF) + "." + std::to_string(host & 0xFF) + ":" + std::to_string(port);
+}
+
+bool NetAddress::operator==(const NetAddress& other) const
+{
+    return host == other.host && port == other.port;
+}
+
+bool NetAddress::operator<(const NetAddress& other) const
+{
+    return std::tie(host, port) < std::tie(other.host, other.port);
+}
+
+UdpSocket::UdpSocket(std::uint16_t port) : m_handle(INVALID_HANDLE), m_port(0)
+{
+    initializeSockets();
+    m_handle = static_cast<Handle>(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+    if (m_handle == INVALID_HANDLE)
+    {
+        throw std::runtime_error("Failed to open a UDP socket.");
+    }
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    socklen_t length = sizeof(address);
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    bool configured = ioctlsocket(static_cast<SOCKET>(m_handle), FIONBIO, &nonBlocking) == 0;
+#else
+    bool configured = fcntl(m_handle, F_SETFL, fcntl(m_handle, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+    if (!configured || bind(m_handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || getsockname(m_handle, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+    {
+        closeSocket(m_handle);
+        throw std::runtime_error("Failed to bind a UDP socket to port " + std::to_string(port) + ".");
+    }
+    m_port = ntohs(address.sin_port);
+}
+
+UdpSocket::~UdpSocket()
+{
+    closeSocket(m_handle);
+}
+
+void UdpSocket::send(const NetAddress& address, const std::vector<unsigned char>& packet)
+{
+    sockaddr_in target = {};
+    target.sin_family = AF_INET;
+    target.sin_addr.s_addr = htonl(address.host);
+    target.sin_port = htons(address.port);
+    sendto(m_handle, reinterpret_cast<const char*>(packet.data()), static_cast<int>(packet.size()), 0,
+        reinterpret_cast<const sockaddr*>(&target), sizeof(target));
+}
+
+bool UdpSocket::receive(std::vector<unsigned char>& packet, NetAddress& sender)
+{
+    packet.resize(MAX_PACKET_SIZE);
+    sockaddr_in source = {};
+    socklen_t length = sizeof(source);
+    auto size = recvfrom(m_handle, reinterpret_cast<char*>(packet.data()), static_cast<int>(packet.size()), 0,
+        reinterpret_cast<sockaddr*>(&source), &length);
+    if (size < 0)
+    {
+        packet.clear();
+        return false;
+    }
+    packet.resize(static_cast<std::size_t>(size));
+    sender = NetAddress(ntohl(source.sin_addr.s_addr), ntohs(source.sin_port));
+    return true;
+}
+
+std::uint16_t UdpSocket::getPort() const
+{
+    return m_port;
+}
+
+UdpTransport::UdpTransport(std::uint16_t localPort, const NetAddress& peer) : m_socket(localPort), m_peer(peer)
+{
+}
+
+void UdpTransport::send(const std::vector<unsigned char>& packet)
+{
+    m_socket.send(m_peer, packet);
+}
+
+bool UdpTransport::receive(std::vector<unsigned char>& packet)
+{
+    NetAddress sender;
+    while (m_socket.receive(packet, sender))
+    {
+        if (sender == m_peer)
+        {
+            return true;
+        }
+    }
+    return false;
+}
\ No newline at end of file
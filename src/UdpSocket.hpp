@@ -0,0 +1,83 @@
+#ifndef UDP_SOCKET_HPP
+#define UDP_SOCKET_HPP
+
+#include "Transport.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+* IPv4 address and port, both in host byte order.
+*/
+struct NetAddress final
+{
+    std::uint32_t host;
+    std::uint16_t port;
+
+    NetAddress();
+    NetAddress(std::uint32_t host, std::uint16_t port);
+
+    // Parse address in form 'a.b.c.d:port'. Throws std::runtime_error if the text is not a valid address.
+    static NetAddress parse(const std::string& text);
+
+    std::string toString() const;
+
+    bool operator==(const NetAddress& other) const;
+    bool operator<(const NetAddress& other) const;
+};
+
+/**
+* Non-blocking UDP socket.
+*/
+class UdpSocket final
+{
+public:
+    // Open a socket bound to the given port on all interfaces, zero chooses a free port.
+    // Throws std::runtime_error if the socket cannot be opened.
+    explicit UdpSocket(std::uint16_t port = 0);
+
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    ~UdpSocket();
+
+    // Send the packet. Packets that cannot be sent are dropped, as they could be by the network.
+    void send(const NetAddress& address, const std::vector<unsigned char>& packet);
+
+    // Get the next received packet and its sender. Returns false if no packet is waiting.
+    bool receive(std::vector<unsigned char>& packet, NetAddress& sender);
+
+    // Get the port the socket is bound to.
+    std::uint16_t getPort() const;
+
+private:
+    static const std::size_t MAX_PACKET_SIZE = 65536;
+
+#ifdef _WIN32
+    using Handle = std::uintptr_t;
+#else
+    using Handle = int;
+#endif
+
+    Handle m_handle;
+    std::uint16_t m_port;
+};
+
+/**
+* Transport sending packets over UDP to one peer, packets from other senders are ignored.
+*/
+class UdpTransport final : public Transport
+{
+public:
+    UdpTransport(std::uint16_t localPort, const NetAddress& peer);
+
+    void send(const std::vector<unsigned char>& packet) override;
+    bool receive(std::vector<unsigned char>& packet) override;
+
+private:
+    UdpSocket m_socket;
+    NetAddress m_peer;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include "VideoWriter.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    bool endsWith(const std::string& text, const std::string& suffix)
+    {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // Conversion of BT.601 with limited range in fixed point with 8 fractional bits
+    unsigned char getLuma(int r, int g, int b)
+    {
+        return static_cast<unsigned char>((66 * r + 129 * g + 25 * b + 128) / 256 + 16);
+    }
+
+    unsigned char getBlueChroma(int r, int g, int b)
+    {
+        return static_cast<unsigned char>((-38 * r - 74 * g + 112 * b + 128 + 128 * 256) / 256);
+    }
+
+    unsigned char getRedChroma(int r, int g, int b)
+    {
+        return static_cast<unsigned char>((112 * r - 94 * g - 18 * b + 128 + 128 * 256) / 256);
+    }
+}
+
+VideoWriter::VideoWriter(const std::string& path, unsigned int width, unsigned int height, unsigned int framesPerSecond,
+    std::size_t bufferCount)
+    : m_path(path), m_width(width), m_height(height), m_format(endsWith(path, ".y4m") ? Format::Y4m : Format::RawRgb),
+    m_file(path, std::ios::binary), m_buffers(bufferCount), m_repeatCounts(bufferCount, 1), m_finishing(false), m_failed(false), m_writtenCount(0), m_droppedCount(0)
+{
+    if (!m_file)
+    {
+        throw std::runtime_error("Failed to open video file '" + path + "'.");
+    }
+    if (m_format == Format::Y4m && (width % 2 != 0 || height % 2 != 0))
+    {
+        throw std::logic_error("Frames of Y4M videos with 4:2:0 chroma must have even size.");
+    }
+    if (m_format == Format::Y4m)
+    {
+        m_file << "YUV4MPEG2 W" << width << " H" << height << " F" << framesPerSecond << ":1 Ip A1:1 C420jpeg\n";
+    }
+    for (std::size_t i = 0; i < bufferCount; i++)
+    {
+        m_buffers[i].resize(static_cast<std::size_t>(width) * height * 4);
+        m_freeBuffers.push_back(i);
+    }
+    m_thread = std::thread(&VideoWriter::writerLoop, this);
+}
+
+VideoWriter::~VideoWriter()
+{
+    try
+    {
+        finish();
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+}
+
+bool VideoWriter::write(const unsigned char* pixels, std::size_t repeatCount)
+{
+    std::size_t buffer;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_freeBuffers.empty() || m_finishing)
+        {
+            m_droppedCount += repeatCount;
+            return false;
+        }
+        buffer = m_freeBuffers.back();
+        m_freeBuffers.pop_back();
+    }
+    // The buffer belongs to the caller until it is queued
+    std::copy(pixels, pixels + m_buffers[buffer].size(), m_buffers[buffer].begin());
+    m_repeatCounts[buffer] = repeatCount;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queuedBuffers.push_back(buffer);
+    }
+    m_condition.notify_one();
+    return true;
+}
+
+void VideoWriter::finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_finishing = true;
+    }
+    m_condition.notify_one();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+        m_file.close();
+    }
+    if (m_failed)
+    {
+        throw std::runtime_error("Failed to write video file '" + m_path + "'.");
+    }
+}
+
+VideoWriter::Format VideoWriter::getFormat() const
+{
+    return m_format;
+}
+
+std::size_t VideoWriter::getWrittenCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_writtenCount;
+}
+
+std::size_t VideoWriter::getDroppedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_droppedCount;
+}
+
+void VideoWriter::writerLoop()
+{
+    while (true)
+    {
+        std::size_t buffer;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_finishing || !m_queuedBuffers.empty(); });
+            if (m_queuedBuffers.empty())
+            {
+                return;     // Finishing and everything is written
+            }
+            buffer = m_queuedBuffers.front();
+            m_queuedBuffers.pop_front();
+        }
+        convert(m_buffers[buffer]);
+        for (std::size_t i = 0; i < m_repeatCounts[buffer]; i++)
+        {
+            if (m_format == Format::Y4m)
+            {
+                m_file << "FRAME\n";
+            }
+            m_file.write(reinterpret_cast<const char*>(m_output.data()), static_cast<std::streamsize>(m_output.size()));
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_freeBuffers.push_back(buffer);
+        if (!m_file)
+        {
+            m_failed = true;
+        }
+        else
+        {
+            m_writtenCount += m_repeatCounts[buffer];
+        }
+    }
+}
+
+void VideoWriter::convert(const std::vector<unsigned char>& pixels)
+{
+    if (m_format == Format::Y4m)
+    {
+        convertToYuv(pixels);
+    }
+    else
+    {
+        convertToRgb(pixels);
+    }
+}
+
+void VideoWriter::convertToRgb(const std::vector<unsigned char>& pixels)
+{
+    m_output.resize(static_cast<std::size_t>(m_width) * m_height * 3);
+    unsigned char* output = m_output.data();
+    for (unsigned int row = 0; row < m_height; row++)
+    {
+        // Rows of the input go from the bottom
+        const unsigned char* input = pixels.data() + static_cast<std::size_t>(m_height - 1 - row) * m_width * 4;
+        for (unsigned int x = 0; x < m_width; x++, input += 4, output += 3)
+        {
+            output[0] = input[0];
+            output[1] = input[1];
+            output[2] = input[2];
+        }
+    }
+}
+
+void VideoWriter::convertToYuv(const std::vector<unsigned char>& pixels)
+{
+    std::size_t lumaSize = static_cast<std::size_t>(m_width) * m_height;
+    std::size_t chromaWidth = m_width / 2;
+    std::size_t chromaSize = lumaSize / 4;
+    m_output.resize(lumaSize + 2 * chromaSize);
+    unsigned char* luma = m_output.data();
+    unsigned char* blue = luma + lumaSize;
+    unsigned char* red = blue + chromaSize;
+    auto getPixel = [&](unsigned int x, unsigned int row)
+    {
+        return pixels.data() + (static_cast<std::size_t>(m_height - 1 - row) * m_width + x) * 4;
+    };
+    for (unsigned int row = 0; row < m_height; row++)
+    {
+        for (unsigned int x = 0; x < m_width; x++)
+        {
+            const unsigned char* pixel = getPixel(x, row);
+            luma[static_cast<std::size_t>(row) * m_width + x] = getLuma(pixel[0], pixel[1], pixel[2]);
+        }
+    }
+    // Chroma of every 2x2 block is computed from its average color
+    for (unsigned int row = 0; row < m_height; row += 2)
+    {
+        for (unsigned int x = 0; x < m_width; x += 2)
+        {
+            int r = 0;
+            int g = 0;
+            int b = 0;
+            for (unsigned int i = 0; i < 4; i++)
+            {
+                const unsigned char* pixel = getPixel(x + i % 2, row + i / 2);
+                r += pixel[0];
+                g += pixel[1];
+                b += pixel[2];
+            }
+            std::size_t index = (row / 2) * chromaWidth + x / 2;
+            blue[index] = getBlueChroma(r / 4, g / 4, b / 4);
+            red[index] = getRedChroma(r / 4, g / 4, b / 4);
+        }
+    }
+}
\ No newline at end of file
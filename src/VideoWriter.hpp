@@ -0,0 +1,72 @@
+#ifndef VIDEO_WRITER_HPP
+#define VIDEO_WRITER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+* Streams frames to a video file on its own thread, so that the game only copies each frame to a queue.
+* Files ending with '.y4m' are YUV4MPEG2 streams with 4:2:0 chroma, other files get raw RGB24 frames
+* one after another. Frames are taken as RGBA rows from the bottom, as read by OpenGL.
+* When all buffers of the queue are waiting for the disk, new frames are dropped instead of blocking the caller.
+* A frame can be repeated, so that a caller producing frames at an irregular rate keeps the rate of the video.
+*/
+class VideoWriter final
+{
+public:
+    enum class Format { Y4m, RawRgb };
+
+    // Open the file and start the writer thread. The frame rate is stored in Y4M headers.
+    // Throws std::runtime_error if the file cannot be opened.
+    VideoWriter(const std::string& path, unsigned int width, unsigned int height, unsigned int framesPerSecond,
+        std::size_t bufferCount = 8);
+
+    VideoWriter(const VideoWriter&) = delete;
+    VideoWriter& operator=(const VideoWriter&) = delete;
+
+    // Finish writing, errors are ignored.
+    ~VideoWriter();
+
+    // Queue a copy of the frame that is written the given number of times.
+    // Returns false if it was dropped because all buffers were busy.
+    bool write(const unsigned char* pixels, std::size_t repeatCount = 1);
+
+    // Write all queued frames and close the file. Throws std::runtime_error if writing failed.
+    void finish();
+
+    Format getFormat() const;
+    std::size_t getWrittenCount() const;
+    std::size_t getDroppedCount() const;
+
+private:
+    std::string m_path;
+    unsigned int m_width;
+    unsigned int m_height;
+    Format m_format;
+    std::ofstream m_file;
+    std::vector<std::vector<unsigned char>> m_buffers;
+    std::vector<std::size_t> m_repeatCounts;    // Number of times the frame in each buffer is written
+    std::vector<std::size_t> m_freeBuffers;     // Indices of buffers that can be filled by write
+    std::deque<std::size_t> m_queuedBuffers;    // Indices of buffers waiting for the writer thread
+    std::vector<unsigned char> m_output;        // Frame converted to the format of the file, used by the writer thread
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_finishing;
+    bool m_failed;
+    std::size_t m_writtenCount;     // Frames of the video, repeated frames are counted every time
+    std::size_t m_droppedCount;
+    std::thread m_thread;       // Started last, it uses all other members
+
+    void writerLoop();
+    void convert(const std::vector<unsigned char>& pixels);     // Convert pixels to m_output
+    void convertToRgb(const std::vector<unsigned char>& pixels);
+    void convertToYuv(const std::vector<unsigned char>& pixels);
+};
+
+#endif
\ No newline at end of file
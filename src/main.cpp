@@ -1,16 +1,121 @@
 #include "Game.hpp"
+#include "Clock.hpp"
+#include "Replay.hpp"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
 #include <iostream>
+#include <memory>
+#include <string>
+#include <stdexcept>
+
+namespace
+{
+    // Options of the game.
+    struct Options
+    {
+        double speed = 1.0;
+        unsigned int worldScale = 1;    // Number of screens along each side of the world
+        std::string recordPath;     // Empty if the game is not recorded
+        std::string replayPath;     // Empty if the game is played from the keyboard
+        std::string exportName;     // Empty if the game is not exported to shared memory
+        std::string capturePath;    // Empty if frames of the game are not captured
+        double frameBudget = -1.0;  // Milliseconds, negative keeps the default budget of the game
+    };
+
+    // Read options from command line, returns false if they are not valid.
+    bool parseArguments(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string argument = argv[i];
+            if (i + 1 == argc)
+            {
+                return false;
+            }
+            if (argument == "--speed")
+            {
+                try
+                {
+                    options.speed = std::stod(argv[++i]);
+                }
+                catch (const std::logic_error&)
+                {
+                    return false;
+                }
+            }
+            else if (argument == "--world-scale")
+            {
+                try
+                {
+                    options.worldScale = static_cast<unsigned int>(std::stoul(argv[++i]));
+                }
+                catch (const std::logic_error&)
+                {
+                    return false;
+                }
+            }
+            else if (argument == "--frame-budget")
+            {
+                try
+                {
+                    options.frameBudget = std::stod(argv[++i]);
+                }
+                catch (const std::logic_error&)
+                {
+                    return false;
+                }
+                if (options.frameBudget < 0.0)
+                {
+                    return false;
+                }
+            }
+            else if (argument == "--record")
+            {
+                options.recordPath = argv[++i];
+            }
+            else if (argument == "--replay")
+            {
+                options.replayPath = argv[++i];
+            }
+            else if (argument == "--export")
+            {
+                options.exportName = argv[++i];
+            }
+            else if (argument == "--capture")
+            {
+                options.capturePath = argv[++i];
+            }
+            else
+            {
+                return false;
+            }
+        }
+        // Replays do not store the size of the world, they are played in a world of one screen
+        return options.worldScale > 0
+            && (options.worldScale == 1 || (options.recordPath.empty() && options.replayPath.empty()));
+    }
+}
 
 /**
 * Entry point of the game.
 * Initializes GLFW and runs the game.
+* Option '--speed <factor>' runs the game the given number of times faster than real time,
+* '--record <file>' saves the inputs of the game to a replay and '--replay <file>' plays a replay back.
+* '--world-scale <screens>' makes the world the given number of screens wide and high, the camera follows the player.
+* '--export <name>' publishes frames and objects of the game to shared memory rings '<name>-frames' and '<name>-entities'.
+* '--frame-budget <ms>' sets GPU time for drawing the scene, its resolution is lowered if it takes longer (0 disables scaling).
+* '--capture <file>' writes rendered frames to a Y4M video (if the name ends with '.y4m') or to raw RGB frames.
 */
-int main()
+int main(int argc, char* argv[])
 {
+    Options options;
+    if (!parseArguments(argc, argv, options))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--speed <factor>] [--world-scale <screens>] [--frame-budget <ms>] [--record <file>] [--replay <file>] [--export <name>] [--capture <file>]" << std::endl;
+        return -1;
+    }
     if (glfwInit() == GLFW_FALSE)
     {
         std::cerr << "Failed to initialize GLFW" << std::endl;
@@ -18,8 +123,36 @@ int main()
     }
     try
     {
-        Game game;
+        std::unique_ptr<Replay> replay;
+        unsigned int seed = 1;
+        if (!options.replayPath.empty())
+        {
+            replay = std::make_unique<Replay>(Replay::load(options.replayPath));
+            seed = replay->getSeed();
+        }
+        Game game(std::make_shared<ScaledClock>(std::make_shared<RealClock>(), options.speed), seed, options.worldScale);
+        if (replay)
+        {
+            game.playBack(*replay);
+        }
+        if (!options.recordPath.empty())
+        {
+            game.recordTo(options.recordPath);
+        }
+        if (!options.exportName.empty())
+        {
+            game.exportTo(options.exportName);
+        }
+        if (!options.capturePath.empty())
+        {
+            game.captureTo(options.capturePath);
+        }
+        if (options.frameBudget >= 0.0)
+        {
+            game.setFrameBudget(options.frameBudget / 1000.0);
+        }
         game.run();
+        std::cout << "Collisions: " << game.getCollisionStats() << std::endl;
     }
     catch (const std::runtime_error& e)
     {
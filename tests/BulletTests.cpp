@@ -0,0 +1,134 @@
+#include "Check.hpp"
+
+#include "Bullet.hpp"
+#include "Asteroid.hpp"
+#include "HullBuffer.hpp"
+#include "CollisionStats.hpp"
+#include "Geometry.hpp"
+#include "Shape.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/trigonometric.hpp>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    const float DELTA_TIME = 1.0f / 30.0f;
+    const float ASTEROID_SIZE = 40.0f;
+    const glm::vec2 BULLET_SIZE = glm::vec2(3.0f, 10.0f);
+    const glm::vec2 ASTEROID_CENTER = glm::vec2(300.0f, 300.0f);
+
+    std::shared_ptr<const Shape> makeAsteroidShape()
+    {
+        return std::make_shared<Shape>(std::vector<glm::vec2>{
+            glm::vec2(0.5f, 0.0f), glm::vec2(1.0f, 0.5f), glm::vec2(0.75f, 1.0f),
+            glm::vec2(0.25f, 1.0f), glm::vec2(0.0f, 0.75f), glm::vec2(0.15f, 0.25f)
+        }, glm::vec2(ASTEROID_SIZE));
+    }
+
+    std::shared_ptr<const Shape> makeBulletShape()
+    {
+        return std::make_shared<Shape>(std::vector<glm::vec2>{
+            glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 1.0f)
+        }, BULLET_SIZE);
+    }
+
+    Asteroid makeAsteroid(glm::vec2 center, glm::vec2 velocity)
+    {
+        Asteroid asteroid;
+        asteroid.shape = makeAsteroidShape();
+        asteroid.size = glm::vec2(ASTEROID_SIZE);
+        asteroid.position = center - 0.5f * asteroid.size;
+        asteroid.velocity = velocity;
+        asteroid.rotationSpeed = 0.0f;
+        return asteroid;
+    }
+
+    Bullet makeBullet(glm::vec2 center, glm::vec2 velocity)
+    {
+        Bullet bullet;
+        bullet.shape = makeBulletShape();
+        bullet.size = BULLET_SIZE;
+        bullet.position = center - 0.5f * bullet.size;
+        bullet.rotation = geom::clampAngle(glm::degrees(std::atan2(velocity.y, velocity.x)) + 90.0f);
+        bullet.velocity = velocity;
+        return bullet;
+    }
+
+    // Move both objects by one update at 30 Hz and test the hit.
+    bool hitsAfterUpdate(Bullet& bullet, Asteroid& asteroid, bool& overlapsAfter)
+    {
+        bullet.update(DELTA_TIME);
+        asteroid.update(DELTA_TIME);
+        HullBuffer hulls;
+        bullet.updateBounds(hulls);
+        asteroid.updateBounds(hulls);
+        overlapsAfter = hulls.intersect(bullet.getHullIndex(), asteroid.getHullIndex());
+        CollisionStats stats;
+        return bullet.hits(asteroid, asteroid.displacement, hulls, stats);
+    }
+
+    // A bullet jumping from one side of the asteroid to the other in one update still hits it, in every direction.
+    void testFastBulletDoesNotTunnel()
+    {
+        const float SPEED = 3000.0f;    // 100 units per update, more than twice the asteroid
+        std::size_t tunnelling = 0;
+        for (float angle = 0.0f; angle < 360.0f; angle += 7.5f)
+        {
+            glm::vec2 direction = geom::getDirection(angle);
+            Bullet bullet = makeBullet(ASTEROID_CENTER - 50.0f * direction, SPEED * direction);
+            Asteroid asteroid = makeAsteroid(ASTEROID_CENTER, glm::vec2(0.0f));
+            bool overlapsAfter = false;
+            CHECK(hitsAfterUpdate(bullet, asteroid, overlapsAfter));
+            // Only the path can find the hit, the bullet ends behind the asteroid
+            tunnelling += overlapsAfter ? 0 : 1;
+        }
+        CHECK(tunnelling > 0);
+    }
+
+    // The path is tested relative to the asteroid, so an asteroid moving across a slow bullet is hit too.
+    void testMovingAsteroidDoesNotTunnel()
+    {
+        Bullet bullet = makeBullet(ASTEROID_CENTER, glm::vec2(0.0f, -30.0f));
+        Asteroid asteroid = makeAsteroid(ASTEROID_CENTER - glm::vec2(60.0f, 0.0f), glm::vec2(3600.0f, 0.0f));
+        bool overlapsAfter = true;
+        CHECK(hitsAfterUpdate(bullet, asteroid, overlapsAfter));
+        CHECK(!overlapsAfter);
+    }
+
+    void testPathBesideAsteroidMisses()
+    {
+        Bullet bullet = makeBullet(ASTEROID_CENTER + glm::vec2(-50.0f, 30.0f), glm::vec2(3000.0f, 0.0f));
+        Asteroid asteroid = makeAsteroid(ASTEROID_CENTER, glm::vec2(0.0f));
+        bool overlapsAfter = true;
+        CHECK(!hitsAfterUpdate(bullet, asteroid, overlapsAfter));
+        CHECK(!overlapsAfter);
+    }
+
+    // A bullet moved to the other side of the world has no path across the asteroid between its positions.
+    void testWrappedBulletForgetsPath()
+    {
+        Bullet bullet = makeBullet(ASTEROID_CENTER - glm::vec2(50.0f, 0.0f), glm::vec2(3000.0f, 0.0f));
+        Asteroid asteroid = makeAsteroid(ASTEROID_CENTER, glm::vec2(0.0f));
+        bullet.update(DELTA_TIME);
+        bullet.resetPreviousPosition();
+        HullBuffer hulls;
+        bullet.updateBounds(hulls);
+        asteroid.updateBounds(hulls);
+        CollisionStats stats;
+        CHECK(!bullet.hits(asteroid, glm::vec2(0.0f), hulls, stats));
+        CHECK(stats.queries == 1);
+    }
+}
+
+int main()
+{
+    test::run("fast bullet does not tunnel", testFastBulletDoesNotTunnel);
+    test::run("moving asteroid does not tunnel", testMovingAsteroidDoesNotTunnel);
+    test::run("path beside asteroid misses", testPathBesideAsteroidMisses);
+    test::run("wrapped bullet forgets path", testWrappedBulletForgetsPath);
+    return test::getExitCode();
+}
\ No newline at end of file
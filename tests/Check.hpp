@@ -0,0 +1,56 @@
+#ifndef CHECK_HPP
+#define CHECK_HPP
+
+#include <exception>
+#include <iostream>
+
+/**
+* Minimal support for unit tests. Every test program runs its tests by test::run
+* and returns test::getExitCode() from main, failed checks are printed to std::cerr.
+*/
+namespace test
+{
+    // Number of failed checks and tests of the program.
+    inline int& failureCount()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    // Report the failed expression, the test continues.
+    inline void check(bool condition, const char* expression, const char* file, int line)
+    {
+        if (!condition)
+        {
+            ++failureCount();
+            std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+        }
+    }
+
+    // Run a test function, an exception fails the test.
+    template<typename F>
+    void run(const char* name, F function)
+    {
+        int failuresBefore = failureCount();
+        try
+        {
+            function();
+        }
+        catch (const std::exception& e)
+        {
+            ++failureCount();
+            std::cerr << name << ": exception: " << e.what() << std::endl;
+        }
+        std::cout << (failureCount() == failuresBefore ? "passed: " : "FAILED: ") << name << std::endl;
+    }
+
+    inline int getExitCode()
+    {
+        return failureCount() == 0 ? 0 : 1;
+    }
+}
+
+// Check a condition and report it if it does not hold.
+#define CHECK(condition) test::check((condition), #condition, __FILE__, __LINE__)
+
+#endif
\ No newline at end of file
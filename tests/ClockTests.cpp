@@ -0,0 +1,126 @@
+#include "Check.hpp"
+
+#include "Clock.hpp"
+
+#include <memory>
+#include <stdexcept>
+
+namespace
+{
+    void testManualClockAdvances()
+    {
+        ManualClock clock(2.0);
+        CHECK(clock.getTime() == 2.0);
+        clock.advance(0.5);
+        clock.advance(0.0);
+        CHECK(clock.getTime() == 2.5);
+    }
+
+    void testManualClockCannotGoBack()
+    {
+        ManualClock clock(1.0);
+        bool thrown = false;
+        try
+        {
+            clock.advance(-0.25);
+        }
+        catch (const std::logic_error&)
+        {
+            thrown = true;
+        }
+        CHECK(thrown);
+        CHECK(clock.getTime() == 1.0);
+    }
+
+    // The scaled clock starts at zero whatever the time of its source.
+    void testScaledClockRunsFaster()
+    {
+        auto source = std::make_shared<ManualClock>(10.0);
+        ScaledClock clock(source, 2.0);
+        CHECK(clock.getTime() == 0.0);
+        source->advance(1.5);
+        CHECK(clock.getTime() == 3.0);
+        CHECK(clock.getScale() == 2.0);
+    }
+
+    // Changing the scale keeps the current time, only later time runs at the new speed.
+    void testScaleChangeKeepsTime()
+    {
+        auto source = std::make_shared<ManualClock>();
+        ScaledClock clock(source, 4.0);
+        source->advance(1.0);
+        clock.setScale(0.5);
+        CHECK(clock.getTime() == 4.0);
+        source->advance(2.0);
+        CHECK(clock.getTime() == 5.0);
+        clock.setScale(0.0);
+        source->advance(3.0);
+        CHECK(clock.getTime() == 5.0);
+        clock.setScale(1.0);
+        source->advance(0.25);
+        CHECK(clock.getTime() == 5.25);
+    }
+
+    // A scaled clock can drive another one, scales multiply.
+    void testScaledClocksChain()
+    {
+        auto source = std::make_shared<ManualClock>();
+        auto fast = std::make_shared<ScaledClock>(source, 3.0);
+        ScaledClock clock(fast, 0.5);
+        source->advance(2.0);
+        CHECK(clock.getTime() == 3.0);
+    }
+
+    void testInvalidScaledClockIsRejected()
+    {
+        bool missingSource = false;
+        try
+        {
+            ScaledClock clock(nullptr, 1.0);
+        }
+        catch (const std::logic_error&)
+        {
+            missingSource = true;
+        }
+        CHECK(missingSource);
+
+        auto source = std::make_shared<ManualClock>();
+        ScaledClock clock(source, 1.0);
+        bool negativeScale = false;
+        try
+        {
+            clock.setScale(-1.0);
+        }
+        catch (const std::logic_error&)
+        {
+            negativeScale = true;
+        }
+        CHECK(negativeScale);
+        CHECK(clock.getScale() == 1.0);
+    }
+
+    void testRealClockDoesNotDecrease()
+    {
+        RealClock clock;
+        double previous = clock.getTime();
+        CHECK(previous >= 0.0);
+        for (int i = 0; i < 1000; i++)
+        {
+            double time = clock.getTime();
+            CHECK(time >= previous);
+            previous = time;
+        }
+    }
+}
+
+int main()
+{
+    test::run("manual clock advances", testManualClockAdvances);
+    test::run("manual clock cannot go back", testManualClockCannotGoBack);
+    test::run("scaled clock runs faster", testScaledClockRunsFaster);
+    test::run("scale change keeps time", testScaleChangeKeepsTime);
+    test::run("scaled clocks chain", testScaledClocksChain);
+    test::run("invalid scaled clock is rejected", testInvalidScaledClockIsRejected);
+    test::run("real clock does not decrease", testRealClockDoesNotDecrease);
+    return test::getExitCode();
+}
\ No newline at end of file
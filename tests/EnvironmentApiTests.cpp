@@ -0,0 +1,193 @@
+#include "Check.hpp"
+#include "TestInputs.hpp"
+
+#include "EnvironmentApi.h"
+#include "Simulation.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::size_t COUNT = 16;
+    const unsigned int SEED = 5;
+    const std::size_t STEPS = 3000;
+    const std::size_t FRAME_SIDE = 32;
+
+    struct EnvironmentDeleter
+    {
+        void operator()(sg_env* env) const
+        {
+            sg_env_destroy(env);
+        }
+    };
+
+    using Environment = std::unique_ptr<sg_env, EnvironmentDeleter>;
+
+    Environment createEnvironment(std::size_t threadCount)
+    {
+        Environment env(sg_env_create(COUNT, SEED, threadCount));
+        CHECK(env != nullptr);
+        return env;
+    }
+
+    // Actions of all instances for every step, each instance plays differently.
+    std::vector<std::vector<unsigned char>> makeActions()
+    {
+        std::vector<std::vector<unsigned char>> actions(STEPS, std::vector<unsigned char>(COUNT));
+        for (std::size_t i = 0; i < COUNT; i++)
+        {
+            std::vector<InputState> inputs = test::makeInputs(STEPS, static_cast<unsigned int>(100 + i));
+            for (std::size_t step = 0; step < STEPS; step++)
+            {
+                actions[step][i] = inputs[step].buttons;
+            }
+        }
+        return actions;
+    }
+
+    // Rewards and done flags match simulations stepped directly, finished games are restarted.
+    void testStepMatchesSimulations()
+    {
+        Environment env = createEnvironment(2);
+        if (!env)
+        {
+            return;
+        }
+        CHECK(sg_env_get_count(env.get()) == COUNT);
+        std::size_t observationSize = sg_env_get_observation_size();
+        std::vector<float> initial(COUNT * observationSize);
+        CHECK(sg_env_reset(env.get(), initial.data()) == 0);
+        std::vector<std::unique_ptr<Simulation>> simulations;
+        for (std::size_t i = 0; i < COUNT; i++)
+        {
+            simulations.push_back(std::make_unique<Simulation>(SEED + static_cast<unsigned int>(i)));
+            simulations.back()->restart();
+        }
+        std::vector<std::vector<unsigned char>> actions = makeActions();
+        std::vector<float> rewards(COUNT);
+        std::vector<unsigned char> dones(COUNT);
+        std::vector<float> observations(COUNT * observationSize);
+        std::size_t doneCount = 0;
+        float totalReward = 0.0f;
+        for (std::size_t step = 0; step < STEPS; step++)
+        {
+            CHECK(sg_env_step(env.get(), actions[step].data(), rewards.data(), dones.data(), observations.data()) == 0);
+            for (std::size_t i = 0; i < COUNT; i++)
+            {
+                Simulation& simulation = *simulations[i];
+                std::uint64_t score = simulation.getScore();
+                simulation.step(InputState(actions[step][i]));
+                bool done = simulation.getState() == Simulation::State::Over;
+                CHECK(rewards[i] == static_cast<float>(simulation.getScore() - score));
+                CHECK(dones[i] == (done ? 1 : 0));
+                totalReward += rewards[i];
+                if (done)
+                {
+                    simulation.restart();
+                    ++doneCount;
+                    // The observation is the first one of the new game, the player starts in the center
+                    const float* player = observations.data() + i * observationSize;
+                    const float* startPlayer = initial.data() + i * observationSize;
+                    CHECK(std::memcmp(player, startPlayer, 6 * sizeof(float)) == 0);
+                }
+            }
+        }
+        CHECK(doneCount > 0);
+        CHECK(totalReward > 0.0f);
+        CHECK(sg_env_get_total_steps(env.get()) == COUNT * STEPS);
+        CHECK(std::string(sg_env_get_error()).empty());
+    }
+
+    // Outputs do not depend on the number of threads or on which outputs are requested.
+    void testStepIsDeterministic()
+    {
+        Environment env1 = createEnvironment(1);
+        Environment env2 = createEnvironment(3);
+        if (!env1 || !env2)
+        {
+            return;
+        }
+        std::size_t observationSize = sg_env_get_observation_size();
+        std::vector<std::vector<unsigned char>> actions = makeActions();
+        std::vector<float> rewards1(COUNT), rewards2(COUNT);
+        std::vector<float> observations1(COUNT * observationSize), observations2(COUNT * observationSize);
+        for (std::size_t step = 0; step < 500; step++)
+        {
+            CHECK(sg_env_step(env1.get(), actions[step].data(), rewards1.data(), nullptr, observations1.data()) == 0);
+            CHECK(sg_env_step(env2.get(), actions[step].data(), rewards2.data(), nullptr, nullptr) == 0);
+        }
+        CHECK(sg_env_observe(env2.get(), observations2.data()) == 0);
+        CHECK(rewards1 == rewards2);
+        CHECK(observations1 == observations2);
+    }
+
+    void testRenderDrawsEveryInstance()
+    {
+        Environment env = createEnvironment(2);
+        if (!env)
+        {
+            return;
+        }
+        CHECK(sg_env_reset(env.get(), nullptr) == 0);
+        for (std::size_t channels : { std::size_t(1), std::size_t(4) })
+        {
+            std::size_t frameSize = sg_env_get_frame_size(FRAME_SIDE, FRAME_SIDE, channels);
+            CHECK(frameSize == FRAME_SIDE * FRAME_SIDE * channels);
+            std::vector<unsigned char> frames(COUNT * frameSize, 0);
+            CHECK(sg_env_render(env.get(), FRAME_SIDE, FRAME_SIDE, channels, frames.data()) == 0);
+            for (std::size_t i = 0; i < COUNT; i++)
+            {
+                // The player is always in the view
+                std::size_t covered = 0;
+                for (std::size_t j = 0; j < frameSize; j++)
+                {
+                    covered += frames[i * frameSize + j] != 0 ? 1 : 0;
+                }
+                CHECK(covered > 0);
+            }
+        }
+    }
+
+    void testInvalidArgumentsAreReported()
+    {
+        std::vector<unsigned char> actions(COUNT);
+        std::vector<float> observations(COUNT * sg_env_get_observation_size());
+        std::vector<unsigned char> frames(COUNT * FRAME_SIDE * FRAME_SIDE);
+        CHECK(sg_env_reset(nullptr, observations.data()) < 0);
+        CHECK(!std::string(sg_env_get_error()).empty());
+        CHECK(sg_env_step(nullptr, actions.data(), nullptr, nullptr, nullptr) < 0);
+        CHECK(sg_env_observe(nullptr, observations.data()) < 0);
+        CHECK(sg_env_render(nullptr, FRAME_SIDE, FRAME_SIDE, 1, frames.data()) < 0);
+        CHECK(sg_env_get_count(nullptr) == 0);
+        CHECK(sg_env_get_total_steps(nullptr) == 0);
+        CHECK(sg_env_get_frame_size(FRAME_SIDE, FRAME_SIDE, 3) == 0);
+        sg_env_destroy(nullptr);
+        Environment env = createEnvironment(1);
+        if (!env)
+        {
+            return;
+        }
+        CHECK(sg_env_step(env.get(), nullptr, nullptr, nullptr, nullptr) < 0);
+        CHECK(!std::string(sg_env_get_error()).empty());
+        CHECK(sg_env_observe(env.get(), nullptr) < 0);
+        CHECK(sg_env_render(env.get(), FRAME_SIDE, FRAME_SIDE, 1, nullptr) < 0);
+        CHECK(sg_env_render(env.get(), FRAME_SIDE, FRAME_SIDE, 3, frames.data()) < 0);
+        CHECK(sg_env_get_total_steps(env.get()) == 0);
+        // A successful call clears the error
+        CHECK(sg_env_step(env.get(), actions.data(), nullptr, nullptr, nullptr) == 0);
+        CHECK(std::string(sg_env_get_error()).empty());
+    }
+}
+
+int main()
+{
+    test::run("step matches simulations", testStepMatchesSimulations);
+    test::run("step is deterministic", testStepIsDeterministic);
+    test::run("render draws every instance", testRenderDrawsEveryInstance);
+    test::run("invalid arguments are reported", testInvalidArgumentsAreReported);
+    return test::getExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "Check.hpp"
+
+#include "GeometrySimd.hpp"
+#include "Geometry.hpp"
+#include "Random.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Paths whose kernels can run on this CPU.
+    std::vector<geom::simd::Path> getSupportedPaths()
+    {
+        std::vector<geom::simd::Path> paths = { geom::simd::Path::Scalar };
+        geom::simd::Path best = geom::simd::getBestPath();
+        if (best == geom::simd::Path::Sse || best == geom::simd::Path::Avx)
+        {
+            paths.push_back(geom::simd::Path::Sse);
+        }
+        if (best == geom::simd::Path::Avx)
+        {
+            paths.push_back(geom::simd::Path::Avx);
+        }
+        return paths;
+    }
+
+    // Points on a coarse grid, so that many segments touch or are colinear and orientations are zero.
+    glm::vec2 getGridPoint(rnd::Generator& random)
+    {
+        return glm::vec2(static_cast<float>(random.getInt(6)), static_cast<float>(random.getInt(6)));
+    }
+
+    glm::vec2 getPoint(rnd::Generator& random)
+    {
+        return glm::vec2(random.getFloat(-50.0f, 50.0f), random.getFloat(-50.0f, 50.0f));
+    }
+
+    std::vector<glm::vec2> makePolygon(rnd::Generator& random, std::size_t count, bool onGrid)
+    {
+        std::vector<glm::vec2> polygon;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            polygon.push_back(onGrid ? getGridPoint(random) : getPoint(random));
+        }
+        return polygon;
+    }
+
+    // Same as geom::polygonsIntersect, edge i goes from point i - 1 to point i.
+    bool intersectScalar(const std::vector<glm::vec2>& polygon1, const std::vector<glm::vec2>& polygon2)
+    {
+        for (std::size_t i = 0; i < polygon1.size(); i++)
+        {
+            glm::vec2 p1 = polygon1[(i + polygon1.size() - 1) % polygon1.size()];
+            for (std::size_t j = 0; j < polygon2.size(); j++)
+            {
+                glm::vec2 p2 = polygon2[(j + polygon2.size() - 1) % polygon2.size()];
+                if (geom::segmentsIntersect(p1, polygon1[i], p2, polygon2[j]))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Every kernel agrees with geom::segmentsIntersect on batches of all sizes.
+    void testKernelsMatchSegmentTest()
+    {
+        rnd::Generator random(28);
+        std::size_t hits = 0;
+        for (int i = 0; i < 20000; i++)
+        {
+            bool onGrid = i % 2 == 0;
+            std::size_t count = 1 + i % geom::simd::EdgeBatch::CAPACITY;
+            std::vector<glm::vec2> polygon = makePolygon(random, count + 1, onGrid);
+            glm::vec2 p = onGrid ? getGridPoint(random) : getPoint(random);
+            glm::vec2 q = onGrid ? getGridPoint(random) : getPoint(random);
+            geom::simd::EdgeBatch batch;
+            geom::simd::loadEdges(polygon.data(), polygon.size(), 1, batch);
+            CHECK(batch.count == count);
+            bool expected = false;
+            for (std::size_t j = 1; j <= count; j++)
+            {
+                expected = expected || geom::segmentsIntersect(p, q, polygon[j - 1], polygon[j]);
+            }
+            hits += expected ? 1 : 0;
+            for (geom::simd::Path path : getSupportedPaths())
+            {
+                CHECK(geom::simd::getKernel(path)(p, q, batch) == expected);
+            }
+        }
+        CHECK(hits > 1000);
+    }
+
+    // Polygons with more edges than a batch are split into batches, the last one is partial.
+    void testPolygonsMatchScalarTest()
+    {
+        rnd::Generator random(128);
+        for (int i = 0; i < 3000; i++)
+        {
+            bool onGrid = i % 3 == 0;
+            std::vector<glm::vec2> polygon1 = makePolygon(random, 3 + i % 5, onGrid);
+            std::vector<glm::vec2> polygon2 = makePolygon(random, 3 + i % 19, onGrid);
+            bool expected = intersectScalar(polygon1, polygon2);
+            for (geom::simd::Path path : getSupportedPaths())
+            {
+                CHECK(geom::simd::polygonsIntersect(polygon1.data(), polygon1.size(), polygon2.data(), polygon2.size(),
+                    geom::simd::getKernel(path)) == expected);
+            }
+            CHECK(geom::polygonsIntersect(polygon1, polygon2) == expected);
+        }
+    }
+
+    void testPathNames()
+    {
+        CHECK(geom::simd::getKernel(geom::simd::getBestPath()) != nullptr);
+        CHECK(std::string(geom::simd::getPathName(geom::simd::Path::Scalar)) != geom::simd::getPathName(geom::simd::Path::Sse));
+        CHECK(std::string(geom::simd::getPathName(geom::simd::Path::Sse)) != geom::simd::getPathName(geom::simd::Path::Avx));
+    }
+}
+
+int main()
+{
+    test::run("kernels match segment test", testKernelsMatchSegmentTest);
+    test::run("polygons match scalar test", testPolygonsMatchScalarTest);
+    test::run("path names", testPathNames);
+    return test::getExitCode();
+}
\ No newline at end of file
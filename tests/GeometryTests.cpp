@@ -0,0 +1,162 @@
+#include "Check.hpp"
+
+#include "Geometry.hpp"
+#include "HullBuffer.hpp"
+#include "Random.hpp"
+#include "Shape.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/geometric.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    const float MARGIN = 0.01f;     // Distance beyond the translation that must separate the polygons
+
+    // Convex polygon owning its points and normals.
+    struct Polygon
+    {
+        std::vector<glm::vec2> points;
+        std::vector<glm::vec2> normals;
+
+        explicit Polygon(const std::vector<glm::vec2>& polygonPoints)
+            : points(polygonPoints), normals(geom::getEdgeNormals(polygonPoints))
+        {
+        }
+
+        geom::ConvexPolygon get() const
+        {
+            return geom::ConvexPolygon{ points.data(), normals.data(), points.size() };
+        }
+    };
+
+    Polygon makeSquare(glm::vec2 center, float halfSize)
+    {
+        return Polygon({
+            center + glm::vec2(-halfSize, -halfSize), center + glm::vec2(halfSize, -halfSize),
+            center + glm::vec2(halfSize, halfSize), center + glm::vec2(-halfSize, halfSize)
+        });
+    }
+
+    geom::ConvexPolygon translate(const geom::ConvexPolygon& polygon, glm::vec2 translation, std::vector<glm::vec2>& points)
+    {
+        points.assign(polygon.points, polygon.points + polygon.count);
+        for (auto& point : points)
+        {
+            point += translation;
+        }
+        return geom::ConvexPolygon{ points.data(), polygon.normals, polygon.count };
+    }
+
+    // The translation must separate the polygons and no shorter one in its direction may do so.
+    void checkTranslation(const geom::ConvexPolygon& polygon1, const geom::ConvexPolygon& polygon2, glm::vec2 translation)
+    {
+        glm::vec2 ignored;
+        std::vector<glm::vec2> points;
+        float length = glm::length(translation);
+        CHECK(length > MARGIN);
+        if (length <= MARGIN)
+        {
+            return;
+        }
+        glm::vec2 direction = translation / length;
+        CHECK(!geom::convexPolygonsIntersect(translate(polygon1, translation + MARGIN * direction, points), polygon2, ignored));
+        CHECK(geom::convexPolygonsIntersect(translate(polygon1, translation - MARGIN * direction, points), polygon2, ignored));
+    }
+
+    // A polygon inside another one must be moved across the nearer edge, not by the overlap of projections.
+    void testContainedPolygonIsPushedOut()
+    {
+        Polygon outer = makeSquare(glm::vec2(5.0f), 5.0f);
+        glm::vec2 translation;
+        Polygon centered = makeSquare(glm::vec2(5.0f), 1.0f);
+        CHECK(geom::convexPolygonsIntersect(centered.get(), outer.get(), translation));
+        CHECK(std::abs(glm::length(translation) - 6.0f) < 1e-4f);
+        checkTranslation(centered.get(), outer.get(), translation);
+        Polygon shifted = makeSquare(glm::vec2(6.5f, 5.0f), 1.0f);
+        CHECK(geom::convexPolygonsIntersect(shifted.get(), outer.get(), translation));
+        CHECK(glm::distance(translation, glm::vec2(4.5f, 0.0f)) < 1e-4f);
+        checkTranslation(shifted.get(), outer.get(), translation);
+        // The outer polygon is moved the same distance out of the inner one
+        CHECK(geom::convexPolygonsIntersect(outer.get(), shifted.get(), translation));
+        CHECK(glm::distance(translation, glm::vec2(-4.5f, 0.0f)) < 1e-4f);
+        checkTranslation(outer.get(), shifted.get(), translation);
+    }
+
+    void testBulletInsideAsteroid()
+    {
+        Shape asteroid({
+            glm::vec2(0.5f, 0.0f), glm::vec2(1.0f, 0.5f), glm::vec2(0.75f, 1.0f),
+            glm::vec2(0.25f, 1.0f), glm::vec2(0.0f, 0.75f), glm::vec2(0.15f, 0.25f)
+        }, glm::vec2(40.0f));
+        Shape bullet({ glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 1.0f) },
+            glm::vec2(3.0f, 10.0f));
+        CHECK(asteroid.getParts().size() == 1);
+        for (float rotation = 0.0f; rotation < 360.0f; rotation += 15.0f)
+        {
+            HullBuffer hulls;
+            std::size_t asteroidIndex = hulls.add(asteroid, glm::vec2(100.0f, 100.0f), rotation);
+            std::size_t bulletIndex = hulls.add(bullet, glm::vec2(102.0f, 97.0f), 2.0f * rotation);
+            glm::vec2 translation;
+            CHECK(geom::convexPolygonsIntersect(hulls.getPart(bulletIndex, 0), hulls.getPart(asteroidIndex, 0), translation));
+            checkTranslation(hulls.getPart(bulletIndex, 0), hulls.getPart(asteroidIndex, 0), translation);
+        }
+    }
+
+    // The concave ship is split into triangles, a bullet inside each of them is moved out of it.
+    void testBulletInsideConcaveShipPart()
+    {
+        std::vector<glm::vec2> ship = {
+            glm::vec2(0.0f, 1.0f), glm::vec2(0.5f, 0.75f), glm::vec2(1.0f, 1.0f), glm::vec2(0.5f, 0.0f)
+        };
+        CHECK(!geom::isConvex(ship));
+        Shape shipShape(ship, glm::vec2(28.0f, 35.0f));
+        CHECK(shipShape.getParts().size() == 2);
+        HullBuffer hulls;
+        std::size_t shipIndex = hulls.add(shipShape, glm::vec2(50.0f, 50.0f), 30.0f);
+        for (std::size_t i = 0; i < hulls.getPartCount(shipIndex); i++)
+        {
+            geom::ConvexPolygon part = hulls.getPart(shipIndex, i);
+            glm::vec2 centroid = (part.points[0] + part.points[1] + part.points[2]) / 3.0f;
+            Polygon bullet = makeSquare(centroid, 0.5f);
+            glm::vec2 translation;
+            CHECK(geom::convexPolygonsIntersect(bullet.get(), part, translation));
+            checkTranslation(bullet.get(), part, translation);
+        }
+    }
+
+    void testRandomPolygonsAreSeparated()
+    {
+        rnd::Generator random(29);
+        std::size_t intersecting = 0;
+        for (int i = 0; i < 2000; i++)
+        {
+            std::vector<glm::vec2> points1, points2;
+            for (int j = 0; j < 3; j++)
+            {
+                points1.push_back(glm::vec2(random.getFloat(0.0f, 20.0f), random.getFloat(0.0f, 20.0f)));
+            }
+            Polygon polygon1(points1);
+            Polygon polygon2 = makeSquare(glm::vec2(random.getFloat(0.0f, 20.0f), random.getFloat(0.0f, 20.0f)),
+                random.getFloat(0.5f, 8.0f));
+            glm::vec2 translation;
+            if (geom::convexPolygonsIntersect(polygon1.get(), polygon2.get(), translation) && glm::length(translation) > MARGIN)
+            {
+                ++intersecting;
+                checkTranslation(polygon1.get(), polygon2.get(), translation);
+            }
+        }
+        CHECK(intersecting > 100);
+    }
+}
+
+int main()
+{
+    test::run("contained polygon is pushed out", testContainedPolygonIsPushedOut);
+    test::run("bullet inside asteroid", testBulletInsideAsteroid);
+    test::run("bullet inside concave ship part", testBulletInsideConcaveShipPart);
+    test::run("random polygons are separated", testRandomPolygonsAreSeparated);
+    return test::getExitCode();
+}
\ No newline at end of file
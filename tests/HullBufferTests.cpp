@@ -0,0 +1,110 @@
+#include "Check.hpp"
+
+#include "HullBuffer.hpp"
+#include "Random.hpp"
+#include "Shape.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/geometric.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+    const float MARGIN = 0.01f;     // Distance beyond the translation that must separate the hulls
+
+    std::shared_ptr<Shape> makeShip()
+    {
+        return std::make_shared<Shape>(std::vector<glm::vec2>{
+            glm::vec2(0.0f, 1.0f), glm::vec2(0.5f, 0.75f), glm::vec2(1.0f, 1.0f), glm::vec2(0.5f, 0.0f)
+        }, glm::vec2(28.0f, 35.0f));
+    }
+
+    std::shared_ptr<Shape> makeSquare(float size)
+    {
+        return std::make_shared<Shape>(std::vector<glm::vec2>{
+            glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 1.0f)
+        }, glm::vec2(size));
+    }
+
+    // The translation of the first hull must separate it from the second one.
+    bool separates(const Shape& shape1, glm::vec2 center1, float rotation1, const Shape& shape2, glm::vec2 center2,
+        float rotation2, glm::vec2 translation)
+    {
+        HullBuffer hulls;
+        glm::vec2 direction = glm::normalize(translation);
+        std::size_t index1 = hulls.add(shape1, center1 + translation + MARGIN * direction, rotation1);
+        std::size_t index2 = hulls.add(shape2, center2, rotation2);
+        return !hulls.intersect(index1, index2);
+    }
+
+    // A square across the diagonal between the two triangles of the ship is moved out of the whole ship,
+    // not only out of the triangle it overlaps the most.
+    void testSquareAcrossConcaveShipIsSeparated()
+    {
+        std::shared_ptr<Shape> ship = makeShip();
+        std::shared_ptr<Shape> square = makeSquare(4.0f);
+        CHECK(ship->getParts().size() == 2);
+        glm::vec2 shipCenter = glm::vec2(50.0f, 50.0f);
+        // The diagonal goes from the bow to the inner vertex along the axis of the ship
+        glm::vec2 squareCenter = shipCenter + glm::vec2(1.0f, 0.0f);
+        HullBuffer hulls;
+        std::size_t squareIndex = hulls.add(*square, squareCenter, 0.0f);
+        std::size_t shipIndex = hulls.add(*ship, shipCenter, 0.0f);
+        glm::vec2 translation;
+        CHECK(hulls.intersect(squareIndex, shipIndex, translation));
+        CHECK(separates(*square, squareCenter, 0.0f, *ship, shipCenter, 0.0f, translation));
+    }
+
+    void testRandomPairsAreSeparated()
+    {
+        rnd::Generator random(31);
+        std::shared_ptr<Shape> shapes[] = { makeShip(), makeSquare(3.0f), makeSquare(12.0f) };
+        std::size_t intersecting = 0;
+        for (int i = 0; i < 2000; i++)
+        {
+            const Shape& shape1 = *shapes[random.next() % 3];
+            const Shape& shape2 = *shapes[random.next() % 3];
+            glm::vec2 center1 = glm::vec2(random.getFloat(0.0f, 30.0f), random.getFloat(0.0f, 30.0f));
+            glm::vec2 center2 = glm::vec2(random.getFloat(0.0f, 30.0f), random.getFloat(0.0f, 30.0f));
+            float rotation1 = random.getFloat(0.0f, 360.0f);
+            float rotation2 = random.getFloat(0.0f, 360.0f);
+            HullBuffer hulls;
+            std::size_t index1 = hulls.add(shape1, center1, rotation1);
+            std::size_t index2 = hulls.add(shape2, center2, rotation2);
+            glm::vec2 translation;
+            bool intersects = hulls.intersect(index1, index2, translation);
+            CHECK(intersects == hulls.intersect(index1, index2));
+            if (intersects && glm::length(translation) > MARGIN)
+            {
+                ++intersecting;
+                CHECK(separates(shape1, center1, rotation1, shape2, center2, rotation2, translation));
+            }
+        }
+        CHECK(intersecting > 100);
+    }
+
+    void testPartsAreStoredPerHull()
+    {
+        std::shared_ptr<Shape> ship = makeShip();
+        std::shared_ptr<Shape> square = makeSquare(3.0f);
+        HullBuffer hulls;
+        CHECK(hulls.add(*ship, glm::vec2(0.0f), 0.0f) == 0);
+        CHECK(hulls.add(*square, glm::vec2(10.0f), 45.0f) == 1);
+        CHECK(hulls.size() == 2);
+        CHECK(hulls.getPartCount(0) == 2);
+        CHECK(hulls.getPartCount(1) == 1);
+        CHECK(hulls.getPart(1, 0).count == 4);
+        hulls.clear();
+        CHECK(hulls.size() == 0);
+    }
+}
+
+int main()
+{
+    test::run("square across concave ship is separated", testSquareAcrossConcaveShipIsSeparated);
+    test::run("random pairs are separated", testRandomPairsAreSeparated);
+    test::run("parts are stored per hull", testPartsAreStoredPerHull);
+    return test::getExitCode();
+}
\ No newline at end of file
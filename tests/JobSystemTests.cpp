@@ -0,0 +1,158 @@
+#include "Check.hpp"
+
+#include "JobSystem.hpp"
+#include "SystemScheduler.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::size_t THREAD_COUNT = 3;
+
+    // Every index of the range is visited exactly once and no chunk is smaller than the minimum.
+    void testParallelForCoversRange()
+    {
+        for (std::size_t threadCount : { std::size_t(1), THREAD_COUNT })
+        {
+            JobSystem jobs(threadCount);
+            for (std::size_t count : { 0u, 1u, 7u, 64u, 1000u, 4099u })
+            {
+                std::vector<std::atomic<int>> visits(count);
+                std::atomic<std::size_t> smallChunks(0);
+                jobs.parallelFor(count, 16, [&](std::size_t begin, std::size_t end)
+                {
+                    if (end - begin < 16 && end - begin != count)
+                    {
+                        ++smallChunks;
+                    }
+                    for (std::size_t i = begin; i < end; i++)
+                    {
+                        ++visits[i];
+                    }
+                });
+                bool once = true;
+                for (const auto& visit : visits)
+                {
+                    once = once && visit == 1;
+                }
+                CHECK(once);
+                CHECK(smallChunks == 0);
+            }
+        }
+    }
+
+    // A chunk waiting for an inner loop runs queued jobs instead of blocking, so nesting cannot deadlock
+    // even when every worker is inside an outer chunk.
+    void testNestedParallelFor()
+    {
+        JobSystem jobs(THREAD_COUNT);
+        const std::size_t OUTER = 32;
+        const std::size_t INNER = 256;
+        std::vector<std::atomic<int>> visits(OUTER * INNER);
+        jobs.parallelFor(OUTER, 1, [&](std::size_t outerBegin, std::size_t outerEnd)
+        {
+            for (std::size_t row = outerBegin; row < outerEnd; row++)
+            {
+                jobs.parallelFor(INNER, 8, [&, row](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; i++)
+                    {
+                        ++visits[row * INNER + i];
+                    }
+                });
+            }
+        });
+        bool once = true;
+        for (const auto& visit : visits)
+        {
+            once = once && visit == 1;
+        }
+        CHECK(once);
+    }
+
+    void testWaitForGroup()
+    {
+        JobSystem jobs(THREAD_COUNT);
+        JobSystem::Group group;
+        std::atomic<int> done(0);
+        for (int i = 0; i < 100; i++)
+        {
+            jobs.submit(group, [&done]() { ++done; });
+        }
+        jobs.wait(group);
+        CHECK(group.finished());
+        CHECK(done == 100);
+    }
+
+    // Conflicting systems go to later phases, independent ones share a phase, readers may share data.
+    void testSchedulerPhases()
+    {
+        const SystemScheduler::DataMask SHIP = 1;
+        const SystemScheduler::DataMask ASTEROIDS = 2;
+        const SystemScheduler::DataMask BULLETS = 4;
+        const SystemScheduler::DataMask SCORE = 8;
+        SystemScheduler scheduler;
+        scheduler.addSystem("ship", 0, SHIP, []() {});
+        scheduler.addSystem("asteroids", 0, ASTEROIDS, []() {});
+        scheduler.addSystem("bullets", SHIP, BULLETS, []() {});
+        scheduler.addSystem("render", SHIP | ASTEROIDS, 0, []() {});
+        scheduler.addSystem("collisions", BULLETS | ASTEROIDS, SCORE, []() {});
+        scheduler.addSystem("asteroids2", 0, ASTEROIDS, []() {});
+        std::vector<std::vector<std::string>> expected = {
+            { "ship", "asteroids" },
+            { "bullets", "render" },
+            { "collisions" },
+            { "asteroids2" }
+        };
+        CHECK(scheduler.getPhases() == expected);
+
+        scheduler.addSystem("score", SCORE, 0, []() {});
+        expected[3].push_back("score");
+        CHECK(scheduler.getPhases() == expected);
+    }
+
+    // Every system sees the results of the systems it depends on.
+    void testSchedulerOrder()
+    {
+        const SystemScheduler::DataMask VALUE = 1;
+        JobSystem jobs(THREAD_COUNT);
+        SystemScheduler scheduler;
+        int value = 0;
+        std::mutex logMutex;
+        std::vector<std::string> log;
+        auto append = [&](const std::string& name)
+        {
+            std::lock_guard<std::mutex> lock(logMutex);
+            log.push_back(name);
+        };
+        scheduler.addSystem("set", 0, VALUE, [&]() { value = 1; append("set"); });
+        scheduler.addSystem("double", VALUE, VALUE, [&]() { value *= 2; append("double"); });
+        for (int i = 0; i < 8; i++)
+        {
+            scheduler.addSystem("read", VALUE, 0, [&]() { if (value == 2) { append("read"); } });
+        }
+        scheduler.addSystem("add", VALUE, VALUE, [&]() { value += 3; append("add"); });
+        for (int run = 0; run < 50; run++)
+        {
+            log.clear();
+            scheduler.run(jobs);
+            CHECK(value == 5);
+            CHECK(log.size() == 11);
+            CHECK(log.front() == "set" && log[1] == "double" && log.back() == "add");
+        }
+    }
+}
+
+int main()
+{
+    test::run("parallel for covers range", testParallelForCoversRange);
+    test::run("nested parallel for", testNestedParallelFor);
+    test::run("wait for group", testWaitForGroup);
+    test::run("scheduler phases", testSchedulerPhases);
+    test::run("scheduler order", testSchedulerOrder);
+    return test::getExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "Check.hpp"
+
+#include "Motion.hpp"
+#include "Geometry.hpp"
+#include "Random.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <cstddef>
+
+namespace
+{
+    const glm::vec2 AREA = glm::vec2(800.0f, 600.0f);
+    const float DELTA_TIME = 1.0f / 60.0f;
+    const std::size_t COUNT = 103;      // Not a multiple of the lanes, so the scalar tail runs too
+
+    // Random transforms, some of them on the edges of the area and of the interval of rotations.
+    motion::Transforms makeTransforms(unsigned int seed)
+    {
+        rnd::Generator random(seed);
+        motion::Transforms transforms;
+        transforms.resize(COUNT);
+        for (std::size_t i = 0; i < COUNT; i++)
+        {
+            glm::vec2 size = glm::vec2(random.getFloat(1.0f, 40.0f), random.getFloat(1.0f, 40.0f));
+            glm::vec2 position = glm::vec2(random.getFloat(-60.0f, AREA.x + 20.0f), random.getFloat(-60.0f, AREA.y + 20.0f));
+            switch (i % 5)
+            {
+            case 0: position = -size; break;
+            case 1: position = AREA; break;
+            case 2: position = -size - glm::vec2(0.5f); break;
+            default: break;
+            }
+            float rotation = (i % 3 == 0) ? 0.0f : (i % 3 == 1 ? 359.9f : random.getFloat(0.0f, 360.0f));
+            transforms.set(i, position, glm::vec2(random.getFloat(-600.0f, 600.0f), random.getFloat(-600.0f, 600.0f)),
+                rotation, random.getFloat(-300.0f, 300.0f), size);
+        }
+        return transforms;
+    }
+
+    bool equal(const motion::Transforms& transforms1, const motion::Transforms& transforms2)
+    {
+        return transforms1.x == transforms2.x && transforms1.y == transforms2.y
+            && transforms1.rotation == transforms2.rotation && transforms1.wrapped == transforms2.wrapped;
+    }
+
+    // Batches give the same floats as moving objects one by one, which uses only the scalar code.
+    void testIntegrateMatchesSingleObjects()
+    {
+        for (unsigned int seed = 1; seed <= 20; seed++)
+        {
+            motion::Transforms batched = makeTransforms(seed);
+            motion::Transforms single = batched;
+            // The range starts and ends off the lanes
+            motion::integrate(batched, 1, COUNT - 2, DELTA_TIME);
+            for (std::size_t i = 1; i < COUNT - 2; i++)
+            {
+                motion::integrate(single, i, i + 1, DELTA_TIME);
+            }
+            CHECK(equal(batched, single));
+            // Objects outside the range are not moved
+            motion::Transforms original = makeTransforms(seed);
+            CHECK(batched.x[0] == original.x[0] && batched.x[COUNT - 1] == original.x[COUNT - 1]);
+        }
+    }
+
+    void testIntegrateKeepsRotations()
+    {
+        motion::Transforms transforms = makeTransforms(7);
+        for (int step = 0; step < 600; step++)
+        {
+            motion::integrate(transforms, 0, COUNT, DELTA_TIME);
+        }
+        bool inInterval = true;
+        for (std::size_t i = 0; i < COUNT; i++)
+        {
+            inInterval = inInterval && transforms.rotation[i] >= 0.0f && transforms.rotation[i] <= 360.0f;
+        }
+        CHECK(inInterval);
+        motion::Transforms one;
+        one.resize(1);
+        one.set(0, glm::vec2(10.0f), glm::vec2(60.0f, -120.0f), 359.0f, 120.0f, glm::vec2(4.0f));
+        motion::integrate(one, 0, 1, DELTA_TIME);
+        CHECK(one.x[0] == 10.0f + 60.0f * DELTA_TIME);
+        CHECK(one.y[0] == 10.0f + -120.0f * DELTA_TIME);
+        CHECK(one.rotation[0] == geom::clampAngle(359.0f + 120.0f * DELTA_TIME));
+    }
+
+    // Batches wrap the same objects to the same positions as the single-position wrap.
+    void testWrapMatchesSinglePositions()
+    {
+        for (unsigned int seed = 1; seed <= 20; seed++)
+        {
+            motion::Transforms batched = makeTransforms(seed);
+            motion::Transforms single = batched;
+            motion::wrap(batched, 0, COUNT, AREA);
+            std::size_t wrappedCount = 0;
+            for (std::size_t i = 0; i < COUNT; i++)
+            {
+                motion::wrap(single, i, i + 1, AREA);
+                glm::vec2 position = glm::vec2(batched.x[i], batched.y[i]);
+                motion::Transforms original = makeTransforms(seed);
+                glm::vec2 expected = glm::vec2(original.x[i], original.y[i]);
+                bool wrapped = motion::wrap(expected, glm::vec2(original.width[i], original.height[i]), AREA);
+                CHECK(position == expected);
+                CHECK((batched.wrapped[i] != 0) == wrapped);
+                wrappedCount += wrapped ? 1 : 0;
+            }
+            CHECK(equal(batched, single));
+            CHECK(wrappedCount > 0);
+        }
+    }
+
+    // Objects exactly on the edges stay, objects past them go to the other side.
+    void testWrapEdges()
+    {
+        glm::vec2 size = glm::vec2(10.0f, 20.0f);
+        glm::vec2 position = -size;
+        CHECK(!motion::wrap(position, size, AREA));
+        CHECK(position == -size);
+        position = AREA;
+        CHECK(!motion::wrap(position, size, AREA));
+        position = glm::vec2(-10.5f, AREA.y + 0.5f);
+        CHECK(motion::wrap(position, size, AREA));
+        CHECK(position == glm::vec2(AREA.x, -size.y));
+    }
+}
+
+int main()
+{
+    test::run("integrate matches single objects", testIntegrateMatchesSingleObjects);
+    test::run("integrate keeps rotations", testIntegrateKeepsRotations);
+    test::run("wrap matches single positions", testWrapMatchesSinglePositions);
+    test::run("wrap edges", testWrapEdges);
+    return test::getExitCode();
+}
\ No newline at end of file
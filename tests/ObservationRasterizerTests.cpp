@@ -0,0 +1,166 @@
+#include "Check.hpp"
+#include "TestObjects.hpp"
+
+#include "ObservationRasterizer.hpp"
+#include "Simulation.hpp"
+#include "Geometry.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+    // Frame of the same size as the view, one pixel per unit of the world
+    const std::size_t WIDTH = 800;
+    const std::size_t HEIGHT = 600;
+
+    // Check whether the point is inside the polygon by counting crossings of a ray going to the right.
+    bool containsPoint(const std::vector<glm::vec2>& polygon, glm::vec2 point)
+    {
+        bool inside = false;
+        for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+        {
+            glm::vec2 a = polygon[i];
+            glm::vec2 b = polygon[j];
+            if ((a.y > point.y) != (b.y > point.y)
+                && point.x < a.x + (point.y - a.y) * (b.x - a.x) / (b.y - a.y))
+            {
+                inside = !inside;
+            }
+        }
+        return inside;
+    }
+
+    // Get the polygon of the object in the world, moved by the given offset.
+    std::vector<glm::vec2> getWorldPolygon(const GameObject& object, glm::vec2 offset)
+    {
+        glm::mat4 model = geom::getModelMatrix(object.position + offset, object.size, object.rotation);
+        std::vector<glm::vec2> polygon;
+        for (glm::vec2 vertex : object.shape->getPolygon())
+        {
+            polygon.push_back(glm::vec2(model * glm::vec4(vertex, 0.0f, 1.0f)));
+        }
+        return polygon;
+    }
+
+    float getArea(const std::vector<glm::vec2>& polygon)
+    {
+        float area = 0.0f;
+        for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+        {
+            area += polygon[j].x * polygon[i].y - polygon[i].x * polygon[j].y;
+        }
+        return 0.5f * std::abs(area);
+    }
+
+    // Render a simulation whose only asteroid is the given one, the view of a world of one view starts at zero.
+    std::vector<unsigned char> renderAsteroid(const Asteroid& asteroid, std::size_t channels)
+    {
+        Simulation simulation;
+        test::replaceObjects(simulation, { asteroid }, {});
+        ObservationRasterizer rasterizer(WIDTH, HEIGHT, channels);
+        std::vector<unsigned char> frame(rasterizer.getFrameSize());
+        rasterizer.render(simulation, frame.data());
+        return frame;
+    }
+
+    Asteroid makeAsteroid(glm::vec2 position, float rotation)
+    {
+        Simulation simulation;
+        Asteroid asteroid = simulation.getAsteroids().front();
+        asteroid.position = position;
+        asteroid.rotation = rotation;
+        return asteroid;
+    }
+
+    // Exactly the pixels whose centers lie inside one of the polygons are covered in the asteroid channel.
+    // The polygons are copies of the asteroid, the parts of them inside the view make up one whole asteroid.
+    void checkCoverage(const Asteroid& asteroid, const std::vector<std::vector<glm::vec2>>& polygons)
+    {
+        std::vector<unsigned char> frame = renderAsteroid(asteroid, ObservationRasterizer::CHANNEL_COUNT);
+        const unsigned char* plane = frame.data() + ObservationRasterizer::CHANNEL_ASTEROIDS * WIDTH * HEIGHT;
+        std::size_t mismatches = 0;
+        std::size_t covered = 0;
+        for (std::size_t y = 0; y < HEIGHT; y++)
+        {
+            for (std::size_t x = 0; x < WIDTH; x++)
+            {
+                glm::vec2 center = glm::vec2(x + 0.5f, y + 0.5f);
+                bool inside = false;
+                for (const auto& polygon : polygons)
+                {
+                    inside = inside || containsPoint(polygon, center);
+                }
+                unsigned char pixel = plane[y * WIDTH + x];
+                mismatches += (pixel == (inside ? 255 : 0)) ? 0 : 1;
+                covered += pixel != 0 ? 1 : 0;
+            }
+        }
+        CHECK(mismatches == 0);
+        // Covered pixels approximate the area, the error is bounded by pixels along the edges
+        float area = getArea(polygons.front());
+        CHECK(std::abs(static_cast<float>(covered) - area) < 0.05f * area);
+    }
+
+    // Fractions of positions keep pixel centers off the edges of the asteroid polygon.
+    void testCoverageOfPolygon()
+    {
+        Asteroid asteroid = makeAsteroid(glm::vec2(100.2f, 200.7f), 0.0f);
+        checkCoverage(asteroid, { getWorldPolygon(asteroid, glm::vec2(0.0f)) });
+    }
+
+    void testCoverageOfRotatedPolygon()
+    {
+        Asteroid asteroid = makeAsteroid(glm::vec2(600.3f, 450.9f), 33.0f);
+        checkCoverage(asteroid, { getWorldPolygon(asteroid, glm::vec2(0.0f)) });
+    }
+
+    // An asteroid over the left edge of the world is also drawn at the right edge of the view.
+    void testCoverageAcrossEdge()
+    {
+        Asteroid asteroid = makeAsteroid(glm::vec2(-17.3f, 300.6f), 0.0f);
+        checkCoverage(asteroid, {
+            getWorldPolygon(asteroid, glm::vec2(0.0f)),
+            getWorldPolygon(asteroid, glm::vec2(static_cast<float>(WIDTH), 0.0f))
+        });
+    }
+
+    // Grayscale frames draw the same pixels with the intensity of asteroids, other channels stay empty.
+    void testChannelsOfAsteroid()
+    {
+        Asteroid asteroid = makeAsteroid(glm::vec2(100.2f, 200.7f), 0.0f);
+        std::vector<unsigned char> gray = renderAsteroid(asteroid, 1);
+        std::vector<unsigned char> channels = renderAsteroid(asteroid, ObservationRasterizer::CHANNEL_COUNT);
+        std::size_t planeSize = WIDTH * HEIGHT;
+        std::vector<glm::vec2> polygon = getWorldPolygon(asteroid, glm::vec2(0.0f));
+        std::size_t mismatches = 0;
+        for (std::size_t i = 0; i < planeSize; i++)
+        {
+            glm::vec2 center = glm::vec2(i % WIDTH + 0.5f, i / WIDTH + 0.5f);
+            // The player in the middle of the view is drawn in its own channel
+            if (channels[ObservationRasterizer::CHANNEL_PLAYER * planeSize + i] != 0)
+            {
+                mismatches += center.x < 300.0f ? 1 : 0;
+                continue;
+            }
+            mismatches += gray[i] == (containsPoint(polygon, center) ? 160 : 0) ? 0 : 1;
+            mismatches += channels[ObservationRasterizer::CHANNEL_BULLETS * planeSize + i] != 0 ? 1 : 0;
+            mismatches += channels[ObservationRasterizer::CHANNEL_REMNANTS * planeSize + i] != 0 ? 1 : 0;
+        }
+        CHECK(mismatches == 0);
+    }
+}
+
+int main()
+{
+    test::run("coverage of polygon", testCoverageOfPolygon);
+    test::run("coverage of rotated polygon", testCoverageOfRotatedPolygon);
+    test::run("coverage across edge", testCoverageAcrossEdge);
+    test::run("channels of asteroid", testChannelsOfAsteroid);
+    return test::getExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "Check.hpp"
+
+#include "Random.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    const std::size_t LANES = 4;    // Parallel sequences of fill
+
+    // Floats of fill computed by next(): lane l is a generator whose state is made of the words l, 4 + l, 8 + l
+    // and 12 + l of the sequence, value i is taken from lane i modulo 4.
+    std::vector<float> fillByNext(rnd::Generator generator, std::size_t count)
+    {
+        std::uint32_t words[4 * LANES];
+        for (auto&& word : words)
+        {
+            word = generator.next();
+        }
+        std::vector<rnd::Generator> lanes(LANES);
+        for (std::size_t lane = 0; lane < LANES; lane++)
+        {
+            lanes[lane].setState({ words[lane], words[LANES + lane], words[2 * LANES + lane], words[3 * LANES + lane] });
+        }
+        std::vector<float> values(count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            values[i] = lanes[i % LANES].getFloat();
+        }
+        return values;
+    }
+
+    // The SSE path of fill gives the same floats as the scalar generator, also for counts that are not multiples of lanes.
+    void testFillMatchesNext()
+    {
+        for (std::size_t count : { 0, 1, 3, 4, 5, 64, 1001 })
+        {
+            rnd::Generator generator(38, 2);
+            std::vector<float> expected = fillByNext(generator, count);
+            std::vector<float> values(count);
+            generator.fill(values.data(), count);
+            CHECK(values == expected);
+            // The generator moves past the words used by the lanes
+            rnd::Generator advanced(38, 2);
+            for (std::size_t i = 0; i < 4 * LANES; i++)
+            {
+                advanced.next();
+            }
+            CHECK(generator.getState() == advanced.getState());
+        }
+        rnd::Generator generator(5);
+        std::vector<float> expected = fillByNext(generator, 333);
+        std::vector<float> values(333);
+        generator.fill(values.data(), values.size(), -2.0f, 6.0f);
+        bool inRange = true;
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            inRange = inRange && values[i] == -2.0f + expected[i] * 8.0f && values[i] >= -2.0f && values[i] < 6.0f;
+        }
+        CHECK(inRange);
+    }
+
+    void testStateIsRestored()
+    {
+        rnd::Generator generator(17, 3);
+        for (int i = 0; i < 100; i++)
+        {
+            generator.next();
+        }
+        rnd::Generator::State state = generator.getState();
+        std::vector<std::uint32_t> sequence;
+        for (int i = 0; i < 100; i++)
+        {
+            sequence.push_back(generator.next());
+        }
+        rnd::Generator restored(999);
+        restored.setState(state);
+        std::vector<std::uint32_t> restoredSequence;
+        for (int i = 0; i < 100; i++)
+        {
+            restoredSequence.push_back(restored.next());
+        }
+        CHECK(sequence == restoredSequence);
+        rnd::Generator reseeded(1);
+        reseeded.setSeed(17, 3);
+        CHECK(reseeded.getState() == rnd::Generator(17, 3).getState());
+    }
+
+    // Sequences of different streams and seeds differ in about half of their bits and never share a value
+    // at the same position.
+    void testStreamsAreIndependent()
+    {
+        const int VALUE_COUNT = 10000;
+        rnd::Generator base(7, 0);
+        rnd::Generator others[] = { rnd::Generator(7, 1), rnd::Generator(7, 2), rnd::Generator(8, 0) };
+        std::vector<std::uint32_t> baseValues;
+        for (int i = 0; i < VALUE_COUNT; i++)
+        {
+            baseValues.push_back(base.next());
+        }
+        for (auto&& other : others)
+        {
+            std::size_t differentBits = 0;
+            std::size_t equalValues = 0;
+            for (int i = 0; i < VALUE_COUNT; i++)
+            {
+                std::uint32_t value = other.next();
+                differentBits += std::bitset<32>(value ^ baseValues[i]).count();
+                equalValues += value == baseValues[i] ? 1 : 0;
+            }
+            double ratio = static_cast<double>(differentBits) / (32.0 * VALUE_COUNT);
+            CHECK(ratio > 0.49 && ratio < 0.51);
+            CHECK(equalValues == 0);
+        }
+    }
+
+    void testRanges()
+    {
+        rnd::Generator generator(3);
+        std::vector<int> counts(7, 0);
+        bool inRange = true;
+        for (int i = 0; i < 70000; i++)
+        {
+            float value = generator.getFloat(2.0f, 3.0f);
+            inRange = inRange && value >= 2.0f && value < 3.0f;
+            ++counts[generator.getInt(6)];
+        }
+        CHECK(inRange);
+        for (int count : counts)
+        {
+            CHECK(count > 9000 && count < 11000);
+        }
+    }
+}
+
+int main()
+{
+    test::run("fill matches next", testFillMatchesNext);
+    test::run("state is restored", testStateIsRestored);
+    test::run("streams are independent", testStreamsAreIndependent);
+    test::run("ranges", testRanges);
+    return test::getExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "Check.hpp"
+#include "TestInputs.hpp"
+
+#include "Replay.hpp"
+#include "Simulation.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const unsigned int SEED = 5;
+    const std::size_t TICK_COUNT = 3000;
+    const char* const REPLAY_PATH = "ReplayTests.replay";
+
+    // Play a game by the inputs and record it the same way as Game does, with keyframes.
+    // States of the simulation before every update and after the last one are returned.
+    std::vector<std::vector<unsigned char>> recordGame(Replay& replay, const std::vector<InputState>& inputs)
+    {
+        Simulation simulation(replay.getSeed());
+        std::vector<std::vector<unsigned char>> states;
+        for (const auto& input : inputs)
+        {
+            states.push_back(simulation.saveState());
+            if (replay.needsKeyframe())
+            {
+                replay.addKeyframe(states.back());
+            }
+            replay.record(input);
+            simulation.step(input);
+        }
+        states.push_back(simulation.saveState());
+        return states;
+    }
+
+    std::vector<unsigned char> playBack(const Replay& replay)
+    {
+        Simulation simulation(replay.getSeed());
+        Replay::Cursor cursor(replay);
+        InputState input;
+        while (cursor.next(input))
+        {
+            simulation.step(input);
+        }
+        return simulation.saveState();
+    }
+
+    void testPlaybackIsDeterministic()
+    {
+        Replay replay(SEED);
+        std::vector<std::vector<unsigned char>> states = recordGame(replay, test::makeInputs(TICK_COUNT, SEED));
+        CHECK(replay.getTickCount() == TICK_COUNT);
+        CHECK(playBack(replay) == states.back());
+    }
+
+    void testFileRoundTrip()
+    {
+        Replay replay(SEED);
+        std::vector<std::vector<unsigned char>> states = recordGame(replay, test::makeInputs(TICK_COUNT, SEED));
+        replay.save(REPLAY_PATH);
+        Replay loaded = Replay::load(REPLAY_PATH);
+        std::remove(REPLAY_PATH);
+        CHECK(loaded.getSeed() == SEED);
+        CHECK(loaded.getTickCount() == TICK_COUNT);
+        CHECK(loaded.getRuns().size() == replay.getRuns().size());
+        for (std::size_t i = 0; i < loaded.getRuns().size() && i < replay.getRuns().size(); i++)
+        {
+            CHECK(loaded.getRuns()[i].buttons == replay.getRuns()[i].buttons);
+            CHECK(loaded.getRuns()[i].length == replay.getRuns()[i].length);
+        }
+        CHECK(loaded.getKeyframes().size() == replay.getKeyframes().size());
+        CHECK(playBack(loaded) == states.back());
+    }
+
+    // Seeking restores the nearest keyframe and simulates the rest, the state must equal the recorded one.
+    void testSeekMatchesRecordedStates()
+    {
+        Replay replay(SEED, 250);
+        std::vector<std::vector<unsigned char>> states = recordGame(replay, test::makeInputs(TICK_COUNT, SEED));
+        replay.save(REPLAY_PATH);
+        {
+            ReplayReader reader(REPLAY_PATH);
+            CHECK(reader.getTickCount() == TICK_COUNT);
+            CHECK(reader.getKeyframeCount() == replay.getKeyframes().size());
+            const Tick ticks[] = { 0, 1, 249, 250, 251, 1234, TICK_COUNT - 1, TICK_COUNT };
+            for (Tick tick : ticks)
+            {
+                Simulation simulation(SEED);
+                CHECK(reader.seek(simulation, tick) == tick);
+                CHECK(simulation.saveState() == states[tick]);
+            }
+            // Seeking backwards from a later state works as well
+            Simulation simulation(SEED);
+            reader.seek(simulation, 2000);
+            reader.seek(simulation, 100);
+            CHECK(simulation.saveState() == states[100]);
+        }
+        std::remove(REPLAY_PATH);
+    }
+}
+
+int main()
+{
+    test::run("playback is deterministic", testPlaybackIsDeterministic);
+    test::run("replay file round trip", testFileRoundTrip);
+    test::run("seek matches recorded states", testSeekMatchesRecordedStates);
+    return test::getExitCode();
+}
\ No newline at end of file
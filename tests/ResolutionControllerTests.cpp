@@ -0,0 +1,146 @@
+#include "Check.hpp"
+
+#include "ResolutionController.hpp"
+
+#include <cmath>
+#include <deque>
+#include <stdexcept>
+
+namespace
+{
+    const double BUDGET = 0.010;
+    const unsigned int DELAY = 3;      // Frames before a measurement of the GPU arrives
+
+    /**
+    * Renders frames with a cost proportional to the area and measures them a few frames late.
+    */
+    class DelayedGpu final
+    {
+    public:
+        explicit DelayedGpu(double fullCost)
+            : m_fullCost(fullCost)
+        {
+        }
+
+        void setFullCost(double fullCost)
+        {
+            m_fullCost = fullCost;
+        }
+
+        // Draw a frame with the scale of the controller and pass it the measurement that arrived.
+        // Returns the drawing time of the frame.
+        double drawFrame(ResolutionController& controller)
+        {
+            float scale = controller.getScale();
+            double time = m_fullCost * scale * scale;
+            m_pending.push_back({ time, scale });
+            if (m_pending.size() > DELAY)
+            {
+                Measurement measurement = m_pending.front();
+                m_pending.pop_front();
+                controller.update(measurement.time, measurement.scale);
+            }
+            return time;
+        }
+
+    private:
+        struct Measurement
+        {
+            double time;
+            float scale;
+        };
+
+        double m_fullCost;
+        std::deque<Measurement> m_pending;
+    };
+
+    double drawFrames(DelayedGpu& gpu, ResolutionController& controller, unsigned int count)
+    {
+        double time = 0.0;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            time = gpu.drawFrame(controller);
+        }
+        return time;
+    }
+
+    void testConvergesToBudget()
+    {
+        ResolutionController controller(BUDGET);
+        DelayedGpu gpu(2.0 * BUDGET);
+        float previousScale = controller.getScale();
+        bool monotonic = true;
+        double time = 0.0;
+        for (unsigned int i = 0; i < 200; i++)
+        {
+            time = gpu.drawFrame(controller);
+            monotonic = monotonic && controller.getScale() <= previousScale;
+            previousScale = controller.getScale();
+        }
+        // The delay must not make the scale overshoot and oscillate
+        CHECK(monotonic);
+        CHECK(std::abs(time - BUDGET) <= 0.05 * BUDGET + 1e-9);
+        CHECK(std::abs(controller.getScale() - std::sqrt(0.5f)) < 0.02f);
+    }
+
+    void testRecoversFullResolution()
+    {
+        ResolutionController controller(BUDGET);
+        DelayedGpu gpu(2.0 * BUDGET);
+        drawFrames(gpu, controller, 200);
+        CHECK(controller.getScale() < 0.75f);
+        gpu.setFullCost(0.5 * BUDGET);
+        drawFrames(gpu, controller, 200);
+        CHECK(controller.getScale() == 1.0f);
+    }
+
+    void testScaleIsClampedToMinimum()
+    {
+        ResolutionController controller(BUDGET, 0.6f);
+        DelayedGpu gpu(10.0 * BUDGET);
+        drawFrames(gpu, controller, 200);
+        CHECK(controller.getScale() == 0.6f);
+    }
+
+    void testSmallDifferenceIsIgnored()
+    {
+        ResolutionController controller(BUDGET);
+        controller.update(1.04 * BUDGET, 1.0f);
+        controller.update(0.96 * BUDGET, 1.0f);
+        CHECK(controller.getScale() == 1.0f);
+        controller.update(0.0, 1.0f);
+        controller.update(2.0 * BUDGET, 0.0f);
+        CHECK(controller.getScale() == 1.0f);
+        controller.update(1.2 * BUDGET, 1.0f);
+        CHECK(controller.getScale() < 1.0f);
+    }
+
+    void testInvalidArgumentsAreRejected()
+    {
+        const double budgets[] = { BUDGET, 0.0, -BUDGET, BUDGET, BUDGET };
+        const float minScales[] = { 1.0f, 0.5f, 0.5f, 0.0f, 1.5f };
+        for (unsigned int i = 0; i < 5; i++)
+        {
+            bool thrown = false;
+            try
+            {
+                ResolutionController controller(budgets[i], minScales[i]);
+            }
+            catch (const std::invalid_argument&)
+            {
+                thrown = true;
+            }
+            CHECK(thrown == (i != 0));
+        }
+    }
+}
+
+int main()
+{
+    test::run("converges to budget", testConvergesToBudget);
+    test::run("recovers full resolution", testRecoversFullResolution);
+    test::run("scale is clamped to minimum", testScaleIsClampedToMinimum);
+    test::run("small difference is ignored", testSmallDifferenceIsIgnored);
+    test::run("invalid arguments are rejected", testInvalidArgumentsAreRejected);
+    return test::getExitCode();
+}
\ No newline at end of file
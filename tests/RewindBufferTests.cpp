@@ -0,0 +1,111 @@
+#include "Check.hpp"
+#include "TestInputs.hpp"
+
+#include "RewindBuffer.hpp"
+#include "Simulation.hpp"
+
+#include <vector>
+
+namespace
+{
+    // States of the simulation after every update, the first one is the state before the first update.
+    std::vector<std::vector<unsigned char>> playGame(Simulation& simulation, const std::vector<InputState>& inputs)
+    {
+        std::vector<std::vector<unsigned char>> states{ simulation.saveState() };
+        for (const auto& input : inputs)
+        {
+            simulation.step(input);
+            states.push_back(simulation.saveState());
+        }
+        return states;
+    }
+
+    void testStepBackRestoresStates()
+    {
+        Simulation simulation(7);
+        std::vector<std::vector<unsigned char>> states = playGame(simulation, test::makeInputs(1000, 7));
+        RewindBuffer rewind(300, 32 * 1024 * 1024);
+        for (const auto& state : states)
+        {
+            rewind.push(std::vector<unsigned char>(state));
+        }
+        CHECK(rewind.getSize() == 300);
+        CHECK(rewind.getState() == states.back());
+        for (std::size_t back = 1; back <= 300; back++)
+        {
+            CHECK(rewind.stepBack());
+            CHECK(rewind.getState() == states[states.size() - 1 - back]);
+        }
+        CHECK(!rewind.stepBack());
+    }
+
+    // Playing the same inputs after rewinding gives the same game as before, as rewinding in Game relies on.
+    void testResimulationIsDeterministic()
+    {
+        std::vector<InputState> inputs = test::makeInputs(1500, 8);
+        Simulation simulation(8);
+        std::vector<std::vector<unsigned char>> states = playGame(simulation, inputs);
+        RewindBuffer rewind(600, 32 * 1024 * 1024);
+        for (const auto& state : states)
+        {
+            rewind.push(std::vector<unsigned char>(state));
+        }
+        for (std::size_t i = 0; i < 500; i++)
+        {
+            rewind.stepBack();
+        }
+        std::size_t tick = states.size() - 1 - 500;
+        Simulation replayed(8);
+        replayed.loadState(rewind.getState().data(), rewind.getState().size());
+        for (std::size_t i = tick; i < inputs.size(); i++)
+        {
+            replayed.step(inputs[i]);
+            CHECK(replayed.saveState() == states[i + 1]);
+        }
+    }
+
+    void testStatesOfDifferentLengths()
+    {
+        std::vector<std::vector<unsigned char>> states{
+            { 1, 2, 3 }, { 1, 2, 3, 4, 5, 6, 7, 8 }, {}, { 9 }, std::vector<unsigned char>(1000, 0), { 0, 0, 7 }
+        };
+        RewindBuffer rewind(10, 1024);
+        for (const auto& state : states)
+        {
+            rewind.push(std::vector<unsigned char>(state));
+        }
+        for (std::size_t i = states.size() - 1; i > 0; i--)
+        {
+            CHECK(rewind.getState() == states[i]);
+            CHECK(rewind.stepBack());
+        }
+        CHECK(rewind.getState() == states.front());
+    }
+
+    void testMemoryBudgetDropsOldest()
+    {
+        RewindBuffer rewind(100, 256);
+        for (unsigned char i = 0; i < 50; i++)
+        {
+            rewind.push(std::vector<unsigned char>(64, i));
+        }
+        // Each delta stores 64 changed bytes, so only a few of them fit the budget
+        CHECK(rewind.getSize() > 0);
+        CHECK(rewind.getSize() < 50);
+        std::size_t size = rewind.getSize();
+        for (std::size_t i = 1; i <= size; i++)
+        {
+            CHECK(rewind.stepBack());
+            CHECK(rewind.getState() == std::vector<unsigned char>(64, static_cast<unsigned char>(49 - i)));
+        }
+    }
+}
+
+int main()
+{
+    test::run("step back restores states", testStepBackRestoresStates);
+    test::run("resimulation is deterministic", testResimulationIsDeterministic);
+    test::run("states of different lengths", testStatesOfDifferentLengths);
+    test::run("memory budget drops oldest", testMemoryBudgetDropsOldest);
+    return test::getExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "Check.hpp"
+#include "TestInputs.hpp"
+
+#include "RollbackSession.hpp"
+#include "Simulation.hpp"
+#include "Transport.hpp"
+#include "Clock.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+    const unsigned int SEED = 11;
+    const Tick TICKS = 1200;
+    const std::size_t ROLLBACK_BUDGET = 8;
+    const double MAX_ROLLBACK_TIME = 0.016;     // Rolling back the whole budget must fit into a frame
+
+    struct Result
+    {
+        std::vector<unsigned char> state1;
+        std::vector<unsigned char> state2;
+        RollbackSession::Stats stats1;
+        RollbackSession::Stats stats2;
+        std::uint64_t lost;
+    };
+
+    // The first peer only moves, the second one only shoots, so both inputs change the game.
+    std::vector<InputState> makePeerInputs(unsigned int seed, unsigned char buttons)
+    {
+        std::vector<InputState> inputs = test::makeInputs(TICKS, seed);
+        for (auto& input : inputs)
+        {
+            input = InputState(input.buttons & buttons);
+        }
+        return inputs;
+    }
+
+    // Run both peers once per frame of a manual clock until all their inputs are confirmed.
+    Result runPeers(const LinkConditions& conditions, const std::vector<InputState>& inputs1, const std::vector<InputState>& inputs2)
+    {
+        auto clock = std::make_shared<ManualClock>();
+        auto transports = LoopbackTransport::createPair(clock, conditions, SEED);
+        Simulation simulation1(SEED);
+        Simulation simulation2(SEED);
+        RollbackSession session1(simulation1, *transports.first, ROLLBACK_BUDGET);
+        RollbackSession session2(simulation2, *transports.second, ROLLBACK_BUDGET);
+        while (session1.getConfirmedTick() < TICKS || session2.getConfirmedTick() < TICKS)
+        {
+            if (session1.getTick() < TICKS)
+            {
+                session1.advance(inputs1[session1.getTick()]);
+            }
+            else
+            {
+                session1.poll();
+            }
+            if (session2.getTick() < TICKS)
+            {
+                session2.advance(inputs2[session2.getTick()]);
+            }
+            else
+            {
+                session2.poll();
+            }
+            // Neither peer may run ahead of the confirmed input of the other by more than the budget
+            CHECK(session1.getTick() <= session1.getConfirmedTick() + ROLLBACK_BUDGET);
+            CHECK(session2.getTick() <= session2.getConfirmedTick() + ROLLBACK_BUDGET);
+            clock->advance(Simulation::getUpdateInterval());
+        }
+        return Result{ simulation1.saveState(), simulation2.saveState(), session1.getStats(), session2.getStats(),
+            transports.first->getLostCount() + transports.second->getLostCount() };
+    }
+
+    std::vector<unsigned char> runReference(const std::vector<InputState>& inputs1, const std::vector<InputState>& inputs2)
+    {
+        Simulation reference(SEED);
+        for (Tick tick = 0; tick < TICKS; tick++)
+        {
+            reference.step(InputState(inputs1[tick].buttons | inputs2[tick].buttons));
+        }
+        return reference.saveState();
+    }
+
+    void checkStats(const RollbackSession::Stats& stats)
+    {
+        CHECK(stats.maxRollbackTicks <= ROLLBACK_BUDGET);
+        CHECK(stats.maxRollbackTime < MAX_ROLLBACK_TIME);
+    }
+
+    void checkLink(const LinkConditions& conditions, bool expectStalls)
+    {
+        const unsigned char movement = InputState::BUTTON_LEFT | InputState::BUTTON_RIGHT | InputState::BUTTON_FORWARD;
+        std::vector<InputState> inputs1 = makePeerInputs(1, movement);
+        std::vector<InputState> inputs2 = makePeerInputs(2, InputState::BUTTON_SHOOT);
+        Result result = runPeers(conditions, inputs1, inputs2);
+        std::vector<unsigned char> reference = runReference(inputs1, inputs2);
+        CHECK(result.state1 == reference);
+        CHECK(result.state2 == reference);
+        CHECK(result.stats1.rollbacks > 0 && result.stats2.rollbacks > 0);
+        CHECK(result.lost > 0 || conditions.loss == 0.0);
+        CHECK((result.stats1.stalls + result.stats2.stalls > 0) == expectStalls);
+        checkStats(result.stats1);
+        checkStats(result.stats2);
+    }
+
+    // Inputs arrive within the budget, mispredictions are corrected by rollbacks without stalls.
+    void testPeersMatchReference()
+    {
+        checkLink(LinkConditions(0.040, 0.020, 0.05), false);
+    }
+
+    // The remote input is older than the budget allows, the peers stall instead of rolling back further.
+    void testSlowLinkStallsWithinBudget()
+    {
+        checkLink(LinkConditions(0.150, 0.030, 0.10), true);
+    }
+}
+
+int main()
+{
+    test::run("peers match reference", testPeersMatchReference);
+    test::run("slow link stalls within budget", testSlowLinkStallsWithinBudget);
+    return test::getExitCode();
+}
\ No newline at end of file
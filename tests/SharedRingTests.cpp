@@ -0,0 +1,169 @@
+#include "Check.hpp"
+
+#include "SharedRing.hpp"
+#include "SharedMemory.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Names are unique, so that concurrent runs of the tests do not share rings.
+    std::string getUniqueName(const char* prefix)
+    {
+        return std::string("sg-test-") + prefix + "-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+
+    void publish(SharedRing& ring, std::uint64_t tick, std::size_t size)
+    {
+        unsigned char* data = ring.beginWrite(tick);
+        std::memset(data, static_cast<int>(tick & 0xFF), size);
+        ring.endWrite(size);
+    }
+
+    void testReadPublishedMessages()
+    {
+        std::string name = getUniqueName("ring");
+        SharedRing writer(name, 4, 100);
+        SharedRing reader(name);
+        CHECK(reader.getSlotCount() == 4);
+        CHECK(reader.getSlotSize() == 100);
+        std::vector<unsigned char> message;
+        std::uint64_t tick = 0;
+        CHECK(reader.getPublishedCount() == 0);
+        CHECK(!reader.read(0, message, tick));
+        for (std::uint64_t i = 0; i < 6; i++)
+        {
+            publish(writer, 1000 + i, static_cast<std::size_t>(10 * i));
+        }
+        CHECK(reader.getPublishedCount() == 6);
+        // Messages 0 and 1 were overwritten by 4 and 5, message 6 was not published yet
+        CHECK(!reader.read(0, message, tick));
+        CHECK(!reader.read(1, message, tick));
+        CHECK(!reader.read(6, message, tick));
+        for (std::uint64_t i = 2; i < 6; i++)
+        {
+            CHECK(reader.read(i, message, tick));
+            CHECK(tick == 1000 + i);
+            CHECK(message == std::vector<unsigned char>(10 * i, static_cast<unsigned char>((1000 + i) & 0xFF)));
+        }
+    }
+
+    void testTooLargeMessageIsRejected()
+    {
+        SharedRing ring(getUniqueName("large"), 2, 16);
+        ring.beginWrite(1);
+        bool thrown = false;
+        try
+        {
+            ring.endWrite(17);
+        }
+        catch (const std::logic_error&)
+        {
+            thrown = true;
+        }
+        CHECK(thrown);
+        CHECK(ring.getPublishedCount() == 0);
+    }
+
+    void testMissingRingIsRejected()
+    {
+        bool thrown = false;
+        try
+        {
+            SharedRing ring(getUniqueName("missing"));
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        CHECK(thrown);
+    }
+
+    // Check whether a reader rejects a ring of 4 slots of 16 bytes whose header was changed to the given slots.
+    bool isHeaderRejected(std::uint32_t slotCount, std::uint32_t slotSize)
+    {
+        std::string name = getUniqueName("header");
+        SharedRing writer(name, 4, 16);
+        SharedMemory memory(name);
+        SharedRing::Header* header = reinterpret_cast<SharedRing::Header*>(memory.getData());
+        header->slotCount = slotCount;
+        header->slotSize = slotSize;
+        try
+        {
+            SharedRing ring(name);
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    // The header is written by another process, slots it declares must exist and fit the memory.
+    void testInvalidHeaderIsRejected()
+    {
+        CHECK(!isHeaderRejected(4, 16));
+        CHECK(isHeaderRejected(0, 16));
+        CHECK(isHeaderRejected(5, 16));
+        CHECK(isHeaderRejected(UINT32_MAX, 16));
+        CHECK(isHeaderRejected(UINT32_MAX, UINT32_MAX));
+    }
+
+    // A reader racing the writer must never accept a message mixed from two writes.
+    void testConcurrentReadsAreConsistent()
+    {
+        const std::uint64_t MESSAGE_COUNT = 200000;
+        const std::size_t SLOT_SIZE = 4096;
+        std::string name = getUniqueName("race");
+        SharedRing writer(name, 2, SLOT_SIZE);
+        SharedRing reader(name);
+        std::atomic<bool> finished(false);
+        std::thread writerThread([&]()
+            {
+                for (std::uint64_t tick = 1; tick <= MESSAGE_COUNT; tick++)
+                {
+                    publish(writer, tick, static_cast<std::size_t>(tick % SLOT_SIZE));
+                }
+                finished.store(true, std::memory_order_release);
+            });
+        std::vector<unsigned char> message;
+        std::size_t accepted = 0;
+        std::size_t inconsistent = 0;
+        while (!finished.load(std::memory_order_acquire))
+        {
+            std::uint64_t count = reader.getPublishedCount();
+            std::uint64_t tick = 0;
+            if (count == 0 || !reader.read(count - 1, message, tick))
+            {
+                continue;
+            }
+            ++accepted;
+            bool consistent = tick == count && message.size() == tick % SLOT_SIZE;
+            for (unsigned char byte : message)
+            {
+                consistent = consistent && byte == static_cast<unsigned char>(tick & 0xFF);
+            }
+            inconsistent += consistent ? 0 : 1;
+        }
+        writerThread.join();
+        CHECK(accepted > 0);
+        CHECK(inconsistent == 0);
+    }
+}
+
+int main()
+{
+    test::run("read published messages", testReadPublishedMessages);
+    test::run("too large message is rejected", testTooLargeMessageIsRejected);
+    test::run("missing ring is rejected", testMissingRingIsRejected);
+    test::run("invalid header is rejected", testInvalidHeaderIsRejected);
+    test::run("concurrent reads are consistent", testConcurrentReadsAreConsistent);
+    return test::getExitCode();
+}
\ No newline at end of file
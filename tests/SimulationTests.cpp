@@ -0,0 +1,279 @@
+#include "Check.hpp"
+#include "TestObjects.hpp"
+
+#include "Simulation.hpp"
+#include "InputState.hpp"
+#include "JobSystem.hpp"
+#include "HullBuffer.hpp"
+#include "CollisionStats.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    bool containsObject(const std::vector<Asteroid>& asteroids, std::uint64_t id)
+    {
+        return std::any_of(asteroids.begin(), asteroids.end(), [id](const Asteroid& asteroid) { return asteroid.id == id; });
+    }
+
+    void startGame(Simulation& simulation)
+    {
+        while (simulation.getState() != Simulation::State::Running)
+        {
+            simulation.step(InputState());
+        }
+    }
+
+    // A bullet fired from a moving ship flies farther than the box of asteroids near the player,
+    // a far asteroid in its way must still be hit.
+    void testBulletHitsFarAsteroid()
+    {
+        Simulation simulation(1, 10);
+        startGame(simulation);
+        InputState shoot;
+        shoot.press(InputState::BUTTON_SHOOT);
+        simulation.step(shoot);
+        CHECK(simulation.getBullets().size() == 1);
+        const Player& player = simulation.getPlayer();
+        glm::vec2 playerCenter = player.position + player.size / 2.0f;
+        // Just outside of the near box, whose half size is half of the view plus the bullet range
+        glm::vec2 viewSize = simulation.getViewSize();
+        glm::vec2 offset = glm::vec2(viewSize.x / 2.0f + std::min(viewSize.x, viewSize.y) + 100.0f, 0.0f);
+        Asteroid asteroid = simulation.getAsteroids().front();
+        asteroid.position = playerCenter + offset - asteroid.size / 2.0f;
+        asteroid.velocity = glm::vec2(0.0f);
+        asteroid.rotationSpeed = 0.0f;
+        asteroid.displacement = glm::vec2(0.0f);
+        Bullet bullet = simulation.getBullets().front();
+        bullet.position = playerCenter + offset - glm::vec2(60.0f, 0.0f) - bullet.size / 2.0f;
+        bullet.velocity = glm::vec2(600.0f, 0.0f);
+        bullet.resetPreviousPosition();
+        test::replaceObjects(simulation, { asteroid }, { bullet });
+        std::uint64_t score = simulation.getScore();
+        for (int i = 0; i < 10; i++)
+        {
+            simulation.step(InputState());
+        }
+        CHECK(simulation.getScore() == score + 1);
+        CHECK(!containsObject(simulation.getAsteroids(), asteroid.id));
+    }
+
+    // The simulation reads only the given controls, turning, thrust and shooting act on the player,
+    // the quit button is left to the presentation.
+    void testControlsDrivePlayer()
+    {
+        auto runWith = [](unsigned char buttons)
+        {
+            auto simulation = std::make_unique<Simulation>(3);
+            startGame(*simulation);
+            for (int i = 0; i < 10; i++)
+            {
+                simulation->step(InputState(buttons));
+            }
+            return simulation;
+        };
+        auto idle = runWith(0);
+        auto left = runWith(InputState::BUTTON_LEFT);
+        auto right = runWith(InputState::BUTTON_RIGHT);
+        auto forward = runWith(InputState::BUTTON_FORWARD);
+        auto shoot = runWith(InputState::BUTTON_SHOOT);
+        auto quit = runWith(InputState::BUTTON_QUIT);
+        float idleRotation = idle->getPlayer().rotation;
+        CHECK(left->getPlayer().rotation != idleRotation && right->getPlayer().rotation != idleRotation);
+        CHECK(left->getPlayer().rotation != right->getPlayer().rotation);
+        CHECK(idle->getPlayer().velocity == glm::vec2(0.0f));
+        CHECK(forward->getPlayer().velocity != glm::vec2(0.0f));
+        CHECK(idle->getBullets().empty() && !shoot->getBullets().empty());
+        CHECK(quit->saveState() == idle->saveState());
+    }
+
+    void testRestartReturnsToLevelOne()
+    {
+        Simulation simulation(5);
+        Simulation fresh(5);
+        startGame(simulation);
+        InputState shoot;
+        shoot.press(InputState::BUTTON_SHOOT);
+        for (int i = 0; i < 100; i++)
+        {
+            simulation.step(shoot);
+        }
+        simulation.restart();
+        CHECK(simulation.getState() == Simulation::State::Start);
+        CHECK(simulation.getLevel() == 1 && simulation.getScore() == 0);
+        CHECK(simulation.getBullets().empty() && simulation.getRemnants().empty());
+        CHECK(simulation.getAsteroids().size() == fresh.getAsteroids().size());
+        CHECK(simulation.getPlayer().position == fresh.getPlayer().position);
+        CHECK(simulation.getTick() > fresh.getTick());
+    }
+
+    // Objects left after one update of stationary objects, and the number of collision events found.
+    struct DetectionResult
+    {
+        std::vector<std::uint64_t> asteroids;
+        std::vector<std::uint64_t> bullets;
+        std::size_t hits;
+    };
+
+    // Place rows of overlapping stationary asteroids across several detection chunks. Bullets between neighbouring
+    // asteroids, also neighbours in different chunks, and pairs of bullets in one asteroid make the order of events
+    // decide the result. Some asteroids survive, otherwise the next level would replace them.
+    void makeCrowd(const Simulation& simulation, std::vector<Asteroid>& asteroids, std::vector<Bullet>& bullets)
+    {
+        const std::size_t ROW_LENGTH = 20;
+        const float SPACING = 35.0f;
+        Asteroid asteroid = simulation.getAsteroids().front();
+        asteroid.velocity = glm::vec2(0.0f);
+        asteroid.rotationSpeed = 0.0f;
+        asteroid.displacement = glm::vec2(0.0f);
+        Bullet bullet = simulation.getBullets().front();
+        bullet.velocity = glm::vec2(0.0f);
+        std::uint64_t asteroidId = asteroid.id + 1000;
+        std::uint64_t bulletId = bullet.id + 1000;
+        for (float rowY : { 40.0f, 500.0f })
+        {
+            for (std::size_t i = 0; i < ROW_LENGTH; i++)
+            {
+                asteroid.id = asteroidId++;
+                asteroid.position = glm::vec2(40.0f + SPACING * i, rowY);
+                asteroids.push_back(asteroid);
+                glm::vec2 center = asteroid.position + asteroid.size / 2.0f;
+                glm::vec2 between = glm::vec2(asteroid.position.x + asteroid.size.x - 2.5f, center.y);
+                for (glm::vec2 bulletCenter : { between, center, center })
+                {
+                    if (bulletCenter == between ? i % 2 == 1 : i % 3 == 0)
+                    {
+                        bullet.id = bulletId++;
+                        bullet.position = bulletCenter - bullet.size / 2.0f;
+                        bullet.resetPreviousPosition();
+                        bullets.push_back(bullet);
+                    }
+                }
+            }
+        }
+    }
+
+    // Detect and resolve collisions by a serial loop over asteroids and bullets, as the simulation does in one update.
+    DetectionResult detectSerially(const std::vector<Asteroid>& asteroids, const std::vector<Bullet>& bullets)
+    {
+        std::vector<Asteroid> targets = asteroids;
+        std::vector<Bullet> shots = bullets;
+        HullBuffer hulls;
+        for (auto&& asteroid : targets)
+        {
+            asteroid.updateBounds(hulls);
+        }
+        for (auto&& bullet : shots)
+        {
+            bullet.updateBounds(hulls);
+        }
+        std::vector<bool> destroyedAsteroids(targets.size(), false);
+        std::vector<bool> destroyedBullets(shots.size(), false);
+        std::vector<std::size_t> hitsPerBullet(shots.size(), 0);
+        std::size_t hitsPerAsteroid = 0;
+        CollisionStats stats;
+        DetectionResult result = DetectionResult();
+        for (std::size_t asteroid = 0; asteroid < targets.size(); asteroid++)
+        {
+            std::size_t asteroidHits = 0;
+            for (std::size_t bullet = 0; bullet < shots.size(); bullet++)
+            {
+                if (shots[bullet].hits(targets[asteroid], glm::vec2(0.0f), hulls, stats))
+                {
+                    ++result.hits;
+                    ++asteroidHits;
+                    ++hitsPerBullet[bullet];
+                    if (!destroyedAsteroids[asteroid] && !destroyedBullets[bullet])
+                    {
+                        destroyedAsteroids[asteroid] = true;
+                        destroyedBullets[bullet] = true;
+                    }
+                }
+            }
+            hitsPerAsteroid = std::max(hitsPerAsteroid, asteroidHits);
+        }
+        // The crowd must contain both kinds of conflicts, or any order of events would give the same result
+        CHECK(hitsPerAsteroid > 1);
+        CHECK(*std::max_element(hitsPerBullet.begin(), hitsPerBullet.end()) > 1);
+        for (std::size_t i = 0; i < targets.size(); i++)
+        {
+            if (!destroyedAsteroids[i])
+            {
+                result.asteroids.push_back(targets[i].id);
+            }
+        }
+        for (std::size_t i = 0; i < shots.size(); i++)
+        {
+            if (!destroyedBullets[i])
+            {
+                result.bullets.push_back(shots[i].id);
+            }
+        }
+        return result;
+    }
+
+    DetectionResult detectInSimulation(Simulation& simulation, const std::vector<Asteroid>& asteroids,
+        const std::vector<Bullet>& bullets)
+    {
+        test::replaceObjects(simulation, asteroids, bullets);
+        std::size_t hits = simulation.getCollisionStats().hits;
+        simulation.step(InputState());
+        DetectionResult result = DetectionResult();
+        result.hits = simulation.getCollisionStats().hits - hits;
+        for (const auto& asteroid : simulation.getAsteroids())
+        {
+            result.asteroids.push_back(asteroid.id);
+        }
+        for (const auto& bullet : simulation.getBullets())
+        {
+            result.bullets.push_back(bullet.id);
+        }
+        return result;
+    }
+
+    // Collisions detected in parallel chunks are resolved exactly as if they were detected by one serial loop,
+    // whatever the number of threads.
+    void testChunkedDetectionMatchesSerial()
+    {
+        std::vector<DetectionResult> results;
+        std::vector<Asteroid> asteroids;
+        std::vector<Bullet> bullets;
+        for (std::size_t threadCount : { 1u, 2u, 7u })
+        {
+            JobSystem jobs(threadCount);
+            Simulation simulation(1, jobs);
+            startGame(simulation);
+            InputState shoot;
+            shoot.press(InputState::BUTTON_SHOOT);
+            simulation.step(shoot);
+            asteroids.clear();
+            bullets.clear();
+            makeCrowd(simulation, asteroids, bullets);
+            results.push_back(detectInSimulation(simulation, asteroids, bullets));
+        }
+        DetectionResult expected = detectSerially(asteroids, bullets);
+        CHECK(!expected.asteroids.empty() && expected.asteroids.size() < asteroids.size());
+        CHECK(expected.bullets.size() < bullets.size());
+        for (const auto& result : results)
+        {
+            CHECK(result.hits == expected.hits);
+            CHECK(result.asteroids == expected.asteroids);
+            CHECK(result.bullets == expected.bullets);
+        }
+    }
+}
+
+int main()
+{
+    test::run("bullet hits far asteroid", testBulletHitsFarAsteroid);
+    test::run("chunked detection matches serial", testChunkedDetectionMatchesSerial);
+    test::run("controls drive player", testControlsDrivePlayer);
+    test::run("restart returns to level one", testRestartReturnsToLevelOne);
+    return test::getExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "Check.hpp"
+#include "TestInputs.hpp"
+
+#include "Snapshot.hpp"
+#include "Simulation.hpp"
+#include "Serialization.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    bool equal(const Snapshot::Entity& entity1, const Snapshot::Entity& entity2)
+    {
+        return entity1.id == entity2.id && entity1.type == entity2.type && entity1.x == entity2.x && entity1.y == entity2.y
+            && entity1.rotation == entity2.rotation && entity1.velocityX == entity2.velocityX && entity1.velocityY == entity2.velocityY;
+    }
+
+    bool equal(const Snapshot& snapshot1, const Snapshot& snapshot2)
+    {
+        if (snapshot1.tick != snapshot2.tick || snapshot1.level != snapshot2.level || snapshot1.state != snapshot2.state
+            || snapshot1.entities.size() != snapshot2.entities.size())
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < snapshot1.entities.size(); i++)
+        {
+            if (!equal(snapshot1.entities[i], snapshot2.entities[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Snapshot roundTrip(const Snapshot& snapshot, const Snapshot* encodeBaseline, const Snapshot* decodeBaseline)
+    {
+        BitWriter writer;
+        snapshot.encode(encodeBaseline, writer);
+        const std::vector<unsigned char>& bytes = writer.getBytes();
+        BitReader reader(bytes.data(), bytes.size());
+        return Snapshot::decode(decodeBaseline, reader);
+    }
+
+    // Capture snapshots of a running game every few updates, so that objects appear, move and disappear between them.
+    std::vector<Snapshot> captureGame(std::size_t snapshotCount, std::size_t interval)
+    {
+        Simulation simulation(3);
+        while (simulation.getState() != Simulation::State::Running)
+        {
+            simulation.step(InputState());
+        }
+        std::vector<InputState> inputs = test::makeInputs(snapshotCount * interval, 3);
+        std::vector<Snapshot> snapshots;
+        for (std::size_t i = 0; i < inputs.size(); i++)
+        {
+            simulation.step(inputs[i]);
+            if ((i + 1) % interval == 0)
+            {
+                snapshots.push_back(Snapshot::capture(simulation));
+            }
+        }
+        return snapshots;
+    }
+
+    void testFullRoundTrip()
+    {
+        for (const auto& snapshot : captureGame(20, 50))
+        {
+            CHECK(equal(roundTrip(snapshot, nullptr, nullptr), snapshot));
+        }
+    }
+
+    void testDeltaRoundTrip()
+    {
+        std::vector<Snapshot> snapshots = captureGame(40, 25);
+        for (std::size_t i = 1; i < snapshots.size(); i++)
+        {
+            CHECK(equal(roundTrip(snapshots[i], &snapshots[i - 1], &snapshots[i - 1]), snapshots[i]));
+        }
+        // An older baseline also works, the client may not have acknowledged the last snapshots
+        CHECK(equal(roundTrip(snapshots.back(), &snapshots.front(), &snapshots.front()), snapshots.back()));
+    }
+
+    void testDeltaIsSmaller()
+    {
+        std::vector<Snapshot> snapshots = captureGame(2, 1);
+        BitWriter full;
+        snapshots[1].encode(nullptr, full);
+        BitWriter delta;
+        snapshots[1].encode(&snapshots[0], delta);
+        CHECK(delta.getBitCount() < full.getBitCount());
+    }
+
+    void testWrongBaselineIsDetected()
+    {
+        std::vector<Snapshot> snapshots = captureGame(3, 30);
+        bool thrown = false;
+        try
+        {
+            roundTrip(snapshots[2], &snapshots[1], &snapshots[0]);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        CHECK(thrown);
+    }
+}
+
+int main()
+{
+    test::run("full snapshot round trip", testFullRoundTrip);
+    test::run("delta snapshot round trip", testDeltaRoundTrip);
+    test::run("delta is smaller than full snapshot", testDeltaIsSmaller);
+    test::run("wrong baseline is detected", testWrongBaselineIsDetected);
+    return test::getExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "Check.hpp"
+
+#include "SpatialGrid.hpp"
+#include "Random.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/common.hpp>
+
+#include <vector>
+
+namespace
+{
+    const glm::vec2 AREA = glm::vec2(800.0f, 600.0f);
+
+    // Number of times the query reported each entry.
+    std::vector<int> query(const SpatialGrid& grid, glm::vec2 center, float halfSize, std::size_t entryCount)
+    {
+        std::vector<int> counts(entryCount, 0);
+        grid.query(center, halfSize, [&counts](SpatialGrid::Entry entry) { ++counts[entry]; });
+        return counts;
+    }
+
+    // Every entry inside the queried square is reported once, also when the square crosses edges of the area.
+    void testQueryAcrossEdges()
+    {
+        rnd::Generator random(21);
+        std::vector<glm::vec2> positions;
+        SpatialGrid grid;
+        grid.reset(AREA, 64.0f);
+        for (SpatialGrid::Entry i = 0; i < 2000; i++)
+        {
+            positions.push_back(glm::vec2(random.getFloat(0.0f, AREA.x), random.getFloat(0.0f, AREA.y)));
+            grid.add(positions.back(), i);
+        }
+        grid.build();
+        CHECK(grid.getEntryCount() == positions.size());
+        const glm::vec2 centers[] = {
+            glm::vec2(0.0f), glm::vec2(5.0f, 595.0f), glm::vec2(795.0f, 3.0f), AREA,
+            glm::vec2(-30.0f, 300.0f), glm::vec2(400.0f, 640.0f), glm::vec2(1234.0f, -777.0f), glm::vec2(400.0f, 300.0f)
+        };
+        for (glm::vec2 center : centers)
+        {
+            for (float halfSize : { 10.0f, 100.0f, 350.0f })
+            {
+                std::vector<int> counts = query(grid, center, halfSize, positions.size());
+                for (std::size_t i = 0; i < positions.size(); i++)
+                {
+                    glm::vec2 offset = glm::abs(grid.getOffset(center, positions[i]));
+                    bool inside = offset.x <= halfSize && offset.y <= halfSize;
+                    CHECK(counts[i] <= 1);
+                    CHECK(!inside || counts[i] == 1);
+                }
+            }
+        }
+    }
+
+    // A square larger than the area visits every cell once.
+    void testLargeQueryReportsAllOnce()
+    {
+        SpatialGrid grid;
+        grid.reset(AREA, 100.0f);
+        for (SpatialGrid::Entry i = 0; i < 48; i++)
+        {
+            grid.add(glm::vec2(50.0f + 100.0f * (i % 8), 50.0f + 100.0f * (i / 8)), i);
+        }
+        grid.build();
+        std::vector<int> counts = query(grid, glm::vec2(790.0f, 10.0f), 1000.0f, 48);
+        CHECK(counts == std::vector<int>(48, 1));
+    }
+
+    void testPositionsOutsideAreaAreWrapped()
+    {
+        SpatialGrid grid;
+        grid.reset(AREA, 50.0f);
+        grid.add(glm::vec2(-10.0f, -10.0f), 0);
+        grid.add(glm::vec2(810.0f, 610.0f), 1);
+        grid.build();
+        CHECK(query(grid, glm::vec2(790.0f, 590.0f), 5.0f, 2)[0] == 1);
+        CHECK(query(grid, glm::vec2(10.0f, 10.0f), 5.0f, 2)[1] == 1);
+    }
+
+    void testOffsetTakesShorterWay()
+    {
+        SpatialGrid grid;
+        grid.reset(AREA, 50.0f);
+        CHECK(grid.getOffset(glm::vec2(10.0f, 10.0f), glm::vec2(790.0f, 590.0f)) == glm::vec2(-20.0f, -20.0f));
+        CHECK(grid.getOffset(glm::vec2(790.0f, 590.0f), glm::vec2(10.0f, 10.0f)) == glm::vec2(20.0f, 20.0f));
+        CHECK(grid.getOffset(glm::vec2(100.0f, 100.0f), glm::vec2(300.0f, 150.0f)) == glm::vec2(200.0f, 50.0f));
+    }
+}
+
+int main()
+{
+    test::run("query across edges", testQueryAcrossEdges);
+    test::run("large query reports all once", testLargeQueryReportsAllOnce);
+    test::run("positions outside area are wrapped", testPositionsOutsideAreaAreWrapped);
+    test::run("offset takes shorter way", testOffsetTakesShorterWay);
+    return test::getExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef TEST_INPUTS_HPP
+#define TEST_INPUTS_HPP
+
+#include "InputState.hpp"
+#include "Random.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace test
+{
+    // Generate inputs of a player holding random buttons for a while, the game is never quit.
+    inline std::vector<InputState> makeInputs(std::size_t count, unsigned int seed)
+    {
+        rnd::Generator random(seed);
+        std::vector<InputState> inputs;
+        while (inputs.size() < count)
+        {
+            unsigned char buttons = static_cast<unsigned char>(random.next() & ~InputState::BUTTON_QUIT & 0x1F);
+            std::size_t length = 1 + random.next() % 30;
+            for (std::size_t i = 0; i < length && inputs.size() < count; i++)
+            {
+                inputs.push_back(InputState(buttons));
+            }
+        }
+        return inputs;
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef TEST_OBJECTS_HPP
+#define TEST_OBJECTS_HPP
+
+#include "Simulation.hpp"
+#include "Serialization.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace test
+{
+    template<typename T>
+    void saveObjects(BinaryWriter& writer, const std::vector<T>& objects)
+    {
+        writer.write(static_cast<std::uint64_t>(objects.size()));
+        for (const auto& object : objects)
+        {
+            object.save(writer);
+        }
+    }
+
+    // Replace all objects in the state of the simulation, objects are stored at the end of the state.
+    inline void replaceObjects(Simulation& simulation, const std::vector<Asteroid>& asteroids, const std::vector<Bullet>& bullets)
+    {
+        std::vector<unsigned char> state = simulation.saveState();
+        BinaryWriter current;
+        saveObjects(current, simulation.getAsteroids());
+        saveObjects(current, simulation.getBullets());
+        saveObjects(current, simulation.getRemnants());
+        BinaryWriter replaced;
+        saveObjects(replaced, asteroids);
+        saveObjects(replaced, bullets);
+        saveObjects(replaced, simulation.getRemnants());
+        std::vector<unsigned char> objects = replaced.release();
+        state.resize(state.size() - current.release().size());
+        state.insert(state.end(), objects.begin(), objects.end());
+        simulation.loadState(state.data(), state.size());
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "Check.hpp"
+
+#include "TimingWheel.hpp"
+#include "Random.hpp"
+#include "Serialization.hpp"
+
+#include <map>
+#include <vector>
+
+namespace
+{
+    // Advance the wheel to the tick and record the tick at which every timer expired.
+    void advanceTo(TimingWheel& wheel, Tick tick, std::map<TimingWheel::Id, Tick>& expirations)
+    {
+        std::vector<TimingWheel::Id> expired;
+        while (wheel.getCurrentTick() < tick)
+        {
+            expired.clear();
+            wheel.advance(expired);
+            for (TimingWheel::Id id : expired)
+            {
+                CHECK(expirations.count(id) == 0);
+                expirations[id] = wheel.getCurrentTick();
+            }
+        }
+    }
+
+    // Timers on all levels expire exactly at their ticks, also when they are scheduled while the wheel runs.
+    void testTimersExpireAtTheirTicks()
+    {
+        TimingWheel wheel;
+        wheel.clear(0);
+        rnd::Generator random(11);
+        std::map<TimingWheel::Id, Tick> wanted;
+        std::map<TimingWheel::Id, Tick> expirations;
+        TimingWheel::Id nextId = 0;
+        const Tick horizons[] = { 1, 64, 64 * 64, 64 * 64 * 64 };
+        for (Tick start = 0; start < 5000; start += 37)
+        {
+            advanceTo(wheel, start, expirations);
+            for (Tick horizon : horizons)
+            {
+                Tick expiration = start + 1 + random.next() % (2 * horizon);
+                wheel.schedule(nextId, expiration);
+                wanted[nextId++] = expiration;
+            }
+        }
+        CHECK(wheel.size() == wanted.size() - expirations.size());
+        advanceTo(wheel, 5000 + 2 * 64 * 64 * 64 + 1, expirations);
+        CHECK(wheel.size() == 0);
+        CHECK(expirations == wanted);
+    }
+
+    void testPastTimersExpireAtNextTick()
+    {
+        TimingWheel wheel;
+        wheel.clear(100);
+        wheel.schedule(1, 50);
+        wheel.schedule(2, 100);
+        std::vector<TimingWheel::Id> expired;
+        wheel.advance(expired);
+        CHECK(wheel.getCurrentTick() == 101);
+        CHECK(expired.size() == 2);
+    }
+
+    // Timers beyond the range of all levels wait in the overflow list.
+    void testOverflowTimers()
+    {
+        TimingWheel wheel;
+        wheel.clear(0);
+        const Tick range = Tick(1) << 24;
+        wheel.schedule(1, range + 100);
+        wheel.schedule(2, 3 * range + 5);
+        std::map<TimingWheel::Id, Tick> expirations;
+        advanceTo(wheel, 3 * range + 10, expirations);
+        CHECK(expirations[1] == range + 100);
+        CHECK(expirations[2] == 3 * range + 5);
+    }
+
+    // A wheel loaded from a saved one expires the same timers at the same ticks.
+    void testSaveAndLoad()
+    {
+        TimingWheel wheel;
+        wheel.clear(0);
+        rnd::Generator random(12);
+        for (TimingWheel::Id id = 0; id < 2000; id++)
+        {
+            wheel.schedule(id, 1 + random.next() % 100000);
+        }
+        std::map<TimingWheel::Id, Tick> expirations;
+        advanceTo(wheel, 777, expirations);
+        BinaryWriter writer;
+        wheel.save(writer);
+        std::vector<unsigned char> bytes = writer.release();
+        BinaryReader reader(bytes.data(), bytes.size());
+        TimingWheel loaded;
+        loaded.load(reader);
+        CHECK(reader.finished());
+        CHECK(loaded.getCurrentTick() == wheel.getCurrentTick());
+        CHECK(loaded.size() == wheel.size());
+        std::map<TimingWheel::Id, Tick> loadedExpirations = expirations;
+        advanceTo(wheel, 100001, expirations);
+        advanceTo(loaded, 100001, loadedExpirations);
+        CHECK(loadedExpirations == expirations);
+        CHECK(expirations.size() == 2000);
+    }
+}
+
+int main()
+{
+    test::run("timers expire at their ticks", testTimersExpireAtTheirTicks);
+    test::run("past timers expire at next tick", testPastTimersExpireAtNextTick);
+    test::run("overflow timers", testOverflowTimers);
+    test::run("save and load", testSaveAndLoad);
+    return test::getExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include "Check.hpp"
+
+#include "VideoWriter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const unsigned int WIDTH = 4;
+    const unsigned int HEIGHT = 4;
+
+    struct Color
+    {
+        int r;
+        int g;
+        int b;
+    };
+
+    // Colors of 2x2 blocks of the test frame as seen in the video, from the top left corner
+    const Color BLOCKS[] = { { 255, 0, 0 }, { 0, 255, 0 }, { 0, 0, 255 }, { 128, 128, 128 } };
+
+    Color getExpected(unsigned int x, unsigned int row)
+    {
+        return BLOCKS[(row / 2) * 2 + x / 2];
+    }
+
+    // RGBA frame in rows from the bottom as read by OpenGL, the brightness is added to all channels.
+    std::vector<unsigned char> makeFrame(int brightness)
+    {
+        std::vector<unsigned char> pixels;
+        for (unsigned int row = HEIGHT; row-- > 0;)
+        {
+            for (unsigned int x = 0; x < WIDTH; x++)
+            {
+                Color color = getExpected(x, row);
+                pixels.push_back(static_cast<unsigned char>(std::min(255, color.r + brightness)));
+                pixels.push_back(static_cast<unsigned char>(std::min(255, color.g + brightness)));
+                pixels.push_back(static_cast<unsigned char>(std::min(255, color.b + brightness)));
+                pixels.push_back(255);
+            }
+        }
+        return pixels;
+    }
+
+    std::string readFile(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // Convert BT.601 limited range back to RGB.
+    Color decode(int y, int u, int v)
+    {
+        double luma = 1.164 * (y - 16);
+        return Color{
+            static_cast<int>(std::lround(luma + 1.596 * (v - 128))),
+            static_cast<int>(std::lround(luma - 0.813 * (v - 128) - 0.391 * (u - 128))),
+            static_cast<int>(std::lround(luma + 2.018 * (u - 128)))
+        };
+    }
+
+    bool isClose(Color decoded, Color expected)
+    {
+        const int TOLERANCE = 3;
+        auto close = [TOLERANCE](int value, int expectedValue)
+        {
+            return std::abs(std::max(0, std::min(255, value)) - expectedValue) <= TOLERANCE;
+        };
+        return close(decoded.r, expected.r) && close(decoded.g, expected.g) && close(decoded.b, expected.b);
+    }
+
+    void testY4mIsDecoded()
+    {
+        const std::string path = "VideoWriterTests.y4m";
+        {
+            VideoWriter writer(path, WIDTH, HEIGHT, 60);
+            CHECK(writer.getFormat() == VideoWriter::Format::Y4m);
+            CHECK(writer.write(makeFrame(0).data()));
+            CHECK(writer.write(makeFrame(0).data(), 3));
+            writer.finish();
+            CHECK(writer.getWrittenCount() == 4);
+            CHECK(writer.getDroppedCount() == 0);
+        }
+        std::string video = readFile(path);
+        std::remove(path.c_str());
+        const std::string header = "YUV4MPEG2 W4 H4 F60:1 Ip A1:1 C420jpeg\n";
+        CHECK(video.compare(0, header.size(), header) == 0);
+        const std::string frameHeader = "FRAME\n";
+        std::size_t lumaSize = WIDTH * HEIGHT;
+        std::size_t chromaSize = lumaSize / 4;
+        std::size_t frameSize = frameHeader.size() + lumaSize + 2 * chromaSize;
+        CHECK(video.size() == header.size() + 4 * frameSize);
+        if (video.size() != header.size() + 4 * frameSize)
+        {
+            return;
+        }
+        for (std::size_t frame = 0; frame < 4; frame++)
+        {
+            std::size_t offset = header.size() + frame * frameSize;
+            CHECK(video.compare(offset, frameHeader.size(), frameHeader) == 0);
+            const unsigned char* luma = reinterpret_cast<const unsigned char*>(video.data()) + offset + frameHeader.size();
+            const unsigned char* blue = luma + lumaSize;
+            const unsigned char* red = blue + chromaSize;
+            for (unsigned int row = 0; row < HEIGHT; row++)
+            {
+                for (unsigned int x = 0; x < WIDTH; x++)
+                {
+                    std::size_t chroma = (row / 2) * (WIDTH / 2) + x / 2;
+                    Color decoded = decode(luma[row * WIDTH + x], blue[chroma], red[chroma]);
+                    CHECK(isClose(decoded, getExpected(x, row)));
+                }
+            }
+        }
+    }
+
+    void testRawRgbIsDecoded()
+    {
+        const std::string path = "VideoWriterTests.rgb";
+        {
+            VideoWriter writer(path, WIDTH, HEIGHT, 60);
+            CHECK(writer.getFormat() == VideoWriter::Format::RawRgb);
+            CHECK(writer.write(makeFrame(0).data(), 2));
+            CHECK(writer.write(makeFrame(20).data()));
+            writer.finish();
+            CHECK(writer.getWrittenCount() == 3);
+        }
+        std::string video = readFile(path);
+        std::remove(path.c_str());
+        std::size_t frameSize = WIDTH * HEIGHT * 3;
+        CHECK(video.size() == 3 * frameSize);
+        if (video.size() != 3 * frameSize)
+        {
+            return;
+        }
+        const int brightness[] = { 0, 0, 20 };
+        for (std::size_t frame = 0; frame < 3; frame++)
+        {
+            const unsigned char* pixel = reinterpret_cast<const unsigned char*>(video.data()) + frame * frameSize;
+            for (unsigned int row = 0; row < HEIGHT; row++)
+            {
+                for (unsigned int x = 0; x < WIDTH; x++, pixel += 3)
+                {
+                    Color expected = getExpected(x, row);
+                    CHECK(pixel[0] == std::min(255, expected.r + brightness[frame]));
+                    CHECK(pixel[1] == std::min(255, expected.g + brightness[frame]));
+                    CHECK(pixel[2] == std::min(255, expected.b + brightness[frame]));
+                }
+            }
+        }
+    }
+
+    void testFramesAfterFinishAreDropped()
+    {
+        const std::string path = "VideoWriterTests-finished.rgb";
+        VideoWriter writer(path, WIDTH, HEIGHT, 60);
+        writer.finish();
+        CHECK(!writer.write(makeFrame(0).data(), 2));
+        CHECK(writer.getWrittenCount() == 0);
+        CHECK(writer.getDroppedCount() == 2);
+        std::remove(path.c_str());
+    }
+
+    void testInvalidVideosAreRejected()
+    {
+        bool thrown = false;
+        try
+        {
+            VideoWriter writer("VideoWriterTests-odd.y4m", 3, 4, 60);
+        }
+        catch (const std::logic_error&)
+        {
+            thrown = true;
+        }
+        CHECK(thrown);
+        std::remove("VideoWriterTests-odd.y4m");
+        thrown = false;
+        try
+        {
+            VideoWriter writer("missing-directory/video.y4m", WIDTH, HEIGHT, 60);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        CHECK(thrown);
+    }
+}
+
+int main()
+{
+    test::run("Y4M is decoded", testY4mIsDecoded);
+    test::run("raw RGB is decoded", testRawRgbIsDecoded);
+    test::run("frames after finish are dropped", testFramesAfterFinishAreDropped);
+    test::run("invalid videos are rejected", testInvalidVideosAreRejected);
+    return test::getExitCode();
+}
\ No newline at end of file